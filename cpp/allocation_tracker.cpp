@@ -0,0 +1,257 @@
+﻿#include "allocation_tracker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace AlgorithmSamples::Benchmark {
+
+namespace {
+
+// 区間 1 つ分の集計。確保するスレッドが直接書き込む
+struct Slot {
+    std::atomic<bool> reserved{false};
+    std::atomic<bool> active{false};
+    // この値より後の通し番号の確保だけが、この区間で確保したもの
+    std::atomic<uint64_t> start_serial{0};
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> deallocations{0};
+    std::atomic<size_t> allocated_bytes{0};
+    std::atomic<size_t> largest_allocation{0};
+    std::atomic<int64_t> live_bytes{0};
+    std::atomic<int64_t> peak_bytes{0};
+    std::array<std::atomic<size_t>, ALLOCATION_SIZE_CLASSES> size_histogram{};
+
+    void reset() {
+        allocations.store(0, std::memory_order_relaxed);
+        deallocations.store(0, std::memory_order_relaxed);
+        allocated_bytes.store(0, std::memory_order_relaxed);
+        largest_allocation.store(0, std::memory_order_relaxed);
+        live_bytes.store(0, std::memory_order_relaxed);
+        peak_bytes.store(0, std::memory_order_relaxed);
+        for (auto& count : size_histogram) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+std::array<Slot, AllocationSection::MAX_SECTIONS> g_slots;
+// 生存している区間の数。0 の間は確保を数えない
+std::atomic<size_t> g_active_sections{0};
+// 区間があるときの確保に振る通し番号 (区間がないときの確保は 0)
+std::atomic<uint64_t> g_allocation_serial{0};
+
+template <typename T>
+void store_max(std::atomic<T>& target, T value) {
+    T current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+size_t size_class(size_t size) {
+    return size <= 1 ? 0 : std::min<size_t>(std::bit_width(size - 1), ALLOCATION_SIZE_CLASSES - 1);
+}
+
+// 確保を生存中の区間に数え、確保の通し番号を返す
+uint64_t record_allocation(size_t size) {
+    if (g_active_sections.load(std::memory_order_relaxed) == 0) {
+        return 0;
+    }
+    const auto serial = g_allocation_serial.fetch_add(1, std::memory_order_relaxed) + 1;
+    for (auto& slot : g_slots) {
+        if (!slot.active.load(std::memory_order_acquire) ||
+            serial <= slot.start_serial.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        slot.allocations.fetch_add(1, std::memory_order_relaxed);
+        slot.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        slot.size_histogram[size_class(size)].fetch_add(1, std::memory_order_relaxed);
+        store_max(slot.largest_allocation, size);
+        const auto bytes = static_cast<int64_t>(size);
+        store_max(slot.peak_bytes, slot.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    }
+    return serial;
+}
+
+void record_deallocation(size_t size, uint64_t serial) {
+    if (g_active_sections.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    for (auto& slot : g_slots) {
+        if (!slot.active.load(std::memory_order_acquire)) {
+            continue;
+        }
+        slot.deallocations.fetch_add(1, std::memory_order_relaxed);
+        if (serial > slot.start_serial.load(std::memory_order_relaxed)) {
+            slot.live_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        }
+    }
+}
+
+// 確保した領域の直前に、解放するときに使う大きさと通し番号を置く
+struct Header {
+    size_t size;
+    uint64_t serial;
+};
+
+constexpr size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+static_assert(sizeof(Header) <= DEFAULT_ALIGNMENT);
+
+size_t header_size(size_t alignment) { return std::max(DEFAULT_ALIGNMENT, alignment); }
+
+void* allocate(size_t size, size_t alignment) {
+    const auto header = header_size(alignment);
+    if (size > SIZE_MAX - 2 * header) {
+        return nullptr;
+    }
+    void* base = nullptr;
+    if (alignment <= DEFAULT_ALIGNMENT) {
+        base = std::malloc(size + header);
+    } else {
+#ifdef _WIN32
+        base = _aligned_malloc(size + header, alignment);
+#else
+        // aligned_alloc の大きさは alignment の倍数でなければならない
+        base = std::aligned_alloc(alignment, (size + header + alignment - 1) / alignment * alignment);
+#endif
+    }
+    if (base == nullptr) {
+        return nullptr;
+    }
+    auto* p = static_cast<std::byte*>(base) + header;
+    const Header info{size, record_allocation(size)};
+    std::memcpy(p - sizeof(Header), &info, sizeof(Header));
+    return p;
+}
+
+void* allocate_or_throw(size_t size, size_t alignment) {
+    for (;;) {
+        if (void* p = allocate(size, alignment)) {
+            return p;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void deallocate(void* p, size_t alignment) noexcept {
+    if (p == nullptr) {
+        return;
+    }
+    auto* bytes = static_cast<std::byte*>(p);
+    Header info;
+    std::memcpy(&info, bytes - sizeof(Header), sizeof(Header));
+    record_deallocation(info.size, info.serial);
+    void* base = bytes - header_size(alignment);
+#ifdef _WIN32
+    if (alignment > DEFAULT_ALIGNMENT) {
+        _aligned_free(base);
+        return;
+    }
+#endif
+    std::free(base);
+}
+
+}  // namespace
+
+AllocationSection::AllocationSection() {
+    for (slot_ = 0; slot_ < g_slots.size(); ++slot_) {
+        bool expected = false;
+        if (g_slots[slot_].reserved.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            break;
+        }
+    }
+    if (slot_ == g_slots.size()) {
+        throw std::runtime_error("Too many allocation sections");
+    }
+    auto& slot = g_slots[slot_];
+    slot.reset();
+    slot.start_serial.store(g_allocation_serial.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    slot.active.store(true, std::memory_order_release);
+    g_active_sections.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationSection::~AllocationSection() {
+    auto& slot = g_slots[slot_];
+    slot.active.store(false, std::memory_order_relaxed);
+    g_active_sections.fetch_sub(1, std::memory_order_relaxed);
+    slot.reserved.store(false, std::memory_order_release);
+}
+
+AllocationStats AllocationSection::stats() const {
+    const auto& slot = g_slots[slot_];
+    AllocationStats stats;
+    stats.allocations = slot.allocations.load(std::memory_order_relaxed);
+    stats.deallocations = slot.deallocations.load(std::memory_order_relaxed);
+    stats.allocated_bytes = slot.allocated_bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = static_cast<size_t>(std::max<int64_t>(slot.peak_bytes.load(std::memory_order_relaxed), 0));
+    stats.largest_allocation = slot.largest_allocation.load(std::memory_order_relaxed);
+    for (size_t k = 0; k < ALLOCATION_SIZE_CLASSES; ++k) {
+        stats.size_histogram[k] = slot.size_histogram[k].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+}  // namespace AlgorithmSamples::Benchmark
+
+// グローバルな operator new / delete の置き換え。
+// nothrow 版も、標準ライブラリやサニタイザーの実装が通常版を経由するとは限らないので置き換える
+namespace Tracker = AlgorithmSamples::Benchmark;
+
+void* operator new(std::size_t size) { return Tracker::allocate_or_throw(size, Tracker::DEFAULT_ALIGNMENT); }
+void* operator new[](std::size_t size) { return Tracker::allocate_or_throw(size, Tracker::DEFAULT_ALIGNMENT); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return Tracker::allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return Tracker::allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { Tracker::deallocate(p, Tracker::DEFAULT_ALIGNMENT); }
+void operator delete[](void* p) noexcept { Tracker::deallocate(p, Tracker::DEFAULT_ALIGNMENT); }
+void operator delete(void* p, std::size_t) noexcept { Tracker::deallocate(p, Tracker::DEFAULT_ALIGNMENT); }
+void operator delete[](void* p, std::size_t) noexcept { Tracker::deallocate(p, Tracker::DEFAULT_ALIGNMENT); }
+void operator delete(void* p, std::align_val_t alignment) noexcept {
+    Tracker::deallocate(p, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* p, std::align_val_t alignment) noexcept {
+    Tracker::deallocate(p, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept {
+    Tracker::deallocate(p, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept {
+    Tracker::deallocate(p, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return Tracker::allocate(size, Tracker::DEFAULT_ALIGNMENT);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return Tracker::allocate(size, Tracker::DEFAULT_ALIGNMENT);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return Tracker::allocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return Tracker::allocate(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept { Tracker::deallocate(p, Tracker::DEFAULT_ALIGNMENT); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { Tracker::deallocate(p, Tracker::DEFAULT_ALIGNMENT); }
+void operator delete(void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    Tracker::deallocate(p, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    Tracker::deallocate(p, static_cast<std::size_t>(alignment));
+}
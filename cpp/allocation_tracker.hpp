@@ -0,0 +1,47 @@
+﻿#pragma once
+#include <array>
+#include <cstddef>
+
+namespace AlgorithmSamples::Benchmark {
+
+// 確保の大きさの分布の区分の数。区分 k には 2^(k-1) + 1 〜 2^k バイト (k = 0 は 0 〜 1 バイト) の確保を数える
+inline constexpr size_t ALLOCATION_SIZE_CLASSES = 64;
+
+// AllocationSection の生存中に行われた operator new / delete の集計
+struct AllocationStats {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t allocated_bytes = 0;     // 確保した大きさの合計
+    size_t peak_bytes = 0;          // 区間の開始時点から増えた使用量の最大値 (区間内で確保して解放していないものの合計)
+    size_t largest_allocation = 0;  // 1 回の確保の最大の大きさ
+    std::array<size_t, ALLOCATION_SIZE_CLASSES> size_histogram{};
+
+    // 区分 k に数える確保の大きさの上限 (2^k バイト)
+    static constexpr size_t size_class_limit(size_t k) { return size_t{1} << k; }
+};
+
+// 生存している間、プロセス全体 (別のスレッドを含む) の operator new / delete を数える。
+// allocation_tracker.cpp をリンクすると、グローバルな operator new / delete を置き換える。
+// 区間が 1 つもなければ、確保ごとの負担はアトミック変数 1 つの読み込みだけ。
+// 入れ子にしたり、複数のスレッドで同時に作ったりしてもよい (同時に MAX_SECTIONS 個まで、超えると std::runtime_error)。
+// 区間の開始より前に確保した領域の解放は、解放した回数には数えるが使用量からは差し引かない
+class AllocationSection {
+public:
+    static constexpr size_t MAX_SECTIONS = 16;
+
+    AllocationSection();
+    ~AllocationSection();
+
+    AllocationSection(const AllocationSection&) = delete;
+    AllocationSection& operator=(const AllocationSection&) = delete;
+    AllocationSection(AllocationSection&&) = delete;
+    AllocationSection& operator=(AllocationSection&&) = delete;
+
+    // ここまでの集計。区間の途中でも読める
+    AllocationStats stats() const;
+
+private:
+    size_t slot_;
+};
+
+}  // namespace AlgorithmSamples::Benchmark
@@ -0,0 +1,244 @@
+﻿#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "regression.hpp"
+#include "concurrency/work_stealing_pool.hpp"
+#include "sort/auto_sort.hpp"
+#include "sort/bubble_sort.hpp"
+#include "sort/indirect_sort.hpp"
+#include "sort/intro_select.hpp"
+#include "sort/network_sort.hpp"
+#include "sort/odd_even_sort.hpp"
+#include "sort/parallel_sort.hpp"
+#include "sort/pdq_sort.hpp"
+#include "sort/radix_sort.hpp"
+#include "sort/schwartzian_sort.hpp"
+#include "sort/segmented_sort.hpp"
+#include "sort/selection_sort.hpp"
+#include "sort/shaker_sort.hpp"
+#include "sort/sorted_vector.hpp"
+#include "sort/string_sort.hpp"
+#include "sort/tim_sort.hpp"
+#include "sort/top_k.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Benchmark;
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+using AlgorithmSamples::Concurrency::WorkStealingPool;
+
+namespace {
+
+// O(n^2) のソートは小さめの入力だけを計測する
+const std::vector<size_t> QUADRATIC_SIZES = {100, 1'000};
+const std::vector<size_t> SIZES = {1'000, 10'000, 100'000};
+
+// network_sort_batch が 1 度に並べる要素数
+constexpr size_t NETWORK_SIZE = 16;
+// segmented_sort のセグメントの長さの上限
+constexpr uint32_t MAX_SEGMENT_SIZE = 64;
+
+Options bench_options(const std::vector<size_t>& sizes) {
+    return {.warmup = 2, .iterations = regression_gate().options().iterations, .sizes = sizes};
+}
+
+// 中央値がベースラインより閾値を超えて遅くなった組み合わせを失敗にする
+void check_regression(const std::vector<Result>& results) {
+    auto& gate = regression_gate();
+    for (const auto& result : results) {
+        const auto verdict = gate.check(result);
+        INFO(std::format("{} {} n={}: median {:.0f} ns, baseline {:.0f} ns ({:+.1f}%, threshold {:+.1f}%)",
+                         result.name, to_string(result.distribution), result.size, result.stats.median,
+                         verdict.baseline_ns.value_or(result.stats.median), (verdict.ratio - 1.0) * 100.0,
+                         gate.options().threshold * 100.0));
+        CHECK_FALSE(verdict.regressed);
+    }
+}
+
+// (first, last) を受け取る int のソートを Benchmark::run で計測する (ソートされたかも確かめる)
+template <typename F>
+void bench_sort(const std::string& name, const std::vector<size_t>& sizes, F fn) {
+    check_regression(run(name, make_target(fn), bench_options(sizes)));
+}
+
+// Benchmark::run と同じ手順で、int 以外の要素や、全体をソートしないアルゴリズムを計測する。
+// sort は入力のコピーを std::span<T> で受け取り、verify は最後の結果が正しいかを返す
+template <Workload::Key T, typename Sort, typename Verify>
+void bench_custom(const std::string& name, const std::vector<size_t>& sizes, Sort sort, Verify verify) {
+    const auto options = bench_options(sizes);
+    std::vector<Result> results;
+    for (auto size : options.sizes) {
+        for (auto distribution : options.distributions) {
+            const auto input = Workload::generate<T>(size, {.distribution = distribution, .seed = options.seed});
+            std::vector<T> work;
+            std::vector<double> samples;
+            for (size_t i = 0; i < options.warmup + options.iterations; ++i) {
+                work = input;
+                const auto start = std::chrono::steady_clock::now();
+                sort(std::span<T>(work));
+                const auto end = std::chrono::steady_clock::now();
+                if (i >= options.warmup) {
+                    samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+                }
+            }
+            INFO(std::format("{} {} n={}", name, to_string(distribution), size));
+            REQUIRE(verify(std::span<const T>(work)));
+            results.push_back({name, distribution, size, options.iterations, summarize(std::move(samples)),
+                               std::nullopt, std::nullopt});
+        }
+    }
+    check_regression(results);
+}
+
+WorkStealingPool& bench_pool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+// 長さ 1〜MAX_SEGMENT_SIZE のセグメントで size 要素を区切る (計測に含めないよう要素数ごとに作っておく)
+const std::vector<uint32_t>& segment_offsets(size_t size) {
+    static std::map<size_t, std::vector<uint32_t>> cache;
+    auto& offsets = cache[size];
+    if (offsets.empty()) {
+        const auto lengths = Workload::generate<uint32_t>(size, {.seed = size});
+        offsets.push_back(0);
+        for (size_t i = 0; offsets.back() < size; ++i) {
+            const auto length = lengths[i] % MAX_SEGMENT_SIZE + 1;
+            offsets.push_back(static_cast<uint32_t>(std::min<size_t>(offsets.back() + length, size)));
+        }
+    }
+    return offsets;
+}
+
+}  // namespace
+
+TEST_CASE("bubble_sort", "[timing]") {
+    bench_sort("bubble_sort", QUADRATIC_SIZES, [](auto first, auto last) { bubble_sort(first, last); });
+    bench_sort("adaptive_bubble_sort", QUADRATIC_SIZES,
+               [](auto first, auto last) { adaptive_bubble_sort(first, last); });
+}
+
+TEST_CASE("shaker_sort", "[timing]") {
+    bench_sort("shaker_sort", QUADRATIC_SIZES, [](auto first, auto last) { shaker_sort(first, last); });
+    bench_sort("adaptive_shaker_sort", QUADRATIC_SIZES,
+               [](auto first, auto last) { adaptive_shaker_sort(first, last); });
+}
+
+TEST_CASE("odd_even_sort", "[timing]") {
+    bench_sort("odd_even_sort", QUADRATIC_SIZES, [](auto first, auto last) { odd_even_sort(first, last); });
+}
+
+TEST_CASE("selection_sort", "[timing]") {
+    bench_sort("selection_sort", QUADRATIC_SIZES, [](auto first, auto last) { selection_sort(first, last); });
+    bench_sort("double_selection_sort", QUADRATIC_SIZES,
+               [](auto first, auto last) { double_selection_sort(first, last); });
+}
+
+TEST_CASE("pdq_sort", "[timing]") {
+    bench_sort("pdq_sort", SIZES, [](auto first, auto last) { pdq_sort(first, last); });
+}
+
+TEST_CASE("tim_sort", "[timing]") {
+    bench_sort("tim_sort", SIZES, [](auto first, auto last) { tim_sort(first, last); });
+}
+
+TEST_CASE("radix_sort", "[timing]") {
+    bench_sort("radix_sort", SIZES, [](auto first, auto last) {
+        // 作業領域の確保を計測に含めないよう、ウォームアップで確保したものを使い回す
+        thread_local std::vector<int> scratch;
+        scratch.resize(static_cast<size_t>(last - first));
+        radix_sort(first, last, scratch.begin());
+    });
+    bench_sort("msd_radix_sort", SIZES, [](auto first, auto last) { msd_radix_sort(first, last); });
+}
+
+TEST_CASE("parallel_sort", "[timing]") {
+    bench_sort("parallel_sort", SIZES, [](auto first, auto last) { parallel_sort(first, last, bench_pool()); });
+}
+
+TEST_CASE("schwartzian_sort", "[timing]") {
+    bench_sort("schwartzian_sort", SIZES, [](auto first, auto last) { schwartzian_sort(first, last); });
+}
+
+TEST_CASE("auto_sort", "[timing]") {
+    bench_sort("auto_sort", SIZES, [](auto first, auto last) { auto_sort(first, last); });
+}
+
+TEST_CASE("sorted_vector", "[timing]") {
+    bench_sort("sorted_vector", SIZES, [](auto first, auto last) {
+        SortedVector<int> sorted(first, last);
+        std::ranges::copy(sorted, first);
+    });
+}
+
+TEST_CASE("indirect_sort", "[timing]") {
+    bench_custom<Workload::Record>(
+        "indirect_sort", SIZES, [](std::span<Workload::Record> data) { indirect_sort(data.begin(), data.end()); },
+        [](auto data) { return std::ranges::is_sorted(data); });
+}
+
+TEST_CASE("string_sort", "[timing]") {
+    bench_custom<std::string>(
+        "string_sort", SIZES, [](std::span<std::string> data) { string_sort(data.begin(), data.end()); },
+        [](auto data) { return std::ranges::is_sorted(data); });
+}
+
+TEST_CASE("intro_select", "[timing]") {
+    bench_custom<int>(
+        "intro_select", SIZES,
+        [](std::span<int> data) { intro_select(data.begin(), data.begin() + data.size() / 2, data.end()); },
+        [](std::span<const int> data) {
+            const auto nth = data.begin() + data.size() / 2;
+            return std::all_of(data.begin(), nth, [&](int x) { return x <= *nth; }) &&
+                   std::all_of(nth, data.end(), [&](int x) { return *nth <= x; });
+        });
+}
+
+TEST_CASE("top_k_sort", "[timing]") {
+    bench_custom<int>(
+        "top_k_sort", SIZES,
+        [](std::span<int> data) { top_k_sort(data.begin(), data.begin() + data.size() / 10, data.end()); },
+        [](std::span<const int> data) {
+            const auto middle = data.begin() + data.size() / 10;
+            return std::is_sorted(data.begin(), middle) &&
+                   (middle == data.begin() ||
+                    std::all_of(middle, data.end(), [&](int x) { return *std::prev(middle) <= x; }));
+        });
+}
+
+TEST_CASE("network_sort_batch", "[timing]") {
+    // 要素数は NETWORK_SIZE の倍数にそろえる
+    const std::vector<size_t> sizes = {1'024, 16'384, 131'072};
+    bench_custom<int>(
+        "network_sort_batch", sizes, [](std::span<int> data) { network_sort_batch<NETWORK_SIZE>(data); },
+        [](std::span<const int> data) {
+            for (size_t i = 0; i < data.size(); i += NETWORK_SIZE) {
+                if (!std::ranges::is_sorted(data.subspan(i, NETWORK_SIZE))) {
+                    return false;
+                }
+            }
+            return true;
+        });
+}
+
+TEST_CASE("segmented_sort", "[timing]") {
+    bench_custom<int>(
+        "segmented_sort", SIZES,
+        [](std::span<int> data) { segmented_sort(data, std::span(segment_offsets(data.size()))); },
+        [](std::span<const int> data) {
+            const auto& offsets = segment_offsets(data.size());
+            for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+                if (!std::ranges::is_sorted(data.subspan(offsets[i], offsets[i + 1] - offsets[i]))) {
+                    return false;
+                }
+            }
+            return true;
+        });
+}
@@ -0,0 +1,211 @@
+﻿#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "concurrency/work_stealing_pool.hpp"
+#include "sort/auto_sort.hpp"
+#include "sort/bubble_sort.hpp"
+#include "sort/constexpr_sort.hpp"
+#include "sort/indirect_sort.hpp"
+#include "sort/intro_select.hpp"
+#include "sort/network_sort.hpp"
+#include "sort/odd_even_sort.hpp"
+#include "sort/parallel_sort.hpp"
+#include "sort/pdq_sort.hpp"
+#include "sort/radix_sort.hpp"
+#include "sort/schwartzian_sort.hpp"
+#include "sort/segmented_sort.hpp"
+#include "sort/selection_sort.hpp"
+#include "sort/shaker_sort.hpp"
+#include "sort/string_sort.hpp"
+#include "sort/tim_sort.hpp"
+#include "sort/top_k.hpp"
+#include "workload/workload.hpp"
+
+// シードを固定した入力に対して各ソートが返す比較回数 (基数ソートは要素を読み書きした回数) は、
+// 実装を変えない限り変わらない。
+// 時間の計測と違って実行環境に左右されないので、期待値を固定して、アルゴリズムの変更による増減をここで検出する。
+// 意図して比較回数が変わる変更をしたときは、理由を確かめてから期待値を更新する
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+using Workload::Distribution;
+using AlgorithmSamples::Concurrency::WorkStealingPool;
+
+namespace {
+
+struct Expected {
+    Distribution distribution;
+    size_t size;
+    size_t count;
+};
+
+// 入力を生成して sort に渡し、ソートされたことを確かめてから戻り値と期待値を比べる
+template <Workload::Key T = int, typename Sort>
+void check_counts(const char* name, std::initializer_list<Expected> table, Sort sort) {
+    for (const auto& [distribution, size, expected] : table) {
+        auto data = Workload::generate<T>(size, {.distribution = distribution});
+        const size_t actual = sort(std::span<T>(data));
+        INFO(std::format("{} {} n={}: {} (expected {})", name, Workload::to_string(distribution), size, actual,
+                         expected));
+        REQUIRE(std::ranges::is_sorted(data));
+        CHECK(actual == expected);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("比較回数 - bubble_sort", "[counts]") {
+    // 常に n(n - 1) / 2 回
+    check_counts("bubble_sort",
+                 {{Distribution::Random, 100, 4'950}, {Distribution::Sorted, 1'000, 499'500}},
+                 [](auto data) { return bubble_sort(data.begin(), data.end()); });
+    check_counts("adaptive_bubble_sort",
+                 {{Distribution::Random, 100, 4'760},
+                  {Distribution::Random, 1'000, 494'838},
+                  {Distribution::Sorted, 1'000, 999},
+                  {Distribution::NearlySorted, 1'000, 10'811}},
+                 [](auto data) { return adaptive_bubble_sort(data.begin(), data.end()).loopCount; });
+}
+
+TEST_CASE("比較回数 - shaker_sort", "[counts]") {
+    check_counts("shaker_sort",
+                 {{Distribution::Random, 100, 4'950}, {Distribution::Random, 1'000, 499'500}},
+                 [](auto data) { return shaker_sort(data.begin(), data.end()); });
+    check_counts("adaptive_shaker_sort",
+                 {{Distribution::Random, 100, 3'684},
+                  {Distribution::Random, 1'000, 326'033},
+                  {Distribution::Sorted, 1'000, 999},
+                  {Distribution::NearlySorted, 1'000, 9'020}},
+                 [](auto data) { return adaptive_shaker_sort(data.begin(), data.end()).loopCount; });
+}
+
+TEST_CASE("比較回数 - odd_even_sort", "[counts]") {
+    // フェーズごとに約 n / 2 組。整列済みなら最初の 2 フェーズ (n - 1 回) で終わる。
+    // スレッドに分けても同じフェーズを同じ回数行うので、並列版も同じ回数になる
+    const std::initializer_list<Expected> table = {{Distribution::Random, 100, 4'604},
+                                                   {Distribution::Random, 1'000, 476'024},
+                                                   {Distribution::Sorted, 1'000, 999},
+                                                   {Distribution::NearlySorted, 1'000, 6'494}};
+    check_counts("odd_even_sort", table, [](auto data) { return odd_even_sort(data.begin(), data.end()); });
+    check_counts("parallel_odd_even_sort", table, [](auto data) {
+        return parallel_odd_even_sort(data.begin(), data.end(), {.thread_count = 4, .min_elements_per_thread = 16});
+    });
+}
+
+TEST_CASE("比較回数 - selection_sort", "[counts]") {
+    check_counts("selection_sort",
+                 {{Distribution::Random, 100, 4'950}, {Distribution::Random, 1'000, 499'500}},
+                 [](auto data) { return selection_sort(data.begin(), data.end()); });
+    // 両端を 1 つずつ確定させるので、未確定の要素数 m ごとに 2(m - 1) 回
+    check_counts("double_selection_sort",
+                 {{Distribution::Random, 100, 5'000}, {Distribution::Random, 1'000, 500'000}},
+                 [](auto data) { return double_selection_sort(data.begin(), data.end()); });
+}
+
+TEST_CASE("比較回数 - pdq_sort", "[counts]") {
+    check_counts("pdq_sort",
+                 {{Distribution::Random, 1'000, 10'678},
+                  {Distribution::Random, 100'000, 1'783'852},
+                  {Distribution::Sorted, 100'000, 199'996},
+                  {Distribution::Reversed, 100'000, 299'988},
+                  {Distribution::FewUnique, 100'000, 518'837},
+                  {Distribution::OrganPipe, 100'000, 2'467'682}},
+                 [](auto data) { return pdq_sort(data.begin(), data.end()); });
+}
+
+TEST_CASE("比較回数 - tim_sort", "[counts]") {
+    check_counts("tim_sort",
+                 {{Distribution::Random, 1'000, 8'638},
+                  {Distribution::Random, 100'000, 1'529'173},
+                  {Distribution::Sorted, 100'000, 99'999},
+                  {Distribution::Reversed, 100'000, 99'999},
+                  {Distribution::Sawtooth, 100'000, 576'102}},
+                 [](auto data) { return tim_sort(data.begin(), data.end()); });
+}
+
+TEST_CASE("比較回数 - radix_sort", "[counts]") {
+    check_counts("radix_sort",
+                 {{Distribution::Random, 100'000, 500'000}, {Distribution::FewUnique, 100'000, 300'000}},
+                 [](auto data) {
+                     std::vector<int> scratch(data.size());
+                     return radix_sort(data.begin(), data.end(), scratch.begin());
+                 });
+    check_counts("msd_radix_sort",
+                 {{Distribution::Random, 1'000, 3'885}, {Distribution::Random, 100'000, 516'519}},
+                 [](auto data) { return msd_radix_sort(data.begin(), data.end()); });
+}
+
+TEST_CASE("比較回数 - parallel_sort", "[counts]") {
+    // 葉の大きさはスレッド数で決まるので、スレッド数を固定する
+    WorkStealingPool pool(4);
+    check_counts("parallel_sort",
+                 {{Distribution::Random, 1'000, 10'678}, {Distribution::Random, 100'000, 1'771'070}},
+                 [&](auto data) { return parallel_sort(data.begin(), data.end(), pool); });
+}
+
+TEST_CASE("比較回数 - schwartzian_sort / indirect_sort / string_sort", "[counts]") {
+    check_counts("schwartzian_sort",
+                 {{Distribution::Random, 100'000, 1'983'851}},
+                 [](auto data) { return schwartzian_sort(data.begin(), data.end()); });
+    check_counts<Workload::Record>("indirect_sort",
+                                   {{Distribution::Random, 100'000, 1'210'633}},
+                                   [](auto data) { return indirect_sort(data.begin(), data.end()); });
+    // Zipf は生成に浮動小数点の exp / log を使い、環境で列が変わりうるので回数の固定には使わない
+    check_counts<std::string>("string_sort",
+                              {{Distribution::Random, 100'000, 2'015'838}, {Distribution::FewUnique, 100'000, 756'170}},
+                              [](auto data) { return string_sort(data.begin(), data.end()); });
+}
+
+TEST_CASE("比較回数 - auto_sort", "[counts]") {
+    // 整列済みの列には tim_sort、乱数列とほぼ整列済みの列には radix_sort、重複の多い列には pdq_sort を選ぶ
+    check_counts("auto_sort",
+                 {{Distribution::Random, 100'000, 500'000},
+                  {Distribution::Sorted, 100'000, 99'999},
+                  {Distribution::FewUnique, 100'000, 518'837},
+                  {Distribution::NearlySorted, 100'000, 500'000}},
+                 [](auto data) { return auto_sort(data.begin(), data.end()); });
+}
+
+TEST_CASE("比較回数 - constexpr_sort", "[counts]") {
+    // 実行時にも同じ回数になる
+    check_counts("constexpr_sort",
+                 {{Distribution::Random, 1'000, 9'135}},
+                 [](auto data) {
+                     std::array<int, 1'000> arr{};
+                     std::ranges::copy(data, arr.begin());
+                     const auto [sorted, count] = constexpr_sort(arr);
+                     std::ranges::copy(sorted, data.begin());
+                     return count;
+                 });
+}
+
+TEST_CASE("比較回数 - network_sort / segmented_sort", "[counts]") {
+    // ネットワークの大きさ。16 要素は Batcher の merge-exchange で 63 回
+    check_counts("network_sort",
+                 {{Distribution::Random, 16, 63}},
+                 [](auto data) { return network_sort<16>(data.begin()); });
+
+    auto data = Workload::generate<int>(10'000);
+    std::vector<uint32_t> offsets;
+    for (uint32_t offset = 0; offset <= data.size(); offset += 100) {
+        offsets.push_back(offset);
+    }
+    CHECK(segmented_sort(std::span(data), std::span(offsets)) == 72'773);
+}
+
+TEST_CASE("比較回数 - intro_select / top_k_sort", "[counts]") {
+    auto data = Workload::generate<int>(100'000);
+    const auto middle = data.begin() + static_cast<std::ptrdiff_t>(data.size() / 2);
+    CHECK(intro_select(data.begin(), middle, data.end()) == 243'298);
+
+    data = Workload::generate<int>(100'000);
+    CHECK(top_k_sort(data.begin(), data.begin() + 1'000, data.end()) == 143'437);
+}
@@ -0,0 +1,43 @@
+﻿#include <exception>
+#include <iostream>
+#include <string>
+#include <catch2/catch_session.hpp>
+#include "regression.hpp"
+
+using namespace AlgorithmSamples::Benchmark;
+
+int main(int argc, char* argv[]) {
+    Catch::Session session;
+    BenchOptions options;
+    std::string baseline = options.baseline.string();
+
+    using namespace Catch::Clara;
+    auto cli = session.cli() |
+               Opt(baseline, "path")["--baseline"]("baseline results to compare with (created if missing)") |
+               Opt(options.threshold, "ratio")["--threshold"]("allowed slowdown of the median, e.g. 0.25 for +25%") |
+               Opt(options.update_baseline)["--update-baseline"]("overwrite the baseline with this run") |
+               Opt(options.iterations, "count")["--iterations"]("measured runs per algorithm, distribution and size");
+    session.cli(cli);
+
+    if (const int code = session.applyCommandLine(argc, argv); code != 0) {
+        return code;
+    }
+
+    auto& gate = regression_gate();
+    try {
+        options.baseline = baseline;
+        gate.configure(options);
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid options: " << e.what() << "\n";
+        return 2;
+    }
+
+    const int failures = session.run();
+    try {
+        gate.finish();
+    } catch (const std::exception& e) {
+        std::cerr << "Saving the baseline failed: " << e.what() << "\n";
+        return 3;
+    }
+    return failures;
+}
@@ -0,0 +1,142 @@
+﻿#include "regression.hpp"
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace AlgorithmSamples::Benchmark {
+
+namespace {
+
+// write_csv の列のうち、ベースラインとして読み戻すもの
+enum Column { Algorithm, DistributionName, Size, Iterations, Min, Median, P95, Mean, Stddev, ColumnCount };
+
+std::vector<std::string_view> split(std::string_view line) {
+    std::vector<std::string_view> fields;
+    for (size_t start = 0;;) {
+        const auto comma = line.find(',', start);
+        fields.push_back(line.substr(start, comma - start));
+        if (comma == std::string_view::npos) {
+            return fields;
+        }
+        start = comma + 1;
+    }
+}
+
+template <typename T>
+T parse_number(std::string_view text, const std::filesystem::path& path, size_t line_number) {
+    T value{};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size()) {
+        throw std::runtime_error(std::format("{}:{}: invalid number '{}'", path.string(), line_number, text));
+    }
+    return value;
+}
+
+}  // namespace
+
+Baseline Baseline::load(const std::filesystem::path& path) {
+    Baseline baseline;
+    std::ifstream stream(path);
+    if (!stream) {
+        return baseline;
+    }
+
+    std::string line;
+    std::getline(stream, line);  // 見出し行
+    for (size_t line_number = 2; std::getline(stream, line); ++line_number) {
+        if (line.empty()) {
+            continue;
+        }
+        const auto fields = split(line);
+        if (fields.size() < ColumnCount) {
+            throw std::runtime_error(std::format("{}:{}: expected at least {} columns", path.string(), line_number,
+                                                 static_cast<int>(ColumnCount)));
+        }
+        const auto distribution = parse_distribution(fields[DistributionName]);
+        if (!distribution) {
+            throw std::runtime_error(
+                std::format("{}:{}: unknown distribution '{}'", path.string(), line_number, fields[DistributionName]));
+        }
+        Result result;
+        result.name = fields[Algorithm];
+        result.distribution = *distribution;
+        result.size = parse_number<size_t>(fields[Size], path, line_number);
+        result.iterations = parse_number<size_t>(fields[Iterations], path, line_number);
+        result.stats = {parse_number<double>(fields[Min], path, line_number),
+                        parse_number<double>(fields[Median], path, line_number),
+                        parse_number<double>(fields[P95], path, line_number),
+                        parse_number<double>(fields[Mean], path, line_number),
+                        parse_number<double>(fields[Stddev], path, line_number)};
+        baseline.record(result);
+    }
+    return baseline;
+}
+
+const Result* Baseline::find(const std::string& name, Distribution distribution, size_t size) const {
+    for (const auto& result : results_) {
+        if (result.name == name && result.distribution == distribution && result.size == size) {
+            return &result;
+        }
+    }
+    return nullptr;
+}
+
+void Baseline::record(const Result& result) {
+    // 操作回数やハードウェアカウンタは実行環境で変わるので、時間だけを残す
+    Result entry{result.name, result.distribution, result.size, result.iterations, result.stats, std::nullopt,
+                 std::nullopt};
+    for (auto& existing : results_) {
+        if (existing.name == entry.name && existing.distribution == entry.distribution &&
+            existing.size == entry.size) {
+            existing = std::move(entry);
+            return;
+        }
+    }
+    results_.push_back(std::move(entry));
+}
+
+void Baseline::save(const std::filesystem::path& path) const {
+    std::ofstream stream(path);
+    if (!stream) {
+        throw std::runtime_error(std::format("cannot write baseline {}", path.string()));
+    }
+    write_csv(stream, results_);
+}
+
+void RegressionGate::configure(const BenchOptions& options) {
+    if (options.threshold < 0) {
+        throw std::invalid_argument(std::format("threshold must not be negative: {}", options.threshold));
+    }
+    options_ = options;
+    baseline_ = Baseline::load(options.baseline);
+    changed_ = false;
+}
+
+RegressionVerdict RegressionGate::check(const Result& result) {
+    RegressionVerdict verdict;
+    const auto* base = baseline_.find(result.name, result.distribution, result.size);
+    if (options_.update_baseline || base == nullptr || base->stats.median <= 0) {
+        baseline_.record(result);
+        changed_ = true;
+        return verdict;
+    }
+    verdict.baseline_ns = base->stats.median;
+    verdict.ratio = result.stats.median / base->stats.median;
+    verdict.regressed = verdict.ratio > 1.0 + options_.threshold;
+    return verdict;
+}
+
+void RegressionGate::finish() const {
+    if (changed_) {
+        baseline_.save(options_.baseline);
+    }
+}
+
+RegressionGate& regression_gate() {
+    static RegressionGate gate;
+    return gate;
+}
+
+}  // namespace AlgorithmSamples::Benchmark
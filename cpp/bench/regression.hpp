@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace AlgorithmSamples::Benchmark {
+
+// algorithms_bench のコマンドライン引数
+struct BenchOptions {
+    std::filesystem::path baseline = "algorithms_bench_baseline.csv";
+    // 中央値がベースラインの (1 + threshold) 倍を超えたら回帰とみなす
+    double threshold = 0.25;
+    // 比較せずに、今回の結果でベースラインを書き換える
+    bool update_baseline = false;
+    size_t iterations = 10;
+};
+
+// 前回までの計測結果。ファイルは write_csv と同じ形式で、(algorithm, distribution, size) ごとに 1 行
+class Baseline {
+public:
+    // ファイルがなければ空のベースラインを返す。形式が正しくなければ std::runtime_error を投げる
+    static Baseline load(const std::filesystem::path& path);
+
+    const Result* find(const std::string& name, Distribution distribution, size_t size) const;
+    // 同じ組み合わせの記録があれば置き換える
+    void record(const Result& result);
+    void save(const std::filesystem::path& path) const;
+
+private:
+    std::vector<Result> results_;
+};
+
+struct RegressionVerdict {
+    std::optional<double> baseline_ns;  // ベースラインに記録がなければ空
+    double ratio = 1.0;                 // 今回の中央値 / ベースラインの中央値
+    bool regressed = false;
+};
+
+// 計測結果をベースラインと比べる。記録のない組み合わせと --update-baseline 指定時の結果はベースラインに加え、
+// finish() でファイルに書き戻す
+class RegressionGate {
+public:
+    void configure(const BenchOptions& options);
+    const BenchOptions& options() const { return options_; }
+
+    RegressionVerdict check(const Result& result);
+    void finish() const;
+
+private:
+    BenchOptions options_;
+    Baseline baseline_;
+    bool changed_ = false;
+};
+
+RegressionGate& regression_gate();
+
+}  // namespace AlgorithmSamples::Benchmark
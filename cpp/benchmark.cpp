@@ -0,0 +1,206 @@
+﻿#include "benchmark.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include "sort/indirect_sort.hpp"
+
+namespace AlgorithmSamples::Benchmark {
+
+static_assert(Sort::enable_indirect_sort<LargeElement>);
+
+namespace {
+std::vector<std::pair<std::string, Target>> g_benchmarks;
+
+// この要素数以上の入力はスレッドで並列に生成する
+constexpr size_t PARALLEL_INPUT_SIZE = 1 << 20;
+
+double percentile(const std::vector<double>& sorted, double p) {
+    // 最近傍ランク法
+    auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+}  // namespace
+
+std::vector<int> make_input(Distribution distribution, size_t size, uint64_t seed) {
+    const Workload::Options options{.distribution = distribution, .seed = seed};
+    if (size < PARALLEL_INPUT_SIZE) {
+        return Workload::generate<int>(size, options);
+    }
+    // 大きな入力では、生成がソートより遅くならないようにスレッドで分担する
+    static Concurrency::WorkStealingPool pool;
+    return Workload::generate<int>(size, options, pool);
+}
+
+Stats summarize(std::vector<double> samples) {
+    if (samples.empty()) {
+        return {};
+    }
+    std::ranges::sort(samples);
+
+    Stats stats;
+    stats.min = samples.front();
+    stats.median = percentile(samples, 0.5);
+    stats.p95 = percentile(samples, 0.95);
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+
+    double variance = 0;
+    for (auto sample : samples) {
+        variance += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = std::sqrt(variance / static_cast<double>(samples.size()));
+    return stats;
+}
+
+std::vector<Result> run(const std::string& name, const Target& target, const Options& options) {
+    std::vector<Result> results;
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+
+#ifdef ALGORITHM_SAMPLES_INSTRUMENTATION
+    PerfCounterGroup perf;
+#endif
+
+    for (auto size : options.sizes) {
+        for (auto distribution : options.distributions) {
+            const auto input = make_input(distribution, size, options.seed);
+            std::vector<int> work(size);
+
+            for (size_t i = 0; i < options.warmup; ++i) {
+                std::ranges::copy(input, work.begin());
+                target.sort(work);
+            }
+
+            samples.clear();
+#ifdef ALGORITHM_SAMPLES_INSTRUMENTATION
+            std::optional<PerfCounts> perf_total;
+            if (perf.available()) {
+                perf_total.emplace();
+            }
+#endif
+            for (size_t i = 0; i < options.iterations; ++i) {
+                std::ranges::copy(input, work.begin());
+#ifdef ALGORITHM_SAMPLES_INSTRUMENTATION
+                perf.start();
+#endif
+                auto start = std::chrono::steady_clock::now();
+                target.sort(work);
+                auto end = std::chrono::steady_clock::now();
+#ifdef ALGORITHM_SAMPLES_INSTRUMENTATION
+                if (auto counts = perf.stop(); counts && perf_total) {
+                    *perf_total += *counts;
+                }
+#endif
+                samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+
+            if (!std::ranges::is_sorted(work)) {
+                throw std::runtime_error(std::format("{} did not sort {} input of size {}", name,
+                                                     to_string(distribution), size));
+            }
+
+            Result result{name, distribution, size, options.iterations, summarize(samples),
+                          std::nullopt, std::nullopt};
+#ifdef ALGORITHM_SAMPLES_INSTRUMENTATION
+            if (perf_total && options.iterations > 0) {
+                result.perf = PerfCounts{perf_total->cycles / options.iterations,
+                                         perf_total->instructions / options.iterations,
+                                         perf_total->branch_misses / options.iterations,
+                                         perf_total->cache_misses / options.iterations};
+            }
+#endif
+            if (target.counted) {
+                std::vector<Sort::Counted<int>> counted(input.begin(), input.end());
+                Sort::reset_operation_counts();
+                target.counted(counted);
+                result.operations = Sort::operation_counts();
+            }
+            results.push_back(std::move(result));
+        }
+    }
+    return results;
+}
+
+void write_text(std::ostream& os, const std::vector<Result>& results) {
+    os << std::format("{:<16} {:<12} {:>10} {:>14} {:>14} {:>14} {:>14}\n", "algorithm", "distribution", "size",
+                      "min [ns]", "median [ns]", "p95 [ns]", "stddev [ns]");
+    for (const auto& r : results) {
+        os << std::format("{:<16} {:<12} {:>10} {:>14.0f} {:>14.0f} {:>14.0f} {:>14.0f}\n", r.name,
+                          to_string(r.distribution), r.size, r.stats.min, r.stats.median, r.stats.p95,
+                          r.stats.stddev);
+        if (r.operations) {
+            os << std::format("{:>40}comparisons={} swaps={} moves={} writes={}\n", "", r.operations->comparisons,
+                              r.operations->swaps, r.operations->moves, r.operations->writes);
+        }
+        if (r.perf) {
+            os << std::format("{:>40}cycles={} instructions={} branch-misses={} cache-misses={}\n", "",
+                              r.perf->cycles, r.perf->instructions, r.perf->branch_misses, r.perf->cache_misses);
+        }
+    }
+}
+
+void write_csv(std::ostream& os, const std::vector<Result>& results) {
+    // 取得できなかったカウンタは空欄にして、列構成は常に同じにする
+    os << "algorithm,distribution,size,iterations,min_ns,median_ns,p95_ns,mean_ns,stddev_ns,"
+          "comparisons,swaps,moves,writes,cycles,instructions,branch_misses,cache_misses\n";
+    for (const auto& r : results) {
+        os << std::format("{},{},{},{},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f},", r.name, to_string(r.distribution),
+                          r.size, r.iterations, r.stats.min, r.stats.median, r.stats.p95, r.stats.mean,
+                          r.stats.stddev);
+        if (r.operations) {
+            os << std::format("{},{},{},{},", r.operations->comparisons, r.operations->swaps, r.operations->moves,
+                              r.operations->writes);
+        } else {
+            os << ",,,,";
+        }
+        if (r.perf) {
+            os << std::format("{},{},{},{}\n", r.perf->cycles, r.perf->instructions, r.perf->branch_misses,
+                              r.perf->cache_misses);
+        } else {
+            os << ",,,\n";
+        }
+    }
+}
+
+void write_json(std::ostream& os, const std::vector<Result>& results) {
+    os << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        os << std::format(
+            "  {{\"algorithm\": \"{}\", \"distribution\": \"{}\", \"size\": {}, \"iterations\": {}, "
+            "\"min_ns\": {:.1f}, \"median_ns\": {:.1f}, \"p95_ns\": {:.1f}, \"mean_ns\": {:.1f}, "
+            "\"stddev_ns\": {:.1f}",
+            r.name, to_string(r.distribution), r.size, r.iterations, r.stats.min, r.stats.median, r.stats.p95,
+            r.stats.mean, r.stats.stddev);
+        if (r.operations) {
+            os << std::format(", \"comparisons\": {}, \"swaps\": {}, \"moves\": {}, \"writes\": {}",
+                              r.operations->comparisons, r.operations->swaps, r.operations->moves,
+                              r.operations->writes);
+        }
+        if (r.perf) {
+            os << std::format(", \"cycles\": {}, \"instructions\": {}, \"branch_misses\": {}, \"cache_misses\": {}",
+                              r.perf->cycles, r.perf->instructions, r.perf->branch_misses, r.perf->cache_misses);
+        }
+        os << "}";
+        os << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "]\n";
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(const std::string& name, Target target) {
+    g_benchmarks.emplace_back(name, std::move(target));
+}
+
+const std::vector<std::pair<std::string, Target>>& list_benchmarks() { return g_benchmarks; }
+
+Target find_benchmark(const std::string& name) {
+    auto it = std::ranges::find(g_benchmarks, name, &std::pair<std::string, Target>::first);
+    if (it == g_benchmarks.end()) {
+        return Target();
+    }
+    return it->second;
+}
+
+}  // namespace AlgorithmSamples::Benchmark
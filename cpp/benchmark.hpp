@@ -0,0 +1,142 @@
+﻿#pragma once
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "perf_counters.hpp"
+#include "sort/instrumentation.hpp"
+#include "workload/workload.hpp"
+
+namespace AlgorithmSamples::Benchmark {
+
+// 入力データの分布 (workload/workload.hpp のものを使う)
+using Distribution = Workload::Distribution;
+using Workload::parse_distribution;
+using Workload::to_string;
+
+// --dist を省略したときに計測する分布
+inline constexpr Distribution DEFAULT_DISTRIBUTIONS[] = {
+    Distribution::Random,    Distribution::Sorted,    Distribution::Reversed,
+    Distribution::FewUnique, Distribution::OrganPipe,
+};
+
+// seed が同じなら常に同じ入力を返す (Workload::generate の既定のパラメーター)
+std::vector<int> make_input(Distribution distribution, size_t size, uint64_t seed);
+
+// 計測対象のソート。渡された範囲をその場でソートする
+using SortFn = std::function<void(std::span<int>)>;
+// 操作回数を数えるための、Counted<int> 版のソート
+using CountedSortFn = std::function<void(std::span<Sort::Counted<int>>)>;
+
+// Sort::INDIRECT_SORT_THRESHOLD (64 バイト) を超える 128 バイトの要素。key で比べる
+struct LargeElement {
+    int key = 0;
+    std::array<std::byte, 124> payload{};
+
+    friend constexpr bool operator==(const LargeElement& a, const LargeElement& b) { return a.key == b.key; }
+    friend constexpr auto operator<=>(const LargeElement& a, const LargeElement& b) { return a.key <=> b.key; }
+};
+
+// in-place の検査で、間接ソートに切り替わる大きさの要素を試すための LargeElement 版のソート
+using LargeSortFn = std::function<void(std::span<LargeElement>)>;
+
+// 交換で進むソート (bubble_sort など) は、要素が INDIRECT_SORT_THRESHOLD を超えると
+// (キー, 位置) の配列を 1 回だけ確保する間接ソートに切り替わる。in-place のソートにもその 1 回までは許す
+inline constexpr size_t LARGE_ELEMENT_ALLOCATIONS = 1;
+
+struct Target {
+    SortFn sort;
+    CountedSortFn counted;  // ALGORITHM_SAMPLES_INSTRUMENTATION 無効時は空
+    // ソートの呼び出し中に、INDIRECT_SORT_THRESHOLD 以下の要素ではメモリを確保せず、それより大きな要素でも
+    // LARGE_ELEMENT_ALLOCATIONS 回までしか確保しない (runner の --check-in-place で確かめる)
+    bool in_place = false;
+    LargeSortFn large;  // in_place のときだけ設定する
+};
+
+// (first, last) を受け取るジェネリックなソート関数から Target を作る
+template <typename F>
+Target make_target(F fn) {
+    Target target;
+    target.sort = [fn](std::span<int> data) { fn(data.begin(), data.end()); };
+#ifdef ALGORITHM_SAMPLES_INSTRUMENTATION
+    target.counted = [fn](std::span<Sort::Counted<int>> data) { fn(data.begin(), data.end()); };
+#endif
+    return target;
+}
+
+// in-place のソートの Target を作る。make_target に加えて LargeElement 版も作る
+template <typename F>
+Target make_in_place_target(F fn) {
+    auto target = make_target(fn);
+    target.in_place = true;
+    target.large = [fn](std::span<LargeElement> data) { fn(data.begin(), data.end()); };
+    return target;
+}
+
+struct Options {
+    size_t warmup = 2;
+    size_t iterations = 10;
+    std::vector<size_t> sizes = {1'000, 10'000};
+    std::vector<Distribution> distributions{std::begin(DEFAULT_DISTRIBUTIONS), std::end(DEFAULT_DISTRIBUTIONS)};
+    uint64_t seed = Workload::DEFAULT_SEED;
+};
+
+// 1 回のソートにかかった時間 (ナノ秒) の統計
+struct Stats {
+    double min = 0;
+    double median = 0;
+    double p95 = 0;
+    double mean = 0;
+    double stddev = 0;
+};
+
+struct Result {
+    std::string name;
+    Distribution distribution = Distribution::Random;
+    size_t size = 0;
+    size_t iterations = 0;
+    Stats stats;
+    std::optional<Sort::OperationCounts> operations;  // 1 回のソートでの操作回数
+    std::optional<PerfCounts> perf;                   // 1 回のソートあたりの平均値
+};
+
+Stats summarize(std::vector<double> samples);
+
+// sizes × distributions の全組み合わせについて、warmup 回の空回しの後 iterations 回計測する。
+// 計測するのは sort の呼び出しだけで、入力の生成とコピーは含まない。
+// ALGORITHM_SAMPLES_INSTRUMENTATION 有効時は、操作回数とハードウェアカウンタも記録する。
+std::vector<Result> run(const std::string& name, const Target& target, const Options& options);
+
+void write_text(std::ostream& os, const std::vector<Result>& results);
+void write_csv(std::ostream& os, const std::vector<Result>& results);
+void write_json(std::ostream& os, const std::vector<Result>& results);
+
+struct BenchmarkRegistrar {
+    // fn は (first, last) を受け取るソート関数。ジェネリックラムダを想定している
+    template <typename F>
+    BenchmarkRegistrar(const std::string& name, F fn) : BenchmarkRegistrar(name, make_target(fn)) {}
+    BenchmarkRegistrar(const std::string& name, Target target);
+};
+
+#define REGISTER_BENCHMARK(NAME, FN) \
+    static AlgorithmSamples::Benchmark::BenchmarkRegistrar _benchmark_registrar_##NAME(#NAME, FN)
+
+// 作業領域を確保せずにその場でソートするものとして登録する。
+// Target::in_place の約束を破れば、runner の --check-in-place (ctest の algorithms_runner_in_place) が失敗する
+#define REGISTER_IN_PLACE_BENCHMARK(NAME, FN)                                            \
+    static AlgorithmSamples::Benchmark::BenchmarkRegistrar _benchmark_registrar_##NAME( \
+        #NAME, AlgorithmSamples::Benchmark::make_in_place_target(FN))
+
+const std::vector<std::pair<std::string, Target>>& list_benchmarks();
+// 見つからない場合は sort が空の Target を返す
+Target find_benchmark(const std::string& name);
+
+}  // namespace AlgorithmSamples::Benchmark
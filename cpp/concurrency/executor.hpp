@@ -0,0 +1,128 @@
+﻿#pragma once
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace AlgorithmSamples::Concurrency {
+
+// 関数を後で (別のスレッドやイベントループの次の周回で) 実行する実行器。
+// execute() の中で fn を直接呼んではいけない (コルーチンの再開が呼び出しの中で入れ子になり、スタックが伸び続ける)。
+// asio の io_context など既存のイベントループは、post するだけの薄いラッパーでこの要件を満たせる
+template <typename E>
+concept Executor = requires(E& executor, std::function<void()> fn) { executor.execute(std::move(fn)); };
+
+// イベントループに組み込むための実行器。execute() はキューに積むだけで、
+// 呼び出し側がループの中で run_one() / run_until_idle() を呼んで実行する
+class ManualExecutor {
+public:
+    ManualExecutor() = default;
+    ManualExecutor(const ManualExecutor&) = delete;
+    ManualExecutor& operator=(const ManualExecutor&) = delete;
+    ManualExecutor(ManualExecutor&&) = delete;
+    ManualExecutor& operator=(ManualExecutor&&) = delete;
+    ~ManualExecutor() = default;
+
+    void execute(std::function<void()> fn) {
+        std::lock_guard lock(mutex_);
+        queue_.push_back(std::move(fn));
+    }
+
+    // 積まれた関数を 1 つ実行する。キューが空なら false
+    bool run_one() {
+        std::function<void()> fn;
+        {
+            std::lock_guard lock(mutex_);
+            if (queue_.empty()) {
+                return false;
+            }
+            fn = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        fn();
+        return true;
+    }
+
+    // キューが空になるまで実行し、実行した数を返す。実行中に積まれた関数も実行する
+    size_t run_until_idle() {
+        size_t count = 0;
+        while (run_one()) {
+            ++count;
+        }
+        return count;
+    }
+
+    size_t pending() const {
+        std::lock_guard lock(mutex_);
+        return queue_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<std::function<void()>> queue_;
+};
+
+// 専用のスレッド 1 本で、積まれた順に関数を実行する実行器。
+// イベントループのスレッドを止めずに重い処理を進めるのに使う。破棄するときは積まれている関数を実行し終えてから止まる
+class ThreadExecutor {
+public:
+    ThreadExecutor() : thread_([this](std::stop_token stop) { worker_loop(stop); }) {}
+    ThreadExecutor(const ThreadExecutor&) = delete;
+    ThreadExecutor& operator=(const ThreadExecutor&) = delete;
+    ThreadExecutor(ThreadExecutor&&) = delete;
+    ThreadExecutor& operator=(ThreadExecutor&&) = delete;
+    ~ThreadExecutor() = default;
+
+    void execute(std::function<void()> fn) {
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push_back(std::move(fn));
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void worker_loop(std::stop_token stop) {
+        while (true) {
+            std::function<void()> fn;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, stop, [this] { return !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                fn = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            fn();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable_any cv_;
+    std::deque<std::function<void()>> queue_;
+    // 最後に宣言し、キューより先に止めて join する
+    std::jthread thread_;
+};
+
+// co_await schedule(executor) で、コルーチンの続きを executor に積んで中断する
+template <Executor E>
+auto schedule(E& executor) {
+    struct Awaiter {
+        E& executor;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const {
+            executor.execute([handle] { handle.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{executor};
+}
+
+}  // namespace AlgorithmSamples::Concurrency
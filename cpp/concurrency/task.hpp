@@ -0,0 +1,209 @@
+﻿#pragma once
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <semaphore>
+#include <type_traits>
+#include <utility>
+
+namespace AlgorithmSamples::Concurrency {
+
+template <typename T = void>
+class Task;
+
+namespace detail::task {
+
+// 完了したコルーチンから、それを co_await していたコルーチンへ直接制御を移す (対称転送)。
+// 待っている側がなければ (start() で開始した場合) 呼び出し元へ戻る
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+        if (auto continuation = handle.promise().continuation) {
+            return continuation;
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+class PromiseBase {
+public:
+    // 最初の co_await まで進めず、co_await されるか start() されるまで待つ
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    std::coroutine_handle<> continuation;
+
+protected:
+    void rethrow_if_exception() const {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+private:
+    std::exception_ptr exception_;
+};
+
+template <typename T>
+class Promise : public PromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+        requires std::convertible_to<U, T>
+    void return_value(U&& value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T result() {
+        rethrow_if_exception();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class Promise<void> : public PromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void result() const { rethrow_if_exception(); }
+};
+
+// sync_wait 用。Task の完了を待ってからセマフォを解放する
+class SyncWaitTask {
+public:
+    struct promise_type {
+        std::binary_semaphore* finished = nullptr;
+
+        SyncWaitTask get_return_object() noexcept {
+            return SyncWaitTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        auto final_suspend() const noexcept {
+            struct Notify {
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept {
+                    handle.promise().finished->release();
+                }
+                void await_resume() const noexcept {}
+            };
+            return Notify{};
+        }
+        void return_void() const noexcept {}
+        // 待つだけで結果を取り出さないので例外はここまで届かない
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    explicit SyncWaitTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+    SyncWaitTask(const SyncWaitTask&) = delete;
+    SyncWaitTask& operator=(const SyncWaitTask&) = delete;
+    SyncWaitTask(SyncWaitTask&&) = delete;
+    SyncWaitTask& operator=(SyncWaitTask&&) = delete;
+    ~SyncWaitTask() { handle_.destroy(); }
+
+    void start(std::binary_semaphore& finished) {
+        handle_.promise().finished = &finished;
+        handle_.resume();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+}  // namespace detail::task
+
+// 結果 T を返す遅延開始のコルーチン。コルーチンからは co_await で完了を待って結果を受け取り、
+// 通常の関数からは start() で開始するか sync_wait() で完了まで待つ。
+// done() / get() は、タスクを再開する実行器と同じスレッド (イベントループなど) からだけ呼べる。
+// 別のスレッドで完了するタスクは sync_wait() で待つ
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::task::Promise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    ~Task() { destroy(); }
+
+    // 呼び出し元のスレッドで最初の中断点まで進める
+    void start() { handle_.resume(); }
+
+    bool done() const { return handle_.done(); }
+
+    // 完了したタスクの結果を返す。コルーチンが例外で終わっていればそれを投げ直す
+    T get() { return handle_.promise().result(); }
+
+    auto operator co_await() && noexcept { return Awaiter<true>{handle_}; }
+
+    // 結果を取り出さずに完了だけを待つ。結果は後から get() で受け取る
+    auto when_ready() noexcept { return Awaiter<false>{handle_}; }
+
+private:
+    template <bool ReturnsResult>
+    struct Awaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+            handle.promise().continuation = awaiting;
+            return handle;
+        }
+        decltype(auto) await_resume() const {
+            if constexpr (ReturnsResult) {
+                return handle.promise().result();
+            }
+        }
+    };
+
+    void destroy() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail::task {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+}  // namespace detail::task
+
+// task を呼び出し元のスレッドで開始し、(別のスレッドで再開されていても) 完了するまでブロックして結果を返す。
+// task を再開するのが呼び出し元のスレッドで回すイベントループだと終わらないので、その場合は start() と done() を使う
+template <typename T>
+T sync_wait(Task<T> task) {
+    std::binary_semaphore finished{0};
+    auto waiter = [](Task<T>& task) -> detail::task::SyncWaitTask { co_await task.when_ready(); }(task);
+    waiter.start(finished);
+    finished.acquire();
+    return task.get();
+}
+
+}  // namespace AlgorithmSamples::Concurrency
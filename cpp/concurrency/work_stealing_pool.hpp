@@ -0,0 +1,211 @@
+﻿#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace AlgorithmSamples::Concurrency {
+
+// submit したタスクの完了を待ち合わせる単位
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup(TaskGroup&&) = delete;
+    TaskGroup& operator=(TaskGroup&&) = delete;
+    ~TaskGroup() = default;
+
+    bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class WorkStealingPool;
+
+    std::atomic<size_t> pending_{0};
+    std::mutex exception_mutex_;
+    std::exception_ptr exception_;
+};
+
+// ワークスティーリング方式のスレッドプール。
+// 参加スレッドごとに両端キューを持ち、自分のキューは末尾 (最後に積んだタスク) から、
+// 他のスレッドのキューは先頭 (最も古く、大きいことが多いタスク) から取り出す。
+//
+// thread_count には wait() を呼ぶスレッド自身も含む。
+// thread_count - 1 本のワーカーを起動し、wait() の呼び出し元も待っている間はタスクを実行する。
+// そのため thread_count == 1 ならタスクはすべて wait() の中で逐次実行される。
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t thread_count = default_thread_count()) {
+        thread_count = std::max<size_t>(thread_count, 1);
+        queues_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        // キュー 0 はプール外のスレッド用
+        threads_.reserve(thread_count - 1);
+        for (size_t i = 1; i < thread_count; ++i) {
+            threads_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    WorkStealingPool(WorkStealingPool&&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        sleep_cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    static size_t default_thread_count() { return std::max(std::thread::hardware_concurrency(), 1U); }
+
+    size_t thread_count() const { return queues_.size(); }
+
+    // fn を group に属するタスクとして積む。呼び出し元がワーカーなら自分のキューに積む。
+    // 積めずに例外を投げた場合、group には何も加わらない
+    template <typename F>
+    void submit(TaskGroup& group, F&& fn) {
+        Task task{std::function<void()>(std::forward<F>(fn)), &group};
+        {
+            std::lock_guard lock(queues_[current_queue()]->mutex);
+            queues_[current_queue()]->tasks.push_back(std::move(task));
+            // 取り出すにはこのロックが要るので、ここで数えても完了の方が先になることはない
+            group.pending_.fetch_add(1, std::memory_order_relaxed);
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+        {
+            // 眠りに入る直前のワーカーに通知を取りこぼさせないため、一度ロックを取る
+            std::lock_guard lock(sleep_mutex_);
+        }
+        sleep_cv_.notify_one();
+    }
+
+    // group のタスクがすべて終わるまで、他のタスクを実行しながら待つ。
+    // タスクが例外を投げた場合は、最初の例外をここで再送出する
+    void wait(TaskGroup& group) {
+        run_until_done(group);
+        std::lock_guard lock(group.exception_mutex_);
+        if (group.exception_) {
+            std::rethrow_exception(std::exchange(group.exception_, nullptr));
+        }
+    }
+
+    // fn を呼んでから wait(group) する。fn が例外で抜けた場合も group のタスクが終わるまで待ってから、
+    // fn の例外を再送出する (タスクの例外は捨てる)。
+    // submit したタスクが呼び出し元のローカル変数を参照している間は、こちらで待つこと
+    template <typename F>
+    void run_and_wait(TaskGroup& group, F&& fn) {
+        try {
+            std::forward<F>(fn)();
+        } catch (...) {
+            run_until_done(group);
+            std::lock_guard lock(group.exception_mutex_);
+            group.exception_ = nullptr;
+            throw;
+        }
+        wait(group);
+    }
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run_until_done(TaskGroup& group) {
+        const auto self = current_queue();
+        while (!group.done()) {
+            if (!try_run_one(self)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    size_t current_queue() const { return current_pool_ == this ? current_index_ : 0; }
+
+    bool try_pop(size_t index, bool steal, Task& task) {
+        auto& queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        if (steal) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        } else {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool try_run_one(size_t self) {
+        Task task;
+        bool found = try_pop(self, false, task);
+        for (size_t i = 1; !found && i < queues_.size(); ++i) {
+            found = try_pop((self + i) % queues_.size(), true, task);
+        }
+        if (!found) {
+            return false;
+        }
+
+        try {
+            task.fn();
+        } catch (...) {
+            std::lock_guard lock(task.group->exception_mutex_);
+            if (!task.group->exception_) {
+                task.group->exception_ = std::current_exception();
+            }
+        }
+        task.group->pending_.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void worker_loop(size_t index) {
+        current_pool_ = this;
+        current_index_ = index;
+        while (true) {
+            if (try_run_one(index)) {
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            sleep_cv_.wait(lock, [this] { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+            if (stopping_) {
+                return;
+            }
+        }
+    }
+
+    static inline thread_local const WorkStealingPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_index_ = 0;
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> queued_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stopping_ = false;
+};
+
+}  // namespace AlgorithmSamples::Concurrency
@@ -1,6 +1,10 @@
 ﻿#pragma once
+#include "allocation_tracker.hpp"
 #include <functional>
+#include <optional>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 using DemoFn = std::function<void(const std::vector<std::string>& args)>;
@@ -14,3 +18,43 @@ struct DemoRegistrar {
 void register_demo(const std::string& name, DemoFn fn);
 const std::vector<std::pair<std::string, DemoFn>>& list_demos();
 DemoFn find_demo(const std::string& name);
+
+// runner の --quiet / --verify / --memory の指定
+struct DemoOutputOptions {
+    bool quiet = false;   // 要素の一覧を表示しない
+    bool verify = false;  // 要素の一覧の代わりに、ソート済みかどうかを確かめる
+    bool memory = false;  // measure_allocations で囲んだ区間のメモリの確保を集計して表示する
+};
+
+void set_demo_output_options(const DemoOutputOptions& options);
+const DemoOutputOptions& demo_output_options();
+
+// ソートした結果を表示する。--verify ならソート済みかを確かめて (違えば std::runtime_error)、件数だけを表示する。
+// --quiet なら何も表示しない
+void print_sorted_result(std::span<const int> values);
+
+// --memory のときに measure_allocations が区間の集計を表示する
+void report_allocations(const std::string& label, const AlgorithmSamples::Benchmark::AllocationStats& stats);
+
+// --memory なら fn() の実行中のメモリの確保 (回数・大きさ・最大使用量) を集計し、label を付けて表示する。
+// ソートの呼び出しだけを囲み、入力の準備 (std::vector<int> v(ELEMENT_COUNT) など) は含めないこと。
+// --memory でなければ fn() を呼ぶだけ。fn() の戻り値を返す
+template <typename F>
+std::invoke_result_t<F&> measure_allocations(const std::string& label, F&& fn) {
+    std::optional<AlgorithmSamples::Benchmark::AllocationSection> section;
+    if (demo_output_options().memory) {
+        section.emplace();
+    }
+    if constexpr (std::is_void_v<std::invoke_result_t<F&>>) {
+        fn();
+        if (section) {
+            report_allocations(label, section->stats());
+        }
+    } else {
+        auto result = fn();
+        if (section) {
+            report_allocations(label, section->stats());
+        }
+        return result;
+    }
+}
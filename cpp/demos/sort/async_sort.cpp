@@ -0,0 +1,95 @@
+﻿#include "sort/async_sort.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <print>
+#include <stop_token>
+#include <string>
+#include <vector>
+#include "concurrency/executor.hpp"
+#include "concurrency/task.hpp"
+#include "sort/bubble_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+using namespace AlgorithmSamples::Concurrency;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto DEFAULT_ELEMENT_COUNT = 30'000;
+constexpr auto DEFAULT_YIELD_EVERY = 1'000'000;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+// ソートのタスクを積んだイベントループを回し、ループ 1 周の最大時間と、その間に処理できた他のイベントの数を表示する
+void run_event_loop(ManualExecutor& loop, Task<AsyncSortResult>& task, std::stop_source* stop, Milliseconds deadline) {
+    const auto start = Clock::now();
+    size_t other_events = 0;
+    Milliseconds longest{0};
+    task.start();
+    while (!task.done()) {
+        const auto slice_start = Clock::now();
+        loop.run_one();
+        // ソートの合間に届いた他のイベント (ここでは数えるだけ)
+        ++other_events;
+        const auto now = Clock::now();
+        longest = std::max<Milliseconds>(longest, now - slice_start);
+        if (stop != nullptr && now - start > deadline) {
+            stop->request_stop();
+        }
+    }
+    const auto result = task.get();
+    std::println("  {:L} パス / 比較 {:L} 回 {}", result.passes, result.loop_count, result.cancelled ? "(中断)" : "");
+    std::println("  所要時間 {:.1f} ms, ループ 1 周の最大 {:.2f} ms, 処理できた他のイベント {:L} 件",
+                 Milliseconds(Clock::now() - start).count(), longest.count(), other_events);
+}
+}  // namespace
+
+// args[0] で要素数、args[1] で何回の比較ごとにイベントループへ戻るかを指定できる
+static void async_sort_demo(const std::vector<std::string>& args) {
+    const size_t element_count = args.empty() ? DEFAULT_ELEMENT_COUNT : std::stoul(args[0]);
+    const size_t yield_every = args.size() < 2 ? DEFAULT_YIELD_EVERY : std::stoul(args[1]);
+
+    std::println("Async Sort Demo");
+    std::println("{:L} 件のデータをバブルソートします...", element_count);
+
+    const auto input = Workload::generate<int>(element_count, {.distribution = Workload::Distribution::Shuffled});
+
+    auto v = input;
+    auto start = Clock::now();
+    bubble_sort(v.begin(), v.end());
+    std::println("同期呼び出し: {:.1f} ms の間イベントループが止まる", Milliseconds(Clock::now() - start).count());
+
+    ManualExecutor loop;
+    v = input;
+    AsyncSortOptions options;
+    options.yield_every = yield_every;
+    size_t next_report = 1;
+    options.on_progress = [&](const SortProgress& progress) {
+        if (progress.passes * 4 >= progress.max_passes * next_report) {
+            std::println("  進捗 {:>3}% ({:L} / {:L} パス)", 25 * next_report, progress.passes, progress.max_passes);
+            ++next_report;
+        }
+    };
+    std::println("async_sort ({:L} 回の比較ごとにイベントループへ戻る):", yield_every);
+    auto task = async_sort(loop, BubbleSortPasses(v.begin(), v.end()), options);
+    run_event_loop(loop, task, nullptr, {});
+    std::println("  {}", std::ranges::is_sorted(v) ? "OK" : "NG");
+
+    v = input;
+    std::stop_source stop;
+    options.stop_token = stop.get_token();
+    options.on_progress = nullptr;
+    const Milliseconds deadline{100};
+    std::println("async_sort ({:.0f} ms で停止を要求):", deadline.count());
+    auto cancelled = async_sort(loop, BubbleSortPasses(v.begin(), v.end()), options);
+    run_event_loop(loop, cancelled, &stop, deadline);
+    auto sorted = v;
+    std::ranges::sort(sorted);
+    auto expected = input;
+    std::ranges::sort(expected);
+    std::println("  要素は失われていない: {}", sorted == expected ? "OK" : "NG");
+}
+
+REGISTER_DEMO(async_sort, async_sort_demo);
@@ -0,0 +1,108 @@
+﻿#include "sort/auto_sort.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <functional>
+#include <print>
+#include <string>
+#include <utility>
+#include <vector>
+#include "sort/pdq_sort.hpp"
+#include "sort/radix_sort.hpp"
+#include "sort/tim_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Benchmark = AlgorithmSamples::Benchmark;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr size_t SIZES[] = {100, 10'000, 1'000'000};
+// 1 つの入力を何回ソートして最小値を取るか
+constexpr auto REPEAT = 5;
+constexpr size_t BATCH_ELEMENTS = 100'000;
+
+namespace {
+using Input = std::pair<std::string, std::vector<int>>;
+
+// ベンチマークの分布に、ほぼ整列済みと末尾への追記を加えた組
+std::vector<Input> make_suite(size_t size) {
+    std::vector<Input> suite;
+    for (auto distribution : Benchmark::DEFAULT_DISTRIBUTIONS) {
+        suite.emplace_back(std::string(Benchmark::to_string(distribution)),
+                           Benchmark::make_input(distribution, size, 42));
+    }
+    suite.emplace_back(std::string(Benchmark::to_string(Benchmark::Distribution::NearlySorted)),
+                       Benchmark::make_input(Benchmark::Distribution::NearlySorted, size, 42));
+    // 整列済みの末尾 1% を [0, size) の乱数で置き換える
+    auto appended = Benchmark::make_input(Benchmark::Distribution::Sorted, size, 42);
+    const auto tail = Workload::generate<int>(
+        size / 100, {.distribution = Workload::Distribution::FewUnique, .seed = 42, .unique_values = size});
+    std::ranges::copy(tail, appended.end() - static_cast<std::ptrdiff_t>(tail.size()));
+    suite.emplace_back("appended", std::move(appended));
+    return suite;
+}
+
+// 小さい入力は 1 回では時計の分解能に届かないので、合計がおよそ BATCH_ELEMENTS 要素になるまで続けてソートする
+double measure(const std::vector<int>& input, const std::function<void(std::vector<int>&)>& sort) {
+    const auto batch = std::max<size_t>(BATCH_ELEMENTS / std::max<size_t>(input.size(), 1), 1);
+    std::vector<std::vector<int>> copies(batch);
+    double best = 0;
+    for (int i = 0; i < REPEAT; ++i) {
+        std::ranges::fill(copies, input);
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& v : copies) {
+            sort(v);
+        }
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        const auto per_sort = elapsed.count() / static_cast<double>(batch);
+        best = i == 0 ? per_sort : std::min(best, per_sort);
+    }
+    return best;
+}
+}  // namespace
+
+static void auto_sort_demo([[maybe_unused]] const std::vector<std::string>& args) {
+    std::println("Auto Sort Demo");
+    std::println("分布ごとに auto_sort と固定のソートを比べます (単位 µs, {} 回の最小値)", REPEAT);
+
+    const std::pair<const char*, std::function<void(std::vector<int>&)>> fixed[] = {
+        {"pdq_sort", [](auto& v) { pdq_sort(v.begin(), v.end()); }},
+        {"tim_sort", [](auto& v) { tim_sort(v.begin(), v.end()); }},
+        {"radix_sort",
+         [](auto& v) {
+             std::vector<int> scratch(v.size());
+             radix_sort(v.begin(), v.end(), scratch.begin());
+         }},
+        {"std::sort", [](auto& v) { std::sort(v.begin(), v.end()); }},
+    };
+
+    double worst_ratio = 0;
+    for (auto size : SIZES) {
+        std::println("{:>14} {:>10} {:>12} {:>10} {:>10} {:>10} {:>10} {:>7}", "distribution", "size", "auto_sort",
+                     "pdq_sort", "tim_sort", "radix_sort", "std::sort", "/best");
+        for (const auto& [name, input] : make_suite(size)) {
+            SortDecision decision;
+            const auto automatic = measure(input, [&](auto& v) {
+                auto_sort(v.begin(), v.end(), std::less<>(), std::identity(),
+                          [&](const SortDecision& chosen) { decision = chosen; });
+            });
+            double best = 0;
+            std::vector<double> times;
+            for (const auto& [fixed_name, sort] : fixed) {
+                times.push_back(measure(input, sort));
+                best = times.size() == 1 ? times.back() : std::min(best, times.back());
+            }
+            const auto ratio = automatic / best;
+            worst_ratio = std::max(worst_ratio, ratio);
+            std::println("{:>14} {:>10} {:>12} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>7.2f}", name, size,
+                         std::format("{} {:.1f}", to_string(decision.engine), automatic),
+                         times[0], times[1], times[2], times[3], ratio);
+        }
+    }
+    std::println("最良の固定ソートに対する auto_sort の比の最大: {:.2f}", worst_ratio);
+}
+
+REGISTER_DEMO(auto_sort, auto_sort_demo);
+REGISTER_BENCHMARK(auto_sort, [](auto first, auto last) { auto_sort(first, last); });
@@ -0,0 +1,93 @@
+﻿#include "sort/external_sort.hpp"
+#include "demo_registry.hpp"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr size_t DEFAULT_RECORD_COUNT = 20'000'000;
+constexpr size_t DEFAULT_MEMORY_BUDGET_MB = 16;
+constexpr size_t DEFAULT_FAN_IN = 8;
+
+// 入力の件数と総和を検証に使う
+struct Summary {
+    size_t count = 0;
+    uint64_t sum = 0;
+    bool sorted = true;
+};
+
+static Summary generate_file(const std::filesystem::path& path, size_t count) {
+    std::ofstream stream(path, std::ios::binary);
+    std::mt19937_64 engine(Workload::DEFAULT_SEED);
+    std::vector<uint64_t> block(1 << 16);
+    Summary summary;
+    while (summary.count < count) {
+        const auto n = std::min(block.size(), count - summary.count);
+        for (size_t i = 0; i < n; ++i) {
+            block[i] = engine();
+            summary.sum += block[i];
+        }
+        stream.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(n * sizeof(uint64_t)));
+        summary.count += n;
+    }
+    return summary;
+}
+
+static Summary summarize_file(const std::filesystem::path& path) {
+    RecordReader<uint64_t> reader(path, 1 << 16);
+    Summary summary;
+    uint64_t previous = 0;
+    for (; reader.has_value(); reader.advance()) {
+        const auto value = reader.value();
+        summary.sorted = summary.sorted && (summary.count == 0 || previous <= value);
+        summary.sum += value;
+        previous = value;
+        ++summary.count;
+    }
+    return summary;
+}
+
+// args[0] でレコード数、args[1] でメモリ上限 (MB)、args[2] でマージの fan-in を指定できる
+static void external_sort_demo(const std::vector<std::string>& args) {
+    const size_t record_count = args.size() > 0 ? std::stoul(args[0]) : DEFAULT_RECORD_COUNT;
+    const size_t budget_mb = args.size() > 1 ? std::stoul(args[1]) : DEFAULT_MEMORY_BUDGET_MB;
+    const size_t fan_in = args.size() > 2 ? std::stoul(args[2]) : DEFAULT_FAN_IN;
+
+    std::println("External Merge Sort Demo");
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto input = directory / "algorithm_samples_external_input.bin";
+    const auto output = directory / "algorithm_samples_external_output.bin";
+
+    std::println("{:L} 件の uint64_t レコードを {} に書き出します...", record_count, input.string());
+    const auto expected = generate_file(input, record_count);
+
+    std::println("メモリ上限 {} MB、fan-in {} でソートします...", budget_mb, fan_in);
+    auto start = std::chrono::steady_clock::now();
+    const auto stats = measure_allocations("external_sort", [&] {
+        return external_sort<uint64_t>(input, output, std::less<>(), std::identity(),
+                                       {.memory_budget = budget_mb << 20, .fan_in = fan_in});
+    });
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+    const double megabytes = static_cast<double>(record_count * sizeof(uint64_t)) / (1 << 20);
+    std::println("ソート完了: {:.1f} ms ({:.1f} MB/s)", elapsed.count(), megabytes / (elapsed.count() / 1000));
+    std::println("ラン数: {:L}、マージ段数: {}", stats.runs, stats.merge_passes);
+
+    std::println("出力を検証します...");
+    const auto actual = summarize_file(output);
+    const bool ok = actual.sorted && actual.count == expected.count && actual.sum == expected.sum;
+    std::println("{}", ok ? "OK" : "NG");
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+REGISTER_DEMO(external_sort, external_sort_demo);
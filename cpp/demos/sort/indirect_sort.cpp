@@ -0,0 +1,97 @@
+﻿#include "sort/indirect_sort.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+#include "sort/bubble_sort.hpp"
+#include "sort/pdq_sort.hpp"
+
+using namespace AlgorithmSamples::Sort;
+
+namespace {
+
+// Size バイトのレコード。Indirect で間接ソートへの自動切り替えを強制的に有効・無効にする
+template <size_t Size, bool Indirect>
+struct Record {
+    uint32_t key;
+    std::array<char, Size - sizeof(uint32_t)> payload;
+};
+
+}  // namespace
+
+template <size_t Size, bool Indirect>
+inline constexpr bool AlgorithmSamples::Sort::enable_indirect_sort<Record<Size, Indirect>> = Indirect;
+
+namespace {
+
+constexpr auto QUADRATIC_ELEMENT_COUNT = 4'000;
+constexpr auto ELEMENT_COUNT = 1'000'000;
+
+template <typename T>
+std::vector<T> make_records(size_t count, uint32_t seed) {
+    std::mt19937 engine(seed);
+    std::vector<T> records(count);
+    for (auto& record : records) {
+        record.key = static_cast<uint32_t>(engine());
+    }
+    return records;
+}
+
+template <typename T>
+double measure(std::vector<T> v, auto sort) {
+    auto start = std::chrono::steady_clock::now();
+    sort(v);
+    auto end = std::chrono::steady_clock::now();
+    if (!std::ranges::is_sorted(v, {}, &T::key)) {
+        std::println("ソート結果が正しくありません");
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <size_t Size>
+void compare_record_size() {
+    using Direct = Record<Size, false>;
+    using Indirect = Record<Size, true>;
+
+    const auto small_direct = make_records<Direct>(QUADRATIC_ELEMENT_COUNT, Size);
+    const auto small_indirect = make_records<Indirect>(QUADRATIC_ELEMENT_COUNT, Size);
+    auto bubble = [](auto& v) {
+        using T = std::ranges::range_value_t<decltype(v)>;
+        bubble_sort(v.begin(), v.end(), std::less<>(), &T::key);
+    };
+    const auto bubble_direct = measure(small_direct, bubble);
+    const auto bubble_indirect = measure(small_indirect, bubble);
+
+    const auto direct = make_records<Direct>(ELEMENT_COUNT, Size);
+    const auto pdq_direct = measure(direct, [](auto& v) { pdq_sort(v.begin(), v.end(), std::less<>(), &Direct::key); });
+    const auto pdq_indirect =
+        measure(direct, [](auto& v) { indirect_sort(v.begin(), v.end(), std::less<>(), &Direct::key); });
+
+    std::println("{:>5} バイト | {:>9.1f} ms {:>9.1f} ms | {:>9.1f} ms {:>9.1f} ms", Size, bubble_direct,
+                 bubble_indirect, pdq_direct, pdq_indirect);
+}
+
+}  // namespace
+
+static void indirect_sort_demo([[maybe_unused]] const std::vector<std::string>& args) {
+    std::println("Indirect Sort Demo");
+    std::println("レコードの大きさごとに、要素を直接交換するソートと (キー, 位置) の組をソートする間接ソートを比べます");
+    std::println("bubble_sort は {:L} 件、pdq_sort / indirect_sort は {:L} 件", QUADRATIC_ELEMENT_COUNT,
+                 ELEMENT_COUNT);
+    std::println("{:>11} | {:>12} {:>12} | {:>12} {:>12}", "", "bubble_sort", "(間接)", "pdq_sort", "indirect_sort");
+    compare_record_size<16>();
+    compare_record_size<64>();
+    compare_record_size<128>();
+    compare_record_size<256>();
+    compare_record_size<512>();
+}
+
+REGISTER_DEMO(indirect_sort, indirect_sort_demo);
+REGISTER_BENCHMARK(indirect_sort, [](auto first, auto last) { indirect_sort(first, last); });
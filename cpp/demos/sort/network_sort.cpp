@@ -0,0 +1,56 @@
+﻿#include "sort/network_sort.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <span>
+#include <string>
+#include <vector>
+#include "sort/bubble_sort.hpp"
+#include "sort/pdq_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr size_t ARRAY_SIZE = 16;
+constexpr auto ARRAY_COUNT = 1'000'000;
+
+static void network_sort_demo([[maybe_unused]] const std::vector<std::string>& args) {
+    std::println("Sorting Network Demo");
+    std::println("{} 要素のネットワーク: 比較交換 {} 回", ARRAY_SIZE, SORTING_NETWORK<ARRAY_SIZE>.size());
+    std::println("{:L} 個の {} 要素の int32_t 配列を準備します...", ARRAY_COUNT, ARRAY_SIZE);
+
+    const auto input = Workload::generate<int32_t>(ARRAY_SIZE * ARRAY_COUNT);
+
+    auto measure = [&](const char* name, auto sort) {
+        auto v = input;
+        auto start = std::chrono::steady_clock::now();
+        measure_allocations(name, [&] { sort(v); });
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        bool ok = true;
+        for (auto it = v.begin(); it != v.end(); it += ARRAY_SIZE) {
+            ok = ok && std::is_sorted(it, it + ARRAY_SIZE);
+        }
+        std::println("{:<18}: {:>8.1f} ms {}", name, elapsed.count(), ok ? "OK" : "NG");
+    };
+
+    auto each_array = [](auto sort) {
+        return [=](std::vector<int32_t>& v) {
+            for (auto it = v.begin(); it != v.end(); it += ARRAY_SIZE) {
+                sort(it, it + ARRAY_SIZE);
+            }
+        };
+    };
+
+    std::println("配列を 1 個ずつ、またはまとめてソートします...");
+    measure("bubble_sort", each_array([](auto first, auto last) { bubble_sort(first, last); }));
+    measure("pdq_sort", each_array([](auto first, auto last) { pdq_sort(first, last); }));
+    measure("std::sort", each_array([](auto first, auto last) { std::sort(first, last); }));
+    measure("network_sort", each_array([](auto first, auto) { network_sort<ARRAY_SIZE>(first); }));
+    measure("network_sort_batch", [](auto& v) { network_sort_batch<ARRAY_SIZE>(std::span(v)); });
+}
+
+REGISTER_DEMO(network_sort, network_sort_demo);
@@ -0,0 +1,71 @@
+﻿#include "sort/odd_even_sort.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sort/bubble_sort.hpp"
+#include "sort/shaker_sort.hpp"
+#include "sort/trace.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto ELEMENT_COUNT = 1'000;
+constexpr auto DEFAULT_COMPARISON_SIZE = 50'000;
+
+// args[0] で速さを比べる要素数、args[1] で parallel_odd_even_sort のスレッド数を指定できる
+static void odd_even_sort_demo(const std::vector<std::string>& args) {
+    const size_t comparison_size = args.empty() ? DEFAULT_COMPARISON_SIZE : std::stoul(args[0]);
+    const size_t thread_count = args.size() < 2 ? OddEvenSortOptions{}.thread_count : std::stoul(args[1]);
+
+    std::println("Odd-Even Transposition Sort Demo");
+    std::println("{:L} 件のデータを準備します...", ELEMENT_COUNT);
+
+    // シードを固定した 0, 1, ..., n - 1 の並べ替えなので、実行ごとに同じ入力になる
+    auto v = Workload::generate<int>(ELEMENT_COUNT, {.distribution = Workload::Distribution::Shuffled});
+
+    std::println("{:L} 件のデータをソートします...", ELEMENT_COUNT);
+
+    auto loopCount =
+        measure_allocations("odd_even_sort", [&] { return odd_even_sort(v.begin(), v.end(), std::less<>()); });
+
+    std::println("{:L} 件のデータのソートが完了しました。", ELEMENT_COUNT);
+    std::println("ループ回数: {:L}", loopCount);
+
+    print_sorted_result(v);
+
+    // 隣り合う要素の交換が前の交換に依存するバブル・シェーカーソートと、
+    // フェーズ内の比較交換が互いに独立な奇偶転置ソートを比べる
+    std::println();
+    std::println("{:L} 件で速さを比べます (parallel_odd_even_sort は {} スレッド)...", comparison_size, thread_count);
+    const auto input = Workload::generate<int>(comparison_size);
+    auto measure = [&](const char* name, auto sort) {
+        auto data = input;
+        TraceSpan span(name);
+        const auto start = std::chrono::steady_clock::now();
+        const size_t count = measure_allocations(name, [&] { return sort(data); });
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::println("  {:<26}: {:>10.1f} ms  比較 {:>15L} 回 {}", name, elapsed.count(), count,
+                     std::ranges::is_sorted(data) ? "OK" : "NG");
+    };
+    measure("adaptive_bubble_sort",
+            [](auto& data) { return adaptive_bubble_sort(data.begin(), data.end()).loopCount; });
+    measure("adaptive_shaker_sort",
+            [](auto& data) { return adaptive_shaker_sort(data.begin(), data.end()).loopCount; });
+    measure("odd_even_sort (汎用)", [](auto& data) {
+        return odd_even_sort(data.begin(), data.end(), [](int a, int b) { return a < b; });
+    });
+    measure("odd_even_sort", [](auto& data) { return odd_even_sort(data.begin(), data.end()); });
+    measure("parallel_odd_even_sort", [&](auto& data) {
+        return parallel_odd_even_sort(data.begin(), data.end(), {.thread_count = thread_count});
+    });
+}
+
+REGISTER_DEMO(odd_even_sort, odd_even_sort_demo);
+REGISTER_IN_PLACE_BENCHMARK(odd_even_sort, [](auto first, auto last) { odd_even_sort(first, last); });
+REGISTER_BENCHMARK(parallel_odd_even_sort, [](auto first, auto last) { parallel_odd_even_sort(first, last); });
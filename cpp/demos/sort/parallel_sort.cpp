@@ -0,0 +1,63 @@
+﻿#include "sort/parallel_sort.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <print>
+#include <string>
+#include <vector>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Concurrency;
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto DEFAULT_ELEMENT_COUNT = 100'000'000;
+
+static WorkStealingPool& default_pool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+// args[0] で要素数を指定できる
+static void parallel_sort_demo(const std::vector<std::string>& args) {
+    const size_t element_count = args.empty() ? DEFAULT_ELEMENT_COUNT : std::stoul(args[0]);
+
+    std::println("Parallel Sort Demo");
+    std::println("{:L} 件のデータを準備します...", element_count);
+
+    std::println("{:L} 件のデータをシャッフルします...", element_count);
+
+    // シードを固定した 0, 1, ..., n - 1 の並べ替えなので、実行ごとに同じ入力になる
+    auto input = Workload::generate<int>(element_count, {.distribution = Workload::Distribution::Shuffled});
+
+    std::println("スレッド数を 1 から {} まで変えてソートします...", WorkStealingPool::default_thread_count());
+
+    std::vector<int> v(element_count);
+    double single_thread_ms = 0;
+    for (size_t threads = 1;; threads *= 2) {
+        threads = std::min(threads, WorkStealingPool::default_thread_count());
+        WorkStealingPool pool(threads);
+        std::ranges::copy(input, v.begin());
+
+        auto start = std::chrono::steady_clock::now();
+        measure_allocations(std::format("parallel_sort {} スレッド", threads),
+                            [&] { parallel_sort(v.begin(), v.end(), pool); });
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+
+        if (threads == 1) {
+            single_thread_ms = elapsed.count();
+        }
+        std::println("{:>3} スレッド: {:>10.1f} ms (x{:.2f}) {}", threads, elapsed.count(),
+                     single_thread_ms / elapsed.count(), std::ranges::is_sorted(v) ? "OK" : "NG");
+
+        if (threads == WorkStealingPool::default_thread_count()) {
+            break;
+        }
+    }
+}
+
+REGISTER_DEMO(parallel_sort, parallel_sort_demo);
+REGISTER_BENCHMARK(parallel_sort, [](auto first, auto last) { parallel_sort(first, last, default_pool()); });
@@ -0,0 +1,49 @@
+﻿#include "sort/pdq_sort.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <print>
+#include <string>
+#include <vector>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto ELEMENT_COUNT = 10'000'000;
+
+static void pdq_sort_demo([[maybe_unused]] const std::vector<std::string>& args) {
+    std::println("Pattern-Defeating Quicksort Demo");
+    std::println("{:L} 件のデータを準備します...", ELEMENT_COUNT);
+
+    std::println("{:L} 件のデータをシャッフルします...", ELEMENT_COUNT);
+
+    // シードを固定した 0, 1, ..., n - 1 の並べ替えなので、実行ごとに同じ入力になる
+    auto v = Workload::generate<int>(ELEMENT_COUNT, {.distribution = Workload::Distribution::Shuffled});
+    auto expected = v;
+
+    std::println("{:L} 件のデータをソートします...", ELEMENT_COUNT);
+
+    auto start = std::chrono::steady_clock::now();
+    auto loopCount = measure_allocations("pdq_sort", [&] { return pdq_sort(v.begin(), v.end(), std::less<>()); });
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> pdq_elapsed = end - start;
+
+    std::println("{:L} 件のデータのソートが完了しました。", ELEMENT_COUNT);
+    std::println("ループ回数: {:L}", loopCount);
+
+    start = std::chrono::steady_clock::now();
+    std::sort(expected.begin(), expected.end());
+    end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> std_elapsed = end - start;
+
+    std::println("pdq_sort : {:.1f} ms", pdq_elapsed.count());
+    std::println("std::sort: {:.1f} ms", std_elapsed.count());
+    std::println("結果の一致: {}", v == expected ? "OK" : "NG");
+}
+
+REGISTER_DEMO(pdq_sort, pdq_sort_demo);
+REGISTER_IN_PLACE_BENCHMARK(pdq_sort, [](auto first, auto last) { pdq_sort(first, last); });
+// 比較用
+REGISTER_IN_PLACE_BENCHMARK(std_sort, [](auto first, auto last) { std::sort(first, last); });
@@ -0,0 +1,55 @@
+﻿#include "sort/radix_sort.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <string>
+#include <vector>
+#include "sort/pdq_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto ELEMENT_COUNT = 10'000'000;
+
+static void radix_sort_demo([[maybe_unused]] const std::vector<std::string>& args) {
+    std::println("Radix Sort Demo");
+    std::println("{:L} 件の uint32_t を準備します...", ELEMENT_COUNT);
+
+    const auto input = Workload::generate<uint32_t>(ELEMENT_COUNT);
+
+    // 作業領域は呼び出し側で用意する
+    std::vector<uint32_t> scratch(ELEMENT_COUNT);
+
+    auto measure = [&](const char* name, auto sort) {
+        auto v = input;
+        auto start = std::chrono::steady_clock::now();
+        measure_allocations(name, [&] { sort(v); });
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        std::println("{:<14}: {:>8.1f} ms {}", name, elapsed.count(), std::ranges::is_sorted(v) ? "OK" : "NG");
+    };
+
+    std::println("{:L} 件のデータをソートします...", ELEMENT_COUNT);
+    measure("radix_sort", [&](auto& v) { radix_sort(v.begin(), v.end(), scratch.begin()); });
+    measure("msd_radix_sort", [](auto& v) { msd_radix_sort(v.begin(), v.end()); });
+    measure("pdq_sort", [](auto& v) { pdq_sort(v.begin(), v.end()); });
+    measure("std::sort", [](auto& v) { std::sort(v.begin(), v.end()); });
+}
+
+REGISTER_DEMO(radix_sort, radix_sort_demo);
+REGISTER_BENCHMARK(radix_sort, [](auto first, auto last) {
+    // 作業領域の確保を計測に含めないよう、ウォームアップで確保したものを使い回す
+    using T = std::iter_value_t<decltype(first)>;
+    thread_local std::vector<T> scratch;
+    scratch.resize(static_cast<size_t>(last - first));
+    if constexpr (RadixKey<T>) {
+        radix_sort(first, last, scratch.begin());
+    } else {
+        // 計測用の Counted<int> は値を射影してキーにする
+        radix_sort(first, last, scratch.begin(), &T::value);
+    }
+});
@@ -0,0 +1,71 @@
+﻿#include "sort/schwartzian_sort.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+#include "sort/pdq_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto ELEMENT_COUNT = 1'000'000;
+
+namespace {
+
+struct Entry {
+    std::string name;
+    std::array<uint64_t, 6> payload;
+};
+
+// 計算の重いキー: 名前の FNV-1a ハッシュ
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (auto c : text) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+}  // namespace
+
+static void schwartzian_sort_demo([[maybe_unused]] const std::vector<std::string>& args) {
+    std::println("Schwartzian Sort Demo");
+    std::println("{:L} 件のレコードを準備します...", ELEMENT_COUNT);
+
+    std::mt19937 engine(Workload::DEFAULT_SEED);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<Entry> input(ELEMENT_COUNT);
+    for (auto& entry : input) {
+        entry.name.resize(32);
+        std::ranges::generate(entry.name, [&] { return static_cast<char>(letter(engine)); });
+    }
+
+    auto measure = [&](const char* name, auto sort) {
+        auto v = input;
+        size_t calls = 0;
+        auto key = [&](const Entry& entry) {
+            ++calls;
+            return fnv1a(entry.name);
+        };
+        auto start = std::chrono::steady_clock::now();
+        measure_allocations(name, [&] { sort(v, key); });
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        auto sorted = std::ranges::is_sorted(v, {}, [](const Entry& entry) { return fnv1a(entry.name); });
+        std::println("{:<16}: {:>8.1f} ms キー計算 {:>12L} 回 {}", name, elapsed.count(), calls, sorted ? "OK" : "NG");
+    };
+
+    std::println("名前のハッシュをキーにしてソートします...");
+    measure("pdq_sort + 射影", [](auto& v, auto key) { pdq_sort(v.begin(), v.end(), std::less<>(), key); });
+    measure("schwartzian_sort", [](auto& v, auto key) { schwartzian_sort(v.begin(), v.end(), std::less<>(), key); });
+}
+
+REGISTER_DEMO(schwartzian_sort, schwartzian_sort_demo);
+REGISTER_BENCHMARK(schwartzian_sort, [](auto first, auto last) { schwartzian_sort(first, last); });
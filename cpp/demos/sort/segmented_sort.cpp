@@ -0,0 +1,77 @@
+﻿#include "sort/segmented_sort.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+#include "concurrency/work_stealing_pool.hpp"
+#include "sort/bubble_sort.hpp"
+#include "sort/pdq_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+using AlgorithmSamples::Concurrency::WorkStealingPool;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto DEFAULT_SEGMENT_COUNT = 2'000'000;
+constexpr auto DEFAULT_MAX_SEGMENT_SIZE = 32;
+
+// args[0] でセグメント数、args[1] でセグメントの最大要素数、args[2] でスレッド数を指定できる
+static void segmented_sort_demo(const std::vector<std::string>& args) {
+    const size_t segment_count = args.empty() ? DEFAULT_SEGMENT_COUNT : std::stoul(args[0]);
+    const uint32_t max_segment_size = args.size() < 2 ? DEFAULT_MAX_SEGMENT_SIZE : std::stoul(args[1]);
+    const size_t thread_count = args.size() < 3 ? WorkStealingPool::default_thread_count() : std::stoul(args[2]);
+
+    std::println("Segmented Sort Demo");
+    std::mt19937 engine(Workload::DEFAULT_SEED);
+
+    auto run = [&](const char* distribution, auto next_size) {
+        std::vector<uint32_t> offsets = {0};
+        offsets.reserve(segment_count + 1);
+        for (size_t i = 0; i < segment_count; ++i) {
+            offsets.push_back(offsets.back() + next_size());
+        }
+        std::vector<int32_t> input(offsets.back());
+        std::ranges::generate(input, [&] { return static_cast<int32_t>(engine()); });
+        std::println("{}: {:L} セグメント / {:L} 要素", distribution, segment_count, input.size());
+
+        std::vector<int32_t> expected;
+        std::vector<int32_t> data;
+        auto measure = [&](const char* name, auto sort) {
+            data = input;
+            const auto start = std::chrono::steady_clock::now();
+            sort();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (expected.empty()) {
+                expected = data;
+            }
+            std::println("  {:<28}: {:>8.1f} ms {:>12.3f} M セグメント/秒 {}", name, elapsed.count() * 1e3,
+                         static_cast<double>(segment_count) / elapsed.count() / 1e6, data == expected ? "OK" : "NG");
+        };
+        auto per_segment = [&](auto sort) {
+            return [&, sort] {
+                for (size_t i = 0; i < segment_count; ++i) {
+                    sort(data.begin() + offsets[i], data.begin() + offsets[i + 1]);
+                }
+            };
+        };
+
+        measure("pdq_sort (セグメントごと)", per_segment([](auto first, auto last) { pdq_sort(first, last); }));
+        measure("std::sort (セグメントごと)", per_segment([](auto first, auto last) { std::sort(first, last); }));
+        measure("bubble_sort (セグメントごと)",
+                per_segment([](auto first, auto last) { bubble_sort(first, last); }));
+        measure("segmented_sort", [&] { segmented_sort(std::span(data), std::span(offsets)); });
+        WorkStealingPool pool(thread_count);
+        measure("segmented_sort (並列)",
+                [&] { segmented_sort(std::span(data), std::span(offsets), std::less<>(), std::identity(), pool); });
+    };
+
+    run("長さがばらばら", [&] { return engine() % (max_segment_size + 1); });
+    run("長さ 8 で一定", [] { return 8; });
+}
+
+REGISTER_DEMO(segmented_sort, segmented_sort_demo);
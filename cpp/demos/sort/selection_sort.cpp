@@ -1,38 +1,68 @@
-#include "sort/selection_sort.hpp"
+﻿#include "sort/selection_sort.hpp"
+#include "benchmark.hpp"
 #include "demo_registry.hpp"
 #include <algorithm>
-#include <numeric>
+#include <chrono>
+#include <format>
 #include <print>
-#include <random>
 #include <string>
 #include <vector>
+#include "sort/trace.hpp"
+#include "workload/workload.hpp"
 
 using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
 
 constexpr auto ELEMENT_COUNT = 1'000;
+// 最小値の走査のしかたで速さを比べる要素数
+constexpr size_t SCAN_COMPARISON_SIZES[] = {ELEMENT_COUNT, 100'000};
+
+// 汎用の走査 (比較関数がラムダ) と、分岐なし・SIMD の走査 (std::less<>)、両端の選択ソートを比べる
+static void compare_scans() {
+    std::println("最小値の走査のしかたで速さを比べます...");
+    for (auto size : SCAN_COMPARISON_SIZES) {
+        const auto input = Workload::generate<int>(size);
+        auto measure = [&](const char* name, auto sort) {
+            auto v = input;
+            const auto label = std::format("{} n={}", name, size);
+            TraceSpan span(label);
+            auto start = std::chrono::steady_clock::now();
+            measure_allocations(label, [&] { sort(v); });
+            auto end = std::chrono::steady_clock::now();
+            std::chrono::duration<double, std::milli> elapsed = end - start;
+            std::println("{:>9L} 件 {:<26}: {:>10.1f} ms {}", size, name, elapsed.count(),
+                         std::ranges::is_sorted(v) ? "OK" : "NG");
+        };
+        measure("selection_sort (汎用)",
+                [](auto& v) { selection_sort(v.begin(), v.end(), [](int a, int b) { return a < b; }); });
+        measure("selection_sort", [](auto& v) { selection_sort(v.begin(), v.end()); });
+        measure("double_selection_sort", [](auto& v) { double_selection_sort(v.begin(), v.end()); });
+    }
+}
 
 static void selection_sort_demo([[maybe_unused]] const std::vector<std::string>& args) {
     std::println("Selection Sort Demo");
     std::println("{:L} 件のデータを準備します...", ELEMENT_COUNT);
 
-    std::vector<int> v(ELEMENT_COUNT);
-    std::iota(v.begin(), v.end(), 1);
-
     std::println("{:L} 件のデータをシャッフルします...", ELEMENT_COUNT);
 
-    std::shuffle(v.begin(), v.end(), std::mt19937(std::random_device()()));
+    // シードを固定した 0, 1, ..., n - 1 の並べ替えなので、実行ごとに同じ入力になる
+    auto v = Workload::generate<int>(ELEMENT_COUNT, {.distribution = Workload::Distribution::Shuffled});
 
     std::println("{:L} 件のデータをソートします...", ELEMENT_COUNT);
 
-    auto loopCount = selection_sort(v.begin(), v.end(), std::less<>());
+    auto loopCount =
+        measure_allocations("selection_sort", [&] { return selection_sort(v.begin(), v.end(), std::less<>()); });
 
     std::println("{:L} 件のデータのソートが完了しました。", ELEMENT_COUNT);
     std::println("ループ回数: {:L}", loopCount);
 
-    for (auto n : v) {
-        std::print("{} ", n);
-    }
-    std::println();
+    print_sorted_result(v);
+
+    compare_scans();
 }
 
 REGISTER_DEMO(selection_sort, selection_sort_demo);
+REGISTER_IN_PLACE_BENCHMARK(selection_sort, [](auto first, auto last) { selection_sort(first, last); });
+REGISTER_IN_PLACE_BENCHMARK(double_selection_sort,
+                            [](auto first, auto last) { double_selection_sort(first, last); });
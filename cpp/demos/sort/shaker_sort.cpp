@@ -1,13 +1,14 @@
-#include "sort/shaker_sort.hpp"
+﻿#include "sort/shaker_sort.hpp"
+#include "benchmark.hpp"
 #include "demo_registry.hpp"
 #include <algorithm>
-#include <numeric>
 #include <print>
-#include <random>
 #include <string>
 #include <vector>
+#include "workload/workload.hpp"
 
 using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
 
 constexpr auto ELEMENT_COUNT = 1'000;
 
@@ -15,24 +16,39 @@ static void shaker_sort_demo([[maybe_unused]] const std::vector<std::string>& ar
     std::println("Shaker Sort Demo");
     std::println("{:L} 件のデータを準備します...", ELEMENT_COUNT);
 
-    std::vector<int> v(ELEMENT_COUNT);
-    std::iota(v.begin(), v.end(), 1);
-
     std::println("{:L} 件のデータをシャッフルします...", ELEMENT_COUNT);
 
-    std::shuffle(v.begin(), v.end(), std::mt19937(std::random_device()()));
+    // シードを固定した 0, 1, ..., n - 1 の並べ替えなので、実行ごとに同じ入力になる
+    auto v = Workload::generate<int>(ELEMENT_COUNT, {.distribution = Workload::Distribution::Shuffled});
 
     std::println("{:L} 件のデータをソートします...", ELEMENT_COUNT);
 
-    auto loopCount = shaker_sort(v.begin(), v.end(), std::less<>());
+    auto shuffled = v;
+    auto loopCount = measure_allocations("shaker_sort", [&] { return shaker_sort(v.begin(), v.end(), std::less<>()); });
 
     std::println("{:L} 件のデータのソートが完了しました。", ELEMENT_COUNT);
     std::println("ループ回数: {:L}", loopCount);
 
-    for (auto n : v) {
-        std::print("{} ", n);
-    }
+    print_sorted_result(v);
+
+    // 早期終了・範囲の縮小を行う適応型と比べる
+    auto report = [](const char* label, std::vector<int> data) {
+        auto classic = data;
+        auto classicCount = shaker_sort(classic.begin(), classic.end());
+        auto adaptive = adaptive_shaker_sort(data.begin(), data.end());
+        std::println("{}: 通常 {:L} 回 / 適応型 {:L} 回 ({:L} パス)", label, classicCount, adaptive.loopCount,
+                     adaptive.passCount);
+    };
     std::println();
+    report("シャッフル", shuffled);
+    report("ソート済み", v);
+    auto appended = v;
+    std::rotate(appended.begin() + 10, appended.begin() + 11, appended.end());
+    std::rotate(appended.begin() + 500, appended.begin() + 501, appended.end());
+    report("末尾に 2 件追加", appended);
 }
 
 REGISTER_DEMO(shaker_sort, shaker_sort_demo);
+REGISTER_IN_PLACE_BENCHMARK(shaker_sort, [](auto first, auto last) { shaker_sort(first, last); });
+REGISTER_IN_PLACE_BENCHMARK(adaptive_shaker_sort,
+                            [](auto first, auto last) { adaptive_shaker_sort(first, last); });
@@ -0,0 +1,115 @@
+﻿#include "sort/sorted_vector.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <print>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "sort/pdq_sort.hpp"
+#include "sort/tim_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto DEFAULT_INITIAL_COUNT = 100'000;
+constexpr auto DEFAULT_BATCH_SIZE = 100;
+constexpr auto DEFAULT_BATCH_COUNT = 1'000;
+// ベンチマークで入力を何回に分けて挿入するか
+constexpr std::ptrdiff_t BENCHMARK_BATCHES = 100;
+
+namespace {
+// first から batch 件ずつ sorted に挿入し、毎回順序付きで読む (flush する)
+template <typename Iterator>
+void insert_in_batches(Iterator first, Iterator last) {
+    SortedVector<std::iter_value_t<Iterator>> sorted;
+    const auto batch = std::max<std::ptrdiff_t>((last - first) / BENCHMARK_BATCHES, 1);
+    for (auto it = first; it != last;) {
+        auto next = it + std::min(batch, last - it);
+        sorted.insert(it, next);
+        sorted.flush();
+        it = next;
+    }
+    std::ranges::move(sorted.extract(), first);
+}
+
+// 同じ分け方で、毎回全体を pdq_sort し直す
+template <typename Iterator>
+void resort_in_batches(Iterator first, Iterator last) {
+    const auto batch = std::max<std::ptrdiff_t>((last - first) / BENCHMARK_BATCHES, 1);
+    for (auto it = first; it != last;) {
+        it += std::min(batch, last - it);
+        pdq_sort(first, it);
+    }
+}
+}  // namespace
+
+// args[0] で初期の要素数、args[1] でバッチの件数、args[2] でバッチの数を指定できる
+static void sorted_vector_demo(const std::vector<std::string>& args) {
+    const size_t initial_count = args.empty() ? DEFAULT_INITIAL_COUNT : std::stoul(args[0]);
+    const size_t batch_size = args.size() < 2 ? DEFAULT_BATCH_SIZE : std::stoul(args[1]);
+    const size_t batch_count = args.size() < 3 ? DEFAULT_BATCH_COUNT : std::stoul(args[2]);
+
+    std::println("Sorted Vector Demo");
+    std::println("{:L} 件の状態から {:L} 件ずつ {:L} 回追加し、毎回ソート済みの順に読みます", initial_count,
+                 batch_size, batch_count);
+
+    std::mt19937_64 engine(Workload::DEFAULT_SEED);
+    auto run = [&](const char* distribution, auto next_value) {
+        std::vector<uint64_t> initial(initial_count);
+        std::ranges::generate(initial, next_value);
+        std::ranges::sort(initial);
+        std::vector<uint64_t> batches(batch_size * batch_count);
+        std::ranges::generate(batches, next_value);
+
+        std::println("{}:", distribution);
+        uint64_t checksum = 0;
+        auto measure = [&](const char* name, auto&& insert_batch, auto&& read_first) {
+            const auto start = std::chrono::steady_clock::now();
+            uint64_t sum = 0;
+            for (size_t b = 0; b < batch_count; ++b) {
+                insert_batch(batches.begin() + static_cast<std::ptrdiff_t>(b * batch_size),
+                             batches.begin() + static_cast<std::ptrdiff_t>((b + 1) * batch_size));
+                sum += read_first();
+            }
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            const auto per_insert = elapsed.count() / static_cast<double>(batches.size());
+            std::println("  {:<24}: {:>12.1f} ns / 挿入 {}", name, per_insert,
+                         checksum == 0 || checksum == sum ? "OK" : "NG");
+            checksum = sum;
+        };
+
+        SortedVector<uint64_t> sorted(initial.begin(), initial.end());
+        measure("SortedVector", [&](auto first, auto last) { sorted.insert(first, last); },
+                [&] { return sorted.front(); });
+
+        auto resort = [&](const char* name, auto sort) {
+            auto v = initial;
+            measure(name, [&](auto first, auto last) { v.insert(v.end(), first, last); },
+                    [&] {
+                        sort(v);
+                        return v.front();
+                    });
+        };
+        resort("追加 + pdq_sort", [](auto& v) { pdq_sort(v.begin(), v.end()); });
+        resort("追加 + tim_sort", [](auto& v) { tim_sort(v.begin(), v.end()); });
+
+        std::multiset<uint64_t> tree(initial.begin(), initial.end());
+        measure("std::multiset", [&](auto first, auto last) { tree.insert(first, last); },
+                [&] { return *tree.begin(); });
+    };
+
+    run("ランダムな値", [&] { return engine(); });
+    // 時刻のように増えていく値に、少しだけ遅れて届くものが混ざる
+    uint64_t clock = 0;
+    run("ほぼ昇順に届く値", [&] { return (clock += 10) - engine() % 50; });
+}
+
+REGISTER_DEMO(sorted_vector, sorted_vector_demo);
+REGISTER_BENCHMARK(sorted_vector, [](auto first, auto last) { insert_in_batches(first, last); });
+REGISTER_BENCHMARK(pdq_sort_per_batch, [](auto first, auto last) { resort_in_batches(first, last); });
@@ -0,0 +1,87 @@
+﻿#include "sort/string_sort.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sort/pdq_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto DEFAULT_LINE_COUNT = 10'000'000;
+
+namespace {
+
+// ホスト名・パス・番号からなる URL 風の行を count 行つなげたコーパスを作る。
+// 同じホストやパスを共有する行が多く、8 バイトを超える共通接頭辞が頻繁に現れる
+std::string make_corpus(size_t count, uint32_t seed) {
+    static constexpr std::array<std::string_view, 8> WORDS = {"api", "static", "images", "users",
+                                                               "search", "v1", "v2", "download"};
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<int> host(0, 999);
+    std::uniform_int_distribution<size_t> word(0, WORDS.size() - 1);
+    std::uniform_int_distribution<int> depth(1, 3);
+    std::uniform_int_distribution<uint32_t> id;
+
+    std::string corpus;
+    corpus.reserve(count * 48);
+    for (size_t i = 0; i < count; ++i) {
+        corpus += "https://host";
+        corpus += std::to_string(host(engine));
+        corpus += ".example.com";
+        for (auto d = depth(engine); d > 0; --d) {
+            corpus += '/';
+            corpus += WORDS[word(engine)];
+        }
+        corpus += '/';
+        corpus += std::to_string(id(engine));
+        corpus += '\n';
+    }
+    return corpus;
+}
+
+std::vector<std::string_view> split_lines(std::string_view corpus) {
+    std::vector<std::string_view> lines;
+    while (!corpus.empty()) {
+        const auto newline = corpus.find('\n');
+        lines.push_back(corpus.substr(0, newline));
+        corpus.remove_prefix(newline == std::string_view::npos ? corpus.size() : newline + 1);
+    }
+    return lines;
+}
+
+}  // namespace
+
+// args[0] で行数を指定できる
+static void string_sort_demo(const std::vector<std::string>& args) {
+    const size_t line_count = args.empty() ? DEFAULT_LINE_COUNT : std::stoul(args[0]);
+
+    std::println("String Sort Demo");
+    std::println("{:L} 行のコーパスを準備します...", line_count);
+    const auto corpus = make_corpus(line_count, Workload::DEFAULT_SEED);
+    const auto lines = split_lines(corpus);
+    const auto megabytes = static_cast<double>(corpus.size()) / (1024 * 1024);
+    std::println("{:.1f} MB, 例: {}", megabytes, lines.empty() ? "" : lines.front());
+
+    auto measure = [&](const char* name, auto sort) {
+        auto v = lines;
+        auto start = std::chrono::steady_clock::now();
+        measure_allocations(name, [&] { sort(v); });
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed = end - start;
+        std::println("{:<12}: {:>8.1f} ms {:>8.1f} MB/s {}", name, elapsed.count() * 1000,
+                     megabytes / elapsed.count(), std::ranges::is_sorted(v) ? "OK" : "NG");
+    };
+
+    measure("string_sort", [](auto& v) { string_sort(v.begin(), v.end()); });
+    measure("pdq_sort", [](auto& v) { pdq_sort(v.begin(), v.end()); });
+    measure("std::sort", [](auto& v) { std::sort(v.begin(), v.end()); });
+}
+
+REGISTER_DEMO(string_sort, string_sort_demo);
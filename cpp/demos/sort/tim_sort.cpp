@@ -0,0 +1,82 @@
+﻿#include "sort/tim_sort.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory_resource>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto ELEMENT_COUNT = 10'000'000;
+
+struct Record {
+    int key;
+    int order;
+};
+
+static void tim_sort_demo([[maybe_unused]] const std::vector<std::string>& args) {
+    std::println("Tim Sort Demo");
+    std::println("{:L} 件のレコードを準備します...", ELEMENT_COUNT);
+
+    std::vector<Record> random(ELEMENT_COUNT);
+    std::mt19937 engine(Workload::DEFAULT_SEED);
+    for (int i = 0; i < ELEMENT_COUNT; ++i) {
+        random[i] = {static_cast<int>(engine() % 1'000), i};
+    }
+    // 整列済みの列に 1% の乱れを加えたもの
+    auto nearly_sorted = random;
+    std::ranges::stable_sort(nearly_sorted, {}, &Record::key);
+    for (int i = 0; i < ELEMENT_COUNT / 100; ++i) {
+        nearly_sorted[engine() % ELEMENT_COUNT].key = static_cast<int>(engine() % 1'000);
+    }
+
+    // 作業領域を一度だけ用意し、ソートのたびに使い回す
+    std::vector<std::byte> arena(tim_sort_scratch_size<Record>(ELEMENT_COUNT));
+    std::println("作業領域: {:L} バイト", arena.size());
+
+    auto by_key = [](const Record& a, const Record& b) { return a.key < b.key; };
+    auto measure = [&](const char* name, const std::vector<Record>& input, auto sort) {
+        auto v = input;
+        auto start = std::chrono::steady_clock::now();
+        measure_allocations(name, [&] { sort(v); });
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        // 安定ソートなら、等しいキーの中では元の位置の順に並ぶ結果は一通りに決まる
+        auto expected = input;
+        std::ranges::stable_sort(expected, by_key);
+        bool stable = std::ranges::equal(v, expected, [](const Record& a, const Record& b) {
+            return a.key == b.key && a.order == b.order;
+        });
+        std::println("{:<18}: {:>8.1f} ms {}", name, elapsed.count(), stable ? "OK (安定)" : "NG");
+    };
+    auto tim = [&](auto& v) {
+        std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+        tim_sort(v.begin(), v.end(), std::less<>(), &Record::key, &resource);
+    };
+    auto stable = [&](auto& v) { std::stable_sort(v.begin(), v.end(), by_key); };
+
+    std::println("ランダムなキーでソートします...");
+    measure("tim_sort", random, tim);
+    measure("std::stable_sort", random, stable);
+    std::println("ほぼ整列済みのキーでソートします...");
+    measure("tim_sort", nearly_sorted, tim);
+    measure("std::stable_sort", nearly_sorted, stable);
+}
+
+REGISTER_DEMO(tim_sort, tim_sort_demo);
+REGISTER_BENCHMARK(tim_sort, [](auto first, auto last) {
+    // 作業領域の確保を計測に含めないよう、ウォームアップで確保したものを使い回す
+    using T = std::iter_value_t<decltype(first)>;
+    thread_local std::vector<std::byte> arena;
+    arena.resize(tim_sort_scratch_size<T>(static_cast<size_t>(last - first)));
+    std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+    tim_sort(first, last, std::less<>(), std::identity(), &resource);
+});
+REGISTER_BENCHMARK(std_stable_sort, [](auto first, auto last) { std::stable_sort(first, last); });
@@ -0,0 +1,62 @@
+﻿#include "sort/top_k.hpp"
+#include "demo_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <string>
+#include <vector>
+#include "sort/intro_select.hpp"
+#include "sort/pdq_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+constexpr auto DEFAULT_ELEMENT_COUNT = 100'000'000;
+constexpr auto DEFAULT_K = 100;
+
+// args[0] で要素数、args[1] で k を指定できる
+static void top_k_demo(const std::vector<std::string>& args) {
+    const size_t element_count = args.empty() ? DEFAULT_ELEMENT_COUNT : std::stoul(args[0]);
+    const size_t k = std::min<size_t>(args.size() < 2 ? DEFAULT_K : std::stoul(args[1]), element_count);
+
+    std::println("Top-k / Selection Demo");
+    std::println("{:L} 件の uint32_t を準備します...", element_count);
+
+    const auto input = Workload::generate<uint32_t>(element_count);
+
+    auto expected = input;
+    std::ranges::sort(expected);
+
+    std::vector<uint32_t> v(element_count);
+    auto measure = [&](const char* name, auto run, auto check) {
+        std::ranges::copy(input, v.begin());
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        std::println("{:<18}: {:>9.1f} ms {}", name, elapsed.count(), check() ? "OK" : "NG");
+    };
+
+    const auto middle = static_cast<std::ptrdiff_t>(k);
+    auto top_k_ok = [&] { return std::equal(v.begin(), v.begin() + middle, expected.begin()); };
+    std::println("小さい順に {:L} 件を取り出します...", k);
+    measure("top_k_sort", [&] { top_k_sort(v.begin(), v.begin() + middle, v.end()); }, top_k_ok);
+    measure("std::partial_sort", [&] { std::partial_sort(v.begin(), v.begin() + middle, v.end()); }, top_k_ok);
+    std::vector<uint32_t> streamed;
+    measure("top_k (ストリーム)", [&] { streamed = top_k(v.begin(), v.end(), k); },
+            [&] { return std::equal(streamed.begin(), streamed.end(), expected.begin()); });
+    measure("pdq_sort (全体)", [&] { pdq_sort(v.begin(), v.end()); }, top_k_ok);
+
+    if (element_count == 0) {
+        return;
+    }
+    const auto median = static_cast<std::ptrdiff_t>(element_count / 2);
+    auto median_ok = [&] { return v[static_cast<size_t>(median)] == expected[static_cast<size_t>(median)]; };
+    std::println("中央値を選択します...");
+    measure("intro_select", [&] { intro_select(v.begin(), v.begin() + median, v.end()); }, median_ok);
+    measure("std::nth_element", [&] { std::nth_element(v.begin(), v.begin() + median, v.end()); }, median_ok);
+}
+
+REGISTER_DEMO(top_k, top_k_demo);
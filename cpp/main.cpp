@@ -1,16 +1,356 @@
-﻿#include "demo_registry.hpp"
+﻿#include "allocation_tracker.hpp"
+#include "benchmark.hpp"
+#include "demo_registry.hpp"
+#include "mapped_file.hpp"
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <format>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <limits>
 #include <locale>
+#include <optional>
+#include <print>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "sort/progress.hpp"
+#include "sort/trace.hpp"
+
+namespace Benchmark = AlgorithmSamples::Benchmark;
+namespace Sort = AlgorithmSamples::Sort;
 
 namespace {
 static std::vector<std::pair<std::string, DemoFn>> g_demos;
+DemoOutputOptions g_demo_output_options;
+// --memory: デモの中で measure_allocations が集計した区間の数と合計
+size_t g_memory_sections = 0;
+Benchmark::AllocationStats g_memory_total;
+
+std::vector<std::string> split(const std::string& s, char delimiter) {
+    std::vector<std::string> items;
+    size_t pos = 0;
+    while (pos <= s.size()) {
+        auto next = s.find(delimiter, pos);
+        if (next == std::string::npos) {
+            next = s.size();
+        }
+        items.push_back(s.substr(pos, next - pos));
+        pos = next + 1;
+    }
+    return items;
+}
+
+// --bench 用のオプションを解析する。解析できた場合は true を返し、i を値の位置まで進める
+bool parse_bench_option(const std::vector<std::string>& args, size_t& i, Benchmark::Options& options,
+                        std::string& format, std::string& output) {
+    const auto& flag = args[i];
+    if (flag != "--warmup" && flag != "--iterations" && flag != "--sizes" && flag != "--dist" && flag != "--seed" &&
+        flag != "--format" && flag != "--output") {
+        return false;
+    }
+    if (i + 1 >= args.size()) {
+        throw std::invalid_argument(flag + " requires a value");
+    }
+    const auto& value = args[++i];
+
+    if (flag == "--warmup") {
+        options.warmup = std::stoul(value);
+    } else if (flag == "--iterations") {
+        options.iterations = std::stoul(value);
+    } else if (flag == "--sizes") {
+        options.sizes.clear();
+        for (const auto& size : split(value, ',')) {
+            options.sizes.push_back(std::stoul(size));
+        }
+    } else if (flag == "--dist") {
+        options.distributions.clear();
+        for (const auto& name : split(value, ',')) {
+            auto distribution = Benchmark::parse_distribution(name);
+            if (!distribution) {
+                throw std::invalid_argument("Unknown distribution: " + name);
+            }
+            options.distributions.push_back(*distribution);
+        }
+    } else if (flag == "--seed") {
+        options.seed = std::stoull(value);
+    } else if (flag == "--format") {
+        if (value != "text" && value != "csv" && value != "json") {
+            throw std::invalid_argument("Unknown format: " + value);
+        }
+        format = value;
+    } else {
+        output = value;
+    }
+    return true;
+}
+
+// --input / --binary-format を解析する。解析できた場合は true を返し、i を値の位置まで進める
+bool parse_file_option(const std::vector<std::string>& args, size_t& i, Benchmark::FileSortOptions& options) {
+    const auto& flag = args[i];
+    if (flag != "--input" && flag != "--binary-format") {
+        return false;
+    }
+    if (i + 1 >= args.size()) {
+        throw std::invalid_argument(flag + " requires a value");
+    }
+    const auto& value = args[++i];
+
+    if (flag == "--input") {
+        options.input = value;
+    } else {
+        auto format = Benchmark::parse_binary_format(value);
+        if (!format) {
+            throw std::invalid_argument("Unknown binary format: " + value);
+        }
+        options.format = *format;
+    }
+    return true;
+}
+
+// --progress / --progress-interval / --trace の指定
+struct TracingOptions {
+    bool progress = false;
+    std::chrono::milliseconds interval{1000};
+    std::string trace_output;
+
+    bool enabled() const { return progress || !trace_output.empty(); }
+};
+
+// --progress / --progress-interval / --trace を解析する。解析できた場合は true を返し、i を値の位置まで進める
+bool parse_tracing_option(const std::vector<std::string>& args, size_t& i, TracingOptions& options) {
+    const auto& flag = args[i];
+    if (flag == "--progress") {
+        options.progress = true;
+        return true;
+    }
+    if (flag != "--progress-interval" && flag != "--trace") {
+        return false;
+    }
+    if (i + 1 >= args.size()) {
+        throw std::invalid_argument(flag + " requires a value");
+    }
+    const auto& value = args[++i];
+
+    if (flag == "--progress-interval") {
+        const auto ms = std::stoul(value);
+        if (ms == 0) {
+            throw std::invalid_argument("--progress-interval must be positive");
+        }
+        options.progress = true;
+        options.interval = std::chrono::milliseconds(ms);
+    } else {
+        options.trace_output = value;
+    }
+    return true;
+}
+
+// fn を実行する間、パスに分けて進むソート (bubble_sort など) の進み具合を一定の間隔で標準エラーに表示し (--progress)、
+// デモ全体とパスごとの区間、進み具合のカウンタを Chrome の trace event 形式の JSON に書き出す (--trace)
+template <typename F>
+void run_traced(const std::string& name, const TracingOptions& options, F fn) {
+    if (!options.enabled()) {
+        fn();
+        return;
+    }
+
+    const bool tracing = !options.trace_output.empty();
+    Sort::TraceRecorder recorder;
+    std::optional<Sort::ScopedTrace> trace_scope;
+    if (tracing) {
+        trace_scope.emplace(recorder);
+    }
+    Sort::ProgressCounter counter;
+    Sort::ScopedProgress progress_scope(counter);
+    {
+        Sort::ProgressSampler sampler(counter, options.interval, [&](const Sort::ProgressSnapshot& s) {
+            if (options.progress) {
+                const auto percent = s.max_passes == 0 ? 100.0 : 100.0 * static_cast<double>(s.pass) / s.max_passes;
+                std::println(stderr, "[進捗] パス {:L} / {:L} ({:.1f}%)  未確定 [{:L}, {:L})  比較 {:L} 回", s.pass,
+                             s.max_passes, percent, s.range_begin, s.range_end, s.comparisons);
+            }
+            if (tracing) {
+                recorder.add_counter("progress", Sort::TraceRecorder::Clock::now(),
+                                     {{"pass", s.pass}, {"comparisons", s.comparisons}});
+            }
+        });
+        Sort::TraceSpan span(name);
+        fn();
+    }
+
+    if (tracing) {
+        std::ofstream file(options.trace_output);
+        if (!file) {
+            throw std::runtime_error("Cannot open trace output: " + options.trace_output);
+        }
+        recorder.write_json(file);
+    }
+}
+
+// 2 の累乗のバイト数を、割り切れる最大の単位で表す (4096 -> "4 KiB")
+std::string format_power_of_two_bytes(size_t bytes) {
+    constexpr const char* UNITS[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB"};
+    size_t unit = 0;
+    while (bytes >= 1024 && bytes % 1024 == 0 && unit + 1 < std::size(UNITS)) {
+        bytes /= 1024;
+        ++unit;
+    }
+    return std::format("{} {}", bytes, UNITS[unit]);
+}
+
+void print_allocation_stats(const std::string& label, const Benchmark::AllocationStats& stats) {
+    std::println("[メモリ] {}: 確保 {:L} 回 (合計 {:L} B, 1 回の最大 {:L} B)  最大使用量 {:L} B  解放 {:L} 回", label,
+                 stats.allocations, stats.allocated_bytes, stats.largest_allocation, stats.peak_bytes,
+                 stats.deallocations);
+    std::string histogram;
+    for (size_t k = 0; k < stats.size_histogram.size(); ++k) {
+        if (stats.size_histogram[k] != 0) {
+            histogram += std::format("{}≤{} ×{:L}", histogram.empty() ? "" : ", ",
+                                     format_power_of_two_bytes(Benchmark::AllocationStats::size_class_limit(k)),
+                                     stats.size_histogram[k]);
+        }
+    }
+    if (!histogram.empty()) {
+        std::println("         大きさの分布: {}", histogram);
+    }
+}
+
+// --memory で fn (デモ全体) を実行し、measure_allocations で集計した区間が複数あればその合計を表示する。
+// measure_allocations を使っていないデモでは、入力の準備を含めたデモ全体の確保を表示する
+template <typename F>
+void run_with_memory(const std::string& name, F fn) {
+    g_memory_sections = 0;
+    g_memory_total = {};
+    Benchmark::AllocationStats whole;
+    {
+        Benchmark::AllocationSection section;
+        fn();
+        whole = section.stats();
+    }
+    if (g_memory_sections == 0) {
+        print_allocation_stats(name + " (デモ全体、入力の準備を含む)", whole);
+    } else if (g_memory_sections > 1) {
+        print_allocation_stats(std::format("{} ({} 区間の合計、最大使用量は区間ごとの最大)", name, g_memory_sections),
+                               g_memory_total);
+    }
+}
+
+// in-place として登録されたソートを、分布と要素数を変えて実行し、ソートの呼び出し中にメモリを確保しないか確かめる。
+// 1 つでも確保したソートがあれば 1 を返す
+int check_in_place(const std::vector<std::pair<std::string, Benchmark::Target>>& targets,
+                   const Benchmark::Options& options) {
+    // O(n^2) のソートも含むので、端の場合 (空・1 要素・2 要素) と小さな入力だけを調べる
+    constexpr size_t SIZES[] = {0, 1, 2, 17, 1'000};
+    size_t failed = 0;
+    for (const auto& [name, target] : targets) {
+        bool allocated = false;
+        // allowed 回より多く確保していたら報告する
+        auto check = [&](std::string_view element, Benchmark::Distribution distribution, size_t size,
+                         size_t allowed, auto&& sort) {
+            Benchmark::AllocationStats stats;
+            {
+                Benchmark::AllocationSection section;
+                sort();
+                stats = section.stats();
+            }
+            if (stats.allocations > allowed) {
+                allocated = true;
+                std::println("NG {}: {} {:L} 要素 ({}) のソート中に {:L} 回 (合計 {:L} B) 確保しました", name,
+                             Benchmark::to_string(distribution), size, element, stats.allocations,
+                             stats.allocated_bytes);
+            }
+        };
+        for (const auto distribution : options.distributions) {
+            for (const auto size : SIZES) {
+                auto input = Benchmark::make_input(distribution, size, options.seed);
+                if (target.large) {
+                    std::vector<Benchmark::LargeElement> large(input.size());
+                    for (size_t i = 0; i < input.size(); ++i) {
+                        large[i].key = input[i];
+                    }
+                    check("LargeElement", distribution, size, Benchmark::LARGE_ELEMENT_ALLOCATIONS,
+                          [&] { target.large(large); });
+                }
+                check("int", distribution, size, 0, [&] { target.sort(input); });
+            }
+        }
+        if (allocated) {
+            ++failed;
+        } else {
+            std::println("OK {}", name);
+        }
+    }
+    std::println("in-place のソート {:L} 個のうち {:L} 個がメモリを確保しました。", targets.size(), failed);
+    return failed == 0 ? 0 : 1;
+}
+
+void write_bench_results(std::ostream& os, const std::string& format,
+                         const std::vector<Benchmark::Result>& results) {
+    if (format == "csv") {
+        Benchmark::write_csv(os, results);
+    } else if (format == "json") {
+        Benchmark::write_json(os, results);
+    } else {
+        Benchmark::write_text(os, results);
+    }
+}
+
+// id に対応するベンチマークを返す。1 つでも見つからない名前があれば空を返す
+std::vector<std::pair<std::string, Benchmark::Target>> list_bench_targets(const std::string& id) {
+    if (id == "all") {
+        return Benchmark::list_benchmarks();
+    }
+    std::vector<std::pair<std::string, Benchmark::Target>> targets;
+    for (const auto& name : split(id, ',')) {
+        auto target = Benchmark::find_benchmark(name);
+        if (!target.sort) {
+            return {};
+        }
+        targets.emplace_back(name, target);
+    }
+    return targets;
+}
+
+int run_benchmarks(const std::vector<std::pair<std::string, Benchmark::Target>>& targets,
+                   const Benchmark::Options& options, const std::string& format, const std::string& output) {
+    std::vector<Benchmark::Result> results;
+    for (const auto& [name, target] : targets) {
+        auto r = Benchmark::run(name, target, options);
+        results.insert(results.end(), r.begin(), r.end());
+    }
+
+    if (output.empty()) {
+        write_bench_results(std::cout, format, results);
+        return 0;
+    }
+    std::ofstream file(output);
+    if (!file) {
+        std::cerr << "Cannot open output file: " << output << "\n";
+        return 1;
+    }
+    write_bench_results(file, format, results);
+    return 0;
+}
+
+// --input のファイルを、デモに登録されたベンチマークのソートでソートする
+int run_file_sort(const std::string& name, const Benchmark::Target& target,
+                  const Benchmark::FileSortOptions& options, bool quiet) {
+    auto result = Benchmark::sort_file(target, options);
+    if (!quiet) {
+        std::cout << name << ": sorted " << result.size << " elements in " << result.seconds * 1e3 << " ms";
+        if (options.verify) {
+            std::cout << " (verified)";
+        }
+        if (!options.output.empty()) {
+            std::cout << " -> " << options.output.string();
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
 }  // namespace
 
 DemoRegistrar::DemoRegistrar(const std::string& name, DemoFn fn) { g_demos.emplace_back(name, fn); }
@@ -19,6 +359,43 @@ void register_demo(const std::string& name, DemoFn fn) { g_demos.emplace_back(na
 
 const std::vector<std::pair<std::string, DemoFn>>& list_demos() { return g_demos; }
 
+void set_demo_output_options(const DemoOutputOptions& options) { g_demo_output_options = options; }
+
+const DemoOutputOptions& demo_output_options() { return g_demo_output_options; }
+
+void report_allocations(const std::string& label, const Benchmark::AllocationStats& stats) {
+    print_allocation_stats(label, stats);
+    ++g_memory_sections;
+    g_memory_total.allocations += stats.allocations;
+    g_memory_total.deallocations += stats.deallocations;
+    g_memory_total.allocated_bytes += stats.allocated_bytes;
+    g_memory_total.peak_bytes = std::max(g_memory_total.peak_bytes, stats.peak_bytes);
+    g_memory_total.largest_allocation = std::max(g_memory_total.largest_allocation, stats.largest_allocation);
+    for (size_t k = 0; k < stats.size_histogram.size(); ++k) {
+        g_memory_total.size_histogram[k] += stats.size_histogram[k];
+    }
+}
+
+void print_sorted_result(std::span<const int> values) {
+    if (g_demo_output_options.verify) {
+        if (!std::ranges::is_sorted(values)) {
+            const auto position = std::ranges::is_sorted_until(values) - values.begin();
+            throw std::runtime_error("Result is not sorted at index " + std::to_string(position));
+        }
+        if (!g_demo_output_options.quiet) {
+            std::println("{:L} 件がソート済みであることを確認しました。", values.size());
+        }
+        return;
+    }
+    if (g_demo_output_options.quiet) {
+        return;
+    }
+    for (auto n : values) {
+        std::print("{} ", n);
+    }
+    std::println();
+}
+
 DemoFn find_demo(const std::string& name) {
     auto it = std::find_if(g_demos.begin(), g_demos.end(), [&](auto& p) { return p.first == name; });
     if (it == g_demos.end()) {
@@ -50,23 +427,132 @@ int main(int argc, char** argv) {
         std::vector<std::string> args(argv + 1, argv + argc);
 
         bool bench = false;
+        bool in_place_check = false;
+        Benchmark::Options bench_options;
+        std::string bench_format = "text";
+        // --bench の結果、または --input をソートした結果の出力先
+        std::string output;
+        Benchmark::FileSortOptions file_options;
+        DemoOutputOptions output_options;
+        TracingOptions tracing_options;
 
-        // parse minimal flags: --bench and --expect <file>
+        // parse minimal flags: --bench and its options
         std::vector<std::string> demo_args;
-        for (size_t i = 0; i < args.size(); ++i) {
-            if (args[i] == "--bench") {
-                bench = true;
-            } else {
-                demo_args.push_back(args[i]);
+        try {
+            for (size_t i = 0; i < args.size(); ++i) {
+                if (args[i] == "--bench") {
+                    bench = true;
+                } else if (args[i] == "--quiet") {
+                    output_options.quiet = true;
+                } else if (args[i] == "--verify") {
+                    output_options.verify = true;
+                } else if (args[i] == "--memory") {
+                    output_options.memory = true;
+                } else if (args[i] == "--check-in-place") {
+                    in_place_check = true;
+                } else if (!parse_bench_option(args, i, bench_options, bench_format, output) &&
+                           !parse_file_option(args, i, file_options) &&
+                           !parse_tracing_option(args, i, tracing_options)) {
+                    demo_args.push_back(args[i]);
+                }
             }
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid option: " << e.what() << "\n";
+            return 1;
         }
 
         if (demo_args.empty()) {
             std::cerr << "No demo specified\n";
             return 1;
         }
+        if (bench && !file_options.input.empty()) {
+            std::cerr << "--bench cannot be combined with --input\n";
+            return 1;
+        }
+        if (bench && tracing_options.enabled()) {
+            std::cerr << "--bench cannot be combined with --progress or --trace\n";
+            return 1;
+        }
+        if (output_options.memory && (bench || tracing_options.enabled())) {
+            // 計測や記録のための確保まで数えてしまうので、一緒には使えない
+            std::cerr << "--memory cannot be combined with --bench, --progress or --trace\n";
+            return 1;
+        }
+        if (in_place_check && (bench || !file_options.input.empty() || output_options.memory ||
+                               tracing_options.enabled())) {
+            std::cerr << "--check-in-place cannot be combined with other modes\n";
+            return 1;
+        }
+        file_options.output = output;
+        file_options.verify = output_options.verify;
+        set_demo_output_options(output_options);
 
         std::string id = demo_args[0];
+        if (in_place_check) {
+            // "all" なら in-place として登録されたソートをすべて、そうでなければカンマ区切りの名前のソートを調べる
+            auto targets = list_bench_targets(id);
+            if (targets.empty()) {
+                std::cerr << "No sort registered: " << id << "\n";
+                return 2;
+            }
+            auto not_in_place = [](const auto& target) { return !target.second.in_place; };
+            if (id == "all") {
+                std::erase_if(targets, not_in_place);
+            } else if (auto it = std::ranges::find_if(targets, not_in_place); it != targets.end()) {
+                std::cerr << "Not registered as in-place: " << it->first << "\n";
+                return 2;
+            }
+            try {
+                return check_in_place(targets, bench_options);
+            } catch (const std::exception& e) {
+                std::cerr << "In-place check failed: " << e.what() << "\n";
+                return 3;
+            }
+        }
+
+        if (bench) {
+            // "all" またはカンマ区切りのベンチマーク名 (例: pdq_sort,std_sort) をまとめて計測する
+            auto targets = list_bench_targets(id);
+            if (!targets.empty()) {
+                try {
+                    return run_benchmarks(targets, bench_options, bench_format, output);
+                } catch (const std::exception& e) {
+                    std::cerr << "Benchmark failed: " << e.what() << "\n";
+                    return 3;
+                }
+            }
+        }
+
+        if (!file_options.input.empty()) {
+            // --input では、デモ名ではなくベンチマークとして登録されたソート (std_sort なども含む) を使う
+            auto target = Benchmark::find_benchmark(id);
+            if (!target.sort) {
+                std::cerr << "No sort registered for --input: " << id << "\n";
+                std::cerr << "Available sorts: ";
+                const auto& benchmarks = Benchmark::list_benchmarks();
+                for (size_t i = 0; i < benchmarks.size(); ++i) {
+                    std::cerr << benchmarks[i].first << (i + 1 < benchmarks.size() ? ", " : "\n");
+                }
+                return 2;
+            }
+            if (output_options.memory) {
+                // ファイルの読み書きは含めず、ソートの呼び出しだけを計測する
+                target.sort = [id, sort = target.sort](std::span<int> data) {
+                    measure_allocations(id, [&] { sort(data); });
+                };
+            }
+            try {
+                int code = 0;
+                run_traced(id, tracing_options,
+                           [&] { code = run_file_sort(id, target, file_options, output_options.quiet); });
+                return code;
+            } catch (const std::exception& e) {
+                std::cerr << "File sort failed: " << e.what() << "\n";
+                return 3;
+            }
+        }
+
+        std::string name = id;
         DemoFn fn;
         try {
             size_t idx = std::stoul(id);
@@ -75,6 +561,7 @@ int main(int argc, char** argv) {
                 return 2;
             }
             fn = demos[idx].second;
+            name = demos[idx].first;
         } catch (const std::invalid_argument&) {
             fn = find_demo(id);  // 文字列として処理
         } catch (const std::out_of_range&) {
@@ -96,14 +583,20 @@ int main(int argc, char** argv) {
         }
 
         try {
-            if (bench) {
+            if (auto target = Benchmark::find_benchmark(name); bench && target.sort) {
+                return run_benchmarks({{name, target}}, bench_options, bench_format, output);
+            } else if (bench) {
+                // ベンチマークが登録されていないデモは全体の実行時間だけを測る
                 auto start = std::chrono::high_resolution_clock::now();
                 fn(std::vector<std::string>(demo_args.begin() + 1, demo_args.end()));
                 auto end = std::chrono::high_resolution_clock::now();
                 std::chrono::duration<double> dur = end - start;
                 std::cout << "Elapsed: " << dur.count() << " s\n";
+            } else if (output_options.memory) {
+                run_with_memory(name, [&] { fn(std::vector<std::string>(demo_args.begin() + 1, demo_args.end())); });
             } else {
-                fn(std::vector<std::string>(demo_args.begin() + 1, demo_args.end()));
+                run_traced(name, tracing_options,
+                           [&] { fn(std::vector<std::string>(demo_args.begin() + 1, demo_args.end())); });
             }
         } catch (const std::exception& e) {
             std::cerr << "Demo execution failed: " << e.what() << "\n";
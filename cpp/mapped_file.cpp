@@ -0,0 +1,198 @@
+﻿#include "mapped_file.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AlgorithmSamples::Benchmark {
+
+namespace {
+
+constexpr std::string_view BINARY_FORMAT_NAMES[] = {"raw", "length-prefixed"};
+
+using LengthPrefix = uint64_t;
+
+[[noreturn]] void throw_system_error(const std::string& what, const std::filesystem::path& path) {
+#ifdef _WIN32
+    const auto code = static_cast<int>(GetLastError());
+    throw std::system_error(code, std::system_category(), what + " " + path.string());
+#else
+    throw std::system_error(errno, std::generic_category(), what + " " + path.string());
+#endif
+}
+
+// マップしたファイルのうち int の列の部分を返す
+std::span<int> element_span(std::span<std::byte> bytes, BinaryFormat format, const std::filesystem::path& path) {
+    if (format == BinaryFormat::LengthPrefixed) {
+        if (bytes.size() < sizeof(LengthPrefix)) {
+            throw std::runtime_error(std::format("{}: missing length prefix", path.string()));
+        }
+        LengthPrefix count = 0;
+        std::memcpy(&count, bytes.data(), sizeof(count));
+        bytes = bytes.subspan(sizeof(LengthPrefix));
+        if (count != bytes.size() / sizeof(int) || bytes.size() % sizeof(int) != 0) {
+            throw std::runtime_error(std::format("{}: length prefix {} does not match the file size {}",
+                                                 path.string(), count, bytes.size() + sizeof(LengthPrefix)));
+        }
+    } else if (bytes.size() % sizeof(int) != 0) {
+        throw std::runtime_error(
+            std::format("{}: file size {} is not a multiple of {}", path.string(), bytes.size(), sizeof(int)));
+    }
+    // マップした領域はページ境界から始まり、長さの接頭辞は 8 バイトなので int の境界に揃っている
+    return {reinterpret_cast<int*>(bytes.data()), bytes.size() / sizeof(int)};
+}
+
+}  // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path, Mode mode) {
+    const bool write = mode == Mode::ReadWrite;
+    file_ = CreateFileW(path.c_str(), write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        throw_system_error("open", path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size)) {
+        CloseHandle(file_);
+        throw_system_error("stat", path);
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) {
+        return;
+    }
+    mapping_ = CreateFileMappingW(file_, nullptr, write ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping_ == nullptr) {
+        CloseHandle(file_);
+        throw_system_error("CreateFileMapping", path);
+    }
+    data_ = static_cast<std::byte*>(MapViewOfFile(mapping_, write ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, 0));
+    if (data_ == nullptr) {
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+        throw_system_error("MapViewOfFile", path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    if (file_ != nullptr) {
+        CloseHandle(file_);
+    }
+}
+
+void MappedFile::flush() {
+    if (data_ != nullptr) {
+        FlushViewOfFile(data_, 0);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path, Mode mode) {
+    const bool write = mode == Mode::ReadWrite;
+    fd_ = ::open(path.c_str(), write ? O_RDWR : O_RDONLY);
+    if (fd_ == -1) {
+        throw_system_error("open", path);
+    }
+    struct stat status {};
+    if (::fstat(fd_, &status) == -1) {
+        ::close(fd_);
+        throw_system_error("stat", path);
+    }
+    size_ = static_cast<size_t>(status.st_size);
+    if (size_ == 0) {
+        return;
+    }
+    void* data = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, write ? MAP_SHARED : MAP_PRIVATE, fd_, 0);
+    if (data == MAP_FAILED) {
+        ::close(fd_);
+        throw_system_error("mmap", path);
+    }
+    data_ = static_cast<std::byte*>(data);
+    // ソートは全体を何度も走査するので、先読みを促す
+    ::madvise(data, size_, MADV_WILLNEED);
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+    if (fd_ != -1) {
+        ::close(fd_);
+    }
+}
+
+void MappedFile::flush() {
+    if (data_ != nullptr) {
+        ::msync(data_, size_, MS_SYNC);
+    }
+}
+
+#endif
+
+std::string_view to_string(BinaryFormat format) { return BINARY_FORMAT_NAMES[static_cast<size_t>(format)]; }
+
+std::optional<BinaryFormat> parse_binary_format(std::string_view name) {
+    for (auto format : {BinaryFormat::Raw, BinaryFormat::LengthPrefixed}) {
+        if (to_string(format) == name) {
+            return format;
+        }
+    }
+    return std::nullopt;
+}
+
+FileSortResult sort_file(const Target& target, const FileSortOptions& options) {
+    auto mode = MappedFile::Mode::CopyOnWrite;
+    auto path = options.input;
+    if (!options.output.empty()) {
+        // 出力先に入力をコピーしてからその場でソートする。copy_file は Linux では copy_file_range / sendfile を使う
+        if (!std::filesystem::exists(options.output) ||
+            !std::filesystem::equivalent(options.input, options.output)) {
+            std::filesystem::copy_file(options.input, options.output,
+                                       std::filesystem::copy_options::overwrite_existing);
+        }
+        mode = MappedFile::Mode::ReadWrite;
+        path = options.output;
+    }
+
+    MappedFile file(path, mode);
+    auto data = element_span(file.bytes(), options.format, path);
+
+    const auto start = std::chrono::steady_clock::now();
+    target.sort(data);
+    const auto end = std::chrono::steady_clock::now();
+
+    if (options.verify && !std::ranges::is_sorted(data)) {
+        const auto position = std::ranges::is_sorted_until(data) - data.begin();
+        throw std::runtime_error(std::format("{}: not sorted at index {}", path.string(), position));
+    }
+    if (mode == MappedFile::Mode::ReadWrite) {
+        file.flush();
+    }
+    return {data.size(), std::chrono::duration<double>(end - start).count()};
+}
+
+}  // namespace AlgorithmSamples::Benchmark
@@ -0,0 +1,71 @@
+﻿#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include "benchmark.hpp"
+
+namespace AlgorithmSamples::Benchmark {
+
+// ファイルをメモリにマップする。POSIX では mmap、Windows では MapViewOfFile を使う
+class MappedFile {
+public:
+    enum class Mode {
+        CopyOnWrite,  // 書き込みはプロセス内だけに見え、ファイルは変わらない (MAP_PRIVATE)
+        ReadWrite,    // 書き込みがファイルに反映される (MAP_SHARED)
+    };
+
+    // 開けない・マップできない場合は std::system_error を投げる。空のファイルはマップせず、bytes() が空になる
+    MappedFile(const std::filesystem::path& path, Mode mode);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    std::span<std::byte> bytes() const { return {data_, size_}; }
+
+    // ReadWrite のとき、書き込みをファイルへ書き出す
+    void flush();
+
+private:
+    std::byte* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// --input / --output で読み書きする int の列の形式 (バイト順は実行環境のもの)
+enum class BinaryFormat {
+    Raw,             // int32 をそのまま並べる
+    LengthPrefixed,  // 要素数 (uint64) の後に int32 を並べる
+};
+
+std::string_view to_string(BinaryFormat format);
+std::optional<BinaryFormat> parse_binary_format(std::string_view name);
+
+struct FileSortOptions {
+    std::filesystem::path input;
+    std::filesystem::path output;  // 空ならソート結果を書き出さない (入力ファイルも変えない)
+    BinaryFormat format = BinaryFormat::Raw;
+    bool verify = false;
+};
+
+struct FileSortResult {
+    size_t size = 0;
+    double seconds = 0;  // ソートの呼び出しだけの時間
+};
+
+// input の int の列を target でソートする。
+// output を指定した場合は入力をカーネル内でコピー (copy_file) してから output をマップしてその場でソートするので、
+// 要素がユーザー空間の別のバッファにコピーされることはない。output が input と同じファイルなら input を直接ソートする。
+// 形式が壊れている場合は std::runtime_error、verify でソート済みになっていなければ std::runtime_error を投げる
+FileSortResult sort_file(const Target& target, const FileSortOptions& options);
+
+}  // namespace AlgorithmSamples::Benchmark
@@ -0,0 +1,93 @@
+﻿#include "perf_counters.hpp"
+#include <utility>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace AlgorithmSamples::Benchmark {
+
+#ifdef __linux__
+
+namespace {
+int open_counter(uint32_t type, uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group_fd == -1 ? 1 : 0;  // グループリーダーだけ無効状態で作り、まとめて有効化する
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+}  // namespace
+
+PerfCounterGroup::PerfCounterGroup() {
+    const std::pair<uint32_t, uint64_t> events[EVENT_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    };
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+        fds_[i] = open_counter(events[i].first, events[i].second, fds_[0]);
+        if (fds_[i] == -1) {
+            // 1 つでも開けなければ全体を無効にする
+            for (int j = 0; j < i; ++j) {
+                close(fds_[j]);
+                fds_[j] = -1;
+            }
+            return;
+        }
+    }
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+    for (auto fd : fds_) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+}
+
+bool PerfCounterGroup::available() const { return fds_[0] != -1; }
+
+void PerfCounterGroup::start() {
+    if (!available()) {
+        return;
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+std::optional<PerfCounts> PerfCounterGroup::stop() {
+    if (!available()) {
+        return std::nullopt;
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // PERF_FORMAT_GROUP: { nr, values[nr] }
+    uint64_t buffer[1 + EVENT_COUNT] = {};
+    if (read(fds_[0], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)) || buffer[0] != EVENT_COUNT) {
+        return std::nullopt;
+    }
+    return PerfCounts{buffer[1], buffer[2], buffer[3], buffer[4]};
+}
+
+#else
+
+PerfCounterGroup::PerfCounterGroup() = default;
+PerfCounterGroup::~PerfCounterGroup() = default;
+bool PerfCounterGroup::available() const { return false; }
+void PerfCounterGroup::start() {}
+std::optional<PerfCounts> PerfCounterGroup::stop() { return std::nullopt; }
+
+#endif
+
+}  // namespace AlgorithmSamples::Benchmark
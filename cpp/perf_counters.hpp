@@ -0,0 +1,45 @@
+﻿#pragma once
+#include <cstdint>
+#include <optional>
+
+namespace AlgorithmSamples::Benchmark {
+
+// perf_event_open で取得したハードウェアカウンタの値
+struct PerfCounts {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t branch_misses = 0;
+    uint64_t cache_misses = 0;
+
+    PerfCounts& operator+=(const PerfCounts& other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        branch_misses += other.branch_misses;
+        cache_misses += other.cache_misses;
+        return *this;
+    }
+};
+
+// 呼び出しスレッドのハードウェアカウンタを start() から stop() の間だけ数える。
+// Linux 以外の環境や、権限不足 (perf_event_paranoid) でカウンタを開けない場合は
+// available() が false になり、stop() は常に std::nullopt を返す。
+class PerfCounterGroup {
+public:
+    PerfCounterGroup();
+    ~PerfCounterGroup();
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+    PerfCounterGroup(PerfCounterGroup&&) = delete;
+    PerfCounterGroup& operator=(PerfCounterGroup&&) = delete;
+
+    bool available() const;
+    void start();
+    std::optional<PerfCounts> stop();
+
+private:
+    static constexpr int EVENT_COUNT = 4;
+    int fds_[EVENT_COUNT] = {-1, -1, -1, -1};
+};
+
+}  // namespace AlgorithmSamples::Benchmark
@@ -0,0 +1,95 @@
+#!/bin/bash
+
+# コンパイル時ソートのビルド時間を測る
+# Usage:
+#   bash constexpr-sort-bench.sh [要素数...]   # 既定は 1000 10000
+# 環境変数:
+#   CXX              使うコンパイラ (既定は c++)
+#   CXXFLAGS         追加のフラグ (定数評価の上限を上げる GCC の -fconstexpr-ops-limit= や clang の -fconstexpr-steps= など)
+#   TIMEOUT_SECONDS  1 回のコンパイルの打ち切り時間 (既定は 120)
+#
+# 乱数の int 配列を static_assert の中でソートする翻訳単位を作り、-fsyntax-only の時間を測る。
+# bubble_sort と pdq_sort は各ヘッダーの std::array 版 (比較のため)。
+# 配列を作るだけの翻訳単位の時間を引いた値をソートの分として表示する
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+CPP_DIR="$(dirname "$SCRIPT_DIR")"
+CXX="${CXX:-c++}"
+TIMEOUT_SECONDS="${TIMEOUT_SECONDS:-120}"
+SIZES=("$@")
+if [ ${#SIZES[@]} -eq 0 ]; then
+    SIZES=(1000 10000)
+fi
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# $1: 要素数, $2: static_assert に入れる式 (input を使う)
+write_source() {
+    cat > "$WORK_DIR/bench.cpp" <<EOF
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include "sort/bubble_sort.hpp"
+#include "sort/constexpr_sort.hpp"
+#include "sort/pdq_sort.hpp"
+
+using namespace AlgorithmSamples::Sort;
+
+constexpr auto input = [] {
+    std::array<int, $1> arr{};
+    std::uint32_t state = 12345;
+    for (auto& value : arr) {
+        state = state * 1664525u + 1013904223u;
+        value = static_cast<int>(state >> 8);
+    }
+    return arr;
+}();
+
+static_assert($2);
+EOF
+}
+
+# コンパイルにかかった秒数を表示する。失敗したら理由を表示する
+measure() {
+    local start end status
+    start=$(date +%s.%N)
+    set +e
+    # shellcheck disable=SC2086
+    timeout "$TIMEOUT_SECONDS" "$CXX" -std=c++23 -fsyntax-only -I"$CPP_DIR" $CXXFLAGS "$WORK_DIR/bench.cpp" \
+        > "$WORK_DIR/log.txt" 2>&1
+    status=$?
+    set -e
+    end=$(date +%s.%N)
+    if [ $status -eq 124 ]; then
+        echo "timeout"
+    elif [ $status -ne 0 ]; then
+        # 定数評価の上限に当たったときなど
+        echo "error"
+    else
+        awk -v start="$start" -v end="$end" 'BEGIN { printf "%.2f", end - start }'
+    fi
+}
+
+echo "compiler: $($CXX --version | head -n 1)"
+printf "%-8s %-24s %10s\n" "size" "algorithm" "seconds"
+for size in "${SIZES[@]}"; do
+    write_source "$size" "input.size() == $size"
+    baseline=$(measure)
+    printf "%-8s %-24s %10s\n" "$size" "(array only)" "$baseline"
+    for algorithm in constexpr_sort sorted_unique sort_rank pdq_sort bubble_sort; do
+        # 結果の検査にも定数評価の時間がかかるので、ソートの戻り値のうち小さな値だけを見る (正しさはテストで確かめる)
+        case $algorithm in
+            sort_rank) expression="sort_rank(input)[0] < input.size()" ;;
+            *) expression="std::get<1>($algorithm(input)) > 0" ;;
+        esac
+        write_source "$size" "$expression"
+        seconds=$(measure)
+        if [[ "$seconds" =~ ^[0-9.]+$ ]] && [[ "$baseline" =~ ^[0-9.]+$ ]]; then
+            seconds=$(awk -v total="$seconds" -v base="$baseline" 'BEGIN { printf "%.2f", total - base }')
+        fi
+        printf "%-8s %-24s %10s\n" "$size" "$algorithm" "$seconds"
+    done
+done
@@ -0,0 +1,16 @@
+﻿#pragma once
+#include <concepts>
+#include <cstddef>
+
+namespace AlgorithmSamples::Sort {
+
+// 早期終了するソートの結果。loopCount は比較回数、passCount は走査した回数
+template <std::integral Result = size_t>
+struct AdaptiveSortResult {
+    Result loopCount = 0;
+    Result passCount = 0;
+
+    constexpr bool operator==(const AdaptiveSortResult&) const = default;
+};
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,87 @@
+﻿#pragma once
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+#include "concurrency/executor.hpp"
+#include "concurrency/task.hpp"
+#include "sort/sort_passes.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+struct SortProgress {
+    // 終えたパスの数と、その上限 (入力によってはこれより早く終わる)
+    size_t passes = 0;
+    size_t max_passes = 0;
+    size_t loop_count = 0;
+};
+
+struct AsyncSortOptions {
+    // 停止が要求されたら次のパスの前に中断する。中断した時点で範囲は並べ替えの途中だが、要素は失われない
+    std::stop_token stop_token;
+    // 前回の中断からこの回数以上比較したら、パスの終わりで実行器に制御を返す。0 なら毎パス返す
+    size_t yield_every = 1 << 16;
+    // 各パスの終わりに、ソートを進めているスレッドで呼ばれる
+    std::function<void(const SortProgress&)> on_progress;
+};
+
+struct AsyncSortResult {
+    size_t loop_count = 0;
+    size_t passes = 0;
+    bool cancelled = false;
+};
+
+// passes を executor 上で最後まで進めるタスクを返す。
+// タスクはまず executor に移ってから始まり、yield_every 回の比較ごとに executor へ続きを積み直すので、
+// 単一スレッドのイベントループ (ManualExecutor) でも他の処理と交互に進む。
+// 範囲は完了 (または中断) まで呼び出し側が触らないこと。executor はタスクより長く生きていること
+template <Concurrency::Executor E, SortPasses Passes>
+Concurrency::Task<AsyncSortResult> async_sort(E& executor, Passes passes, AsyncSortOptions options = {}) {
+    co_await Concurrency::schedule(executor);
+
+    AsyncSortResult result;
+    size_t yielded_at = 0;
+    while (!passes.done()) {
+        if (options.stop_token.stop_requested()) {
+            result.cancelled = true;
+            break;
+        }
+        passes.run_pass();
+        const auto loop_count = static_cast<size_t>(passes.loop_count());
+        if (options.on_progress) {
+            options.on_progress(SortProgress{passes.pass_count(), passes.max_passes(), loop_count});
+        }
+        if (loop_count - yielded_at >= options.yield_every && !passes.done()) {
+            yielded_at = loop_count;
+            co_await Concurrency::schedule(executor);
+        }
+    }
+    result.loop_count = static_cast<size_t>(passes.loop_count());
+    result.passes = passes.pass_count();
+    co_return result;
+}
+
+// パスに分けられないソートを executor 上で 1 度に実行するタスクを返す。sort() はソートの戻り値 (比較回数) を返す関数。
+// 途中で制御を返さないので、イベントループを止めないためには ThreadExecutor など別スレッドの実行器を使う。
+// 停止の要求は開始前にだけ確認する
+template <Concurrency::Executor E, std::invocable Sort>
+    requires std::integral<std::invoke_result_t<Sort&>>
+Concurrency::Task<AsyncSortResult> async_sort(E& executor, Sort sort, AsyncSortOptions options = {}) {
+    co_await Concurrency::schedule(executor);
+
+    AsyncSortResult result;
+    if (options.stop_token.stop_requested()) {
+        result.cancelled = true;
+        co_return result;
+    }
+    result.loop_count = static_cast<size_t>(std::invoke(sort));
+    result.passes = 1;
+    if (options.on_progress) {
+        options.on_progress(SortProgress{1, 1, result.loop_count});
+    }
+    co_return result;
+}
+
+}  // namespace AlgorithmSamples::Sort
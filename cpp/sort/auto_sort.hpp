@@ -0,0 +1,266 @@
+﻿#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "sort/indirect_sort.hpp"
+#include "sort/pdq_sort.hpp"
+#include "sort/projection.hpp"
+#include "sort/radix_sort.hpp"
+#include "sort/string_sort.hpp"
+#include "sort/tim_sort.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// auto_sort が選ぶソート
+enum class SortEngine {
+    None,          // 要素数 0 / 1
+    PdqSort,       // 汎用 (小さい入力・他の条件に当てはまらない入力)
+    TimSort,       // 長いランからなる入力 (整列済み・逆順・山型・末尾への追記など)
+    RadixSort,     // 整数・浮動小数点数のキー
+    StringSort,    // 文字列のキー
+    IndirectSort,  // INDIRECT_SORT_THRESHOLD を超える大きな要素
+};
+
+constexpr std::string_view to_string(SortEngine engine) {
+    switch (engine) {
+        case SortEngine::None:
+            return "none";
+        case SortEngine::PdqSort:
+            return "pdq_sort";
+        case SortEngine::TimSort:
+            return "tim_sort";
+        case SortEngine::RadixSort:
+            return "radix_sort";
+        case SortEngine::StringSort:
+            return "string_sort";
+        case SortEngine::IndirectSort:
+            return "indirect_sort";
+    }
+    return "unknown";
+}
+
+enum class SortKeyKind {
+    Radix,   // RadixKey を満たす整数・浮動小数点数
+    String,  // std::string_view として見られる文字列
+    Other,
+};
+
+// 入力を標本から見積もった結果
+struct InputProfile {
+    size_t size = 0;
+    size_t element_size = 0;
+    SortKeyKind key_kind = SortKeyKind::Other;
+    // 調べた窓 (連続する数要素) の数と、そのうち単調 (昇順または降順) だった数。
+    // ほとんどの窓が単調なら、入力は少数の長いランからなる
+    size_t sampled_windows = 0;
+    size_t monotone_windows = 0;
+    // 標本のうち、他の標本と等しいキーの割合 (0 ならすべて異なる)。小さい入力では調べない (0 のまま)
+    double duplicate_ratio = 0;
+};
+
+struct SortDecision {
+    SortEngine engine = SortEngine::None;
+    InputProfile profile;
+};
+
+namespace detail::auto_select {
+
+// これより小さい入力は標本を取らずに pdq_sort でソートする (挿入ソートで済む大きさ)
+inline constexpr size_t MIN_PROFILED_SIZE = 64;
+// 標本の窓の最大数と、1 つの窓の要素数。窓は WINDOW_SPACING 要素あたり 1 つ (比較は要素数の 1/4 以下) に抑える
+inline constexpr size_t SAMPLE_WINDOWS = 64;
+inline constexpr size_t WINDOW_SIZE = 5;
+inline constexpr size_t WINDOW_SPACING = 16;
+// 重複の割合を見積もる標本の数と、見積もりを行う最小の要素数
+inline constexpr size_t DUPLICATE_SAMPLES = 64;
+inline constexpr size_t DUPLICATE_SAMPLE_MIN_SIZE = 4096;
+// この割合以上の窓が単調なら tim_sort を使う
+inline constexpr double RUN_THRESHOLD = 0.9;
+// 基数ソートは桁ごとに全要素を動かすので、これより大きい要素には使わない
+inline constexpr size_t RADIX_MAX_ELEMENT_SIZE = 16;
+// これより小さい入力では、基数ソートのヒストグラムと作業領域の準備が pdq_sort より高くつく
+inline constexpr size_t RADIX_MIN_SIZE = 256;
+// 標本の重複の割合がこれ以上 (乱数なら異なる値が 16 種類程度以下) で要素数が FEW_UNIQUE_MIN_SIZE 以上なら、
+// 基数ソートより等しい要素をまとめて分割する pdq_sort の方が速い
+inline constexpr double FEW_UNIQUE_RATIO = 0.75;
+inline constexpr size_t FEW_UNIQUE_MIN_SIZE = size_t{1} << 16;
+// これより小さい入力では、string_sort の組の配列を作るより pdq_sort の方が速い
+inline constexpr size_t STRING_SORT_MIN_SIZE = 256;
+
+template <typename Comparator, typename Key>
+inline constexpr bool is_ascending =
+    std::same_as<Comparator, std::less<>> || std::same_as<Comparator, std::less<Key>>;
+
+template <typename Comparator, typename Key>
+inline constexpr bool is_descending =
+    std::same_as<Comparator, std::greater<>> || std::same_as<Comparator, std::greater<Key>>;
+
+template <typename Iterator, typename Comparator, typename Projection>
+constexpr SortKeyKind key_kind() {
+    using Key = projected_key_t<Iterator, Projection>;
+    if constexpr (RadixKey<Key> && (is_ascending<Comparator, Key> || is_descending<Comparator, Key>)) {
+        return SortKeyKind::Radix;
+    } else if constexpr (StringKeyProjection<Iterator, Projection> && indirect::StandardOrder<Comparator>) {
+        return SortKeyKind::String;
+    } else {
+        return SortKeyKind::Other;
+    }
+}
+
+// 入力全体に等間隔に置いた窓が単調かどうかを数える
+template <typename Iterator, typename Compare>
+void sample_runs(Iterator begin, size_t size, Compare& compare, InputProfile& profile) {
+    const auto windows = std::min(SAMPLE_WINDOWS, size / WINDOW_SPACING);
+    for (size_t w = 0; w < windows; ++w) {
+        const auto start = static_cast<std::ptrdiff_t>(w * (size - WINDOW_SIZE) / std::max<size_t>(windows - 1, 1));
+        auto first = begin + start;
+        bool ascending = true;
+        bool descending = true;
+        for (size_t i = 1; i < WINDOW_SIZE; ++i) {
+            const auto& prev = first[static_cast<std::ptrdiff_t>(i - 1)];
+            const auto& cur = first[static_cast<std::ptrdiff_t>(i)];
+            ascending = ascending && !compare(cur, prev);
+            descending = descending && !compare(prev, cur);
+        }
+        profile.monotone_windows += (ascending || descending) ? 1 : 0;
+    }
+    profile.sampled_windows = windows;
+}
+
+// 等間隔の標本のキーをソートし、隣と等しいものの割合を数える
+template <typename Iterator, typename Comparator, typename Projection>
+void sample_duplicates(Iterator begin, size_t size, const Comparator& comparator, const Projection& projection,
+                       InputProfile& profile) {
+    using Key = projected_key_t<Iterator, Projection>;
+    if constexpr (std::copy_constructible<Key>) {
+        const auto samples = std::min(DUPLICATE_SAMPLES, size);
+        std::vector<Key> keys;
+        keys.reserve(samples);
+        for (size_t i = 0; i < samples; ++i) {
+            keys.push_back(std::invoke(projection, begin[static_cast<std::ptrdiff_t>(i * size / samples)]));
+        }
+        auto key_compare = comparator;
+        pdq_sort(keys.begin(), keys.end(), key_compare);
+        size_t duplicates = 0;
+        for (size_t i = 1; i < samples; ++i) {
+            duplicates += key_compare(keys[i - 1], keys[i]) ? 0 : 1;
+        }
+        profile.duplicate_ratio = static_cast<double>(duplicates) / static_cast<double>(samples);
+    }
+}
+
+}  // namespace detail::auto_select
+
+// 入力の標本を取り、auto_sort が使うソートを決める。要素は動かさない。
+// 調べるのは要素数・要素の大きさ・キーの種類と、等間隔の窓 (最大 64 × 5 要素) の単調さ、64 個の標本の重複の割合。
+// 最後の 2 つは比較の順序だけを使うので、どの comparator でも (基数ソートなどが使えないときも) 調べる
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, typename Projection = std::identity>
+SortDecision choose_sort(Iterator begin, Iterator end, const Comparator& comparator = {},
+                         const Projection& projection = {}) {
+    namespace select = detail::auto_select;
+    using T = std::iter_value_t<Iterator>;
+    constexpr auto key_kind = select::key_kind<Iterator, Comparator, Projection>();
+
+    SortDecision decision;
+    auto& profile = decision.profile;
+    profile.size = static_cast<size_t>(end - begin);
+    profile.element_size = sizeof(T);
+    profile.key_kind = key_kind;
+    if (profile.size < 2) {
+        return decision;
+    }
+    decision.engine = SortEngine::PdqSort;
+    if (profile.size < select::MIN_PROFILED_SIZE) {
+        return decision;
+    }
+
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    select::sample_runs(begin, profile.size, compare, profile);
+    if (profile.size >= select::DUPLICATE_SAMPLE_MIN_SIZE) {
+        select::sample_duplicates(begin, profile.size, comparator, projection, profile);
+    }
+
+    if (static_cast<double>(profile.monotone_windows) >=
+        select::RUN_THRESHOLD * static_cast<double>(profile.sampled_windows)) {
+        // ランの検出とギャロップ付きのマージで、ラン数を r として O(n log r) で済む
+        decision.engine = SortEngine::TimSort;
+    } else if (key_kind == SortKeyKind::String && profile.size >= select::STRING_SORT_MIN_SIZE) {
+        decision.engine = SortEngine::StringSort;
+    } else if (key_kind == SortKeyKind::Radix && profile.size >= select::RADIX_MIN_SIZE &&
+               sizeof(T) <= select::RADIX_MAX_ELEMENT_SIZE &&
+               !(profile.duplicate_ratio >= select::FEW_UNIQUE_RATIO && profile.size >= select::FEW_UNIQUE_MIN_SIZE)) {
+        decision.engine = SortEngine::RadixSort;
+    } else if (enable_indirect_sort<T>) {
+        decision.engine = SortEngine::IndirectSort;
+    }
+    return decision;
+}
+
+// decision に従ってソートする。戻り値は選んだソートの戻り値 (比較回数または走査回数)
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+Result sort_with(const SortDecision& decision, Iterator begin, Iterator end, Comparator comparator = {},
+                 Projection projection = {}) {
+    using T = std::iter_value_t<Iterator>;
+    constexpr auto key_kind = detail::auto_select::key_kind<Iterator, Comparator, Projection>();
+    switch (decision.engine) {
+        case SortEngine::None:
+            return 0;
+        case SortEngine::TimSort:
+            return tim_sort<Iterator, Comparator, Result>(begin, end, comparator, projection);
+        case SortEngine::StringSort:
+            if constexpr (key_kind == SortKeyKind::String) {
+                return string_sort<Iterator, Comparator, Result>(begin, end, comparator, projection);
+            }
+            break;
+        case SortEngine::RadixSort:
+            if constexpr (key_kind == SortKeyKind::Radix) {
+                Result loopCount = 0;
+                if constexpr (std::default_initializable<T>) {
+                    std::vector<T> scratch(static_cast<size_t>(end - begin));
+                    loopCount = radix_sort<Iterator, typename std::vector<T>::iterator, Projection, Result>(
+                        begin, end, scratch.begin(), projection);
+                } else {
+                    loopCount = msd_radix_sort<Iterator, Projection, Result>(begin, end, projection);
+                }
+                // 基数ソートは昇順のみ
+                if constexpr (detail::auto_select::is_descending<Comparator, projected_key_t<Iterator, Projection>>) {
+                    std::reverse(begin, end);
+                }
+                return loopCount;
+            }
+            break;
+        case SortEngine::IndirectSort:
+            return indirect_sort<Iterator, Comparator, Result>(begin, end, comparator, projection);
+        case SortEngine::PdqSort:
+            break;
+    }
+    return pdq_sort<Iterator, Comparator, Result>(begin, end, comparator, projection);
+}
+
+// 入力の標本から最適なソートを選んでソートする (choose_sort + sort_with)。
+// 安定ソートではない (長いランからなる入力で tim_sort が選ばれたときだけ安定)
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+Result auto_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {}) {
+    const auto decision = choose_sort(begin, end, comparator, projection);
+    return sort_with<Iterator, Comparator, Result>(decision, begin, end, comparator, projection);
+}
+
+// auto_sort と同じだが、ソートの前に選んだ結果を on_decision(const SortDecision&) に渡す (ログ・計測用)
+template <std::random_access_iterator Iterator, typename Comparator, typename Projection,
+          std::invocable<const SortDecision&> Observer, std::integral Result = size_t>
+Result auto_sort(Iterator begin, Iterator end, Comparator comparator, Projection projection, Observer&& on_decision) {
+    const auto decision = choose_sort(begin, end, comparator, projection);
+    std::invoke(on_decision, decision);
+    return sort_with<Iterator, Comparator, Result>(decision, begin, end, comparator, projection);
+}
+
+}  // namespace AlgorithmSamples::Sort
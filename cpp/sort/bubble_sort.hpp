@@ -6,35 +6,148 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include "sort/adaptive_sort_result.hpp"
+#include "sort/indirect_sort.hpp"
+#include "sort/projection.hpp"
+#include "sort/sort_passes.hpp"
 
 namespace AlgorithmSamples::Sort {
 
-template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t>
-constexpr Result bubble_sort(Iterator begin, Iterator end, Comparator comparator = {}) {
+// バブルソートを 1 パス (未確定の範囲を 1 回走査して最大の要素を末尾へ送る) ずつ進める。
+// bubble_sort はこれを最後まで回したもので、async_sort はパスの合間に中断・再開する
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+class BubbleSortPasses {
+public:
+    constexpr BubbleSortPasses(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {})
+        : begin_(begin),
+          bound_(begin == end ? end : std::prev(end)),
+          compare_(detail::make_projected_comparator(std::move(comparator), std::move(projection))),
+          max_passes_(begin == end ? 0 : static_cast<size_t>(end - begin) - 1) {}
+
+    constexpr bool done() const { return bound_ == begin_; }
+
+    constexpr void run_pass() {
+        const auto begin = begin_;
+        const auto bound = bound_;
+        Result loopCount = 0;
+        for (auto b = begin; b != bound; ++b) {
+            if (compare_(*std::next(b), *b)) {
+                std::ranges::iter_swap(std::next(b), b);
+            }
+            ++loopCount;
+        }
+        loopCount_ += loopCount;
+        --bound_;
+        ++passCount_;
+    }
+
+    constexpr Result loop_count() const { return loopCount_; }
+    constexpr size_t pass_count() const { return passCount_; }
+    constexpr size_t max_passes() const { return max_passes_; }
+    // まだ確定していない範囲 [first, second) の位置
+    constexpr std::pair<size_t, size_t> range() const {
+        return {0, static_cast<size_t>(bound_ - begin_) + (done() ? 0 : 1)};
+    }
+
+private:
+    Iterator begin_;
+    // [begin_, bound_] が未確定の範囲
+    Iterator bound_;
+    decltype(detail::make_projected_comparator(std::declval<Comparator>(), std::declval<Projection>())) compare_;
+    size_t max_passes_;
+    Result loopCount_ = 0;
+    size_t passCount_ = 0;
+};
+
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr Result bubble_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {}) {
     if (begin == end || std::next(begin) == end) {
         return 0;
     }
 
-    Result loopCount = 0;
-    for (auto a = std::prev(end); a != begin; --a) {
-        for (auto b = begin; b != a; ++b) {
-            if (comparator(*std::next(b), *b)) {
-                std::swap(*std::next(b), *b);
+    // 大きな要素は交換のたびに動かさず、(キーの先頭, 位置) の組を同じ手順でソートしてから 1 回ずつ動かす
+    if constexpr (enable_indirect_sort<std::iter_value_t<Iterator>>) {
+        if (!std::is_constant_evaluated()) {
+            auto sorter = [](auto first, auto last, auto compare, auto key) {
+                return bubble_sort<decltype(first), decltype(compare), Result>(first, last, compare, key);
+            };
+            return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
+        }
+    }
+
+    BubbleSortPasses<Iterator, Comparator, Result, Projection> passes(begin, end, comparator, projection);
+    run_passes(passes);
+    return passes.loop_count();
+}
+
+// 適応型のバブルソート。各パスで最後に交換した位置より後ろは確定しているので、次のパスはそこまでに縮める。
+// 交換のないパスで終了するため、ソート済みなら n - 1 回、k 要素だけ本来より前にある入力なら O(nk) 回の比較で済む。
+// 本来より後ろにある要素は 1 パスで 1 つしか前に進まないので、末尾に追加された要素には adaptive_shaker_sort を使う
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr AdaptiveSortResult<Result> adaptive_bubble_sort(Iterator begin, Iterator end, Comparator comparator = {},
+                                                          Projection projection = {}) {
+    AdaptiveSortResult<Result> result;
+    if (begin == end || std::next(begin) == end) {
+        return result;
+    }
+
+    // 大きな要素は交換のたびに動かさず、(キーの先頭, 位置) の組を同じ手順でソートしてから 1 回ずつ動かす
+    if constexpr (enable_indirect_sort<std::iter_value_t<Iterator>>) {
+        if (!std::is_constant_evaluated()) {
+            auto sorter = [](auto first, auto last, auto compare, auto key) {
+                return adaptive_bubble_sort<decltype(first), decltype(compare), Result>(first, last, compare, key);
+            };
+            return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
+        }
+    }
+
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    // [begin, bound] が未確定の範囲
+    auto bound = std::prev(end);
+    detail::PassReporter reporter(static_cast<size_t>(bound - begin));
+    while (bound != begin) {
+        auto last_swap = begin;
+        for (auto b = begin; b != bound; ++b) {
+            if (compare(*std::next(b), *b)) {
+                std::ranges::iter_swap(std::next(b), b);
+                last_swap = b;
             }
-            ++loopCount;
+            ++result.loopCount;
+        }
+        ++result.passCount;
+        bound = last_swap;
+        if (reporter.enabled()) {
+            const auto unsorted = bound == begin ? 0 : static_cast<size_t>(bound - begin) + 1;
+            reporter.pass_done(result.passCount, 0, unsorted, static_cast<size_t>(result.loopCount));
         }
     }
-    return loopCount;
+    return result;
 }
 
-template <std::integral T, std::size_t N, typename Comparator = std::less<>>
-constexpr std::tuple<std::array<T, N>, size_t> bubble_sort(const std::array<T, N>& input, Comparator comparator = {}) {
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> bubble_sort(const std::array<T, N>& input, Comparator comparator = {},
+                                                           Projection projection = {}) {
     std::array<T, N> arr = input;
-    auto loopCount = bubble_sort(arr.begin(), arr.end(), comparator);
+    auto loopCount = bubble_sort(arr.begin(), arr.end(), comparator, projection);
     return std::make_tuple(arr, loopCount);
 }
 
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, AdaptiveSortResult<>> adaptive_bubble_sort(const std::array<T, N>& input,
+                                                                                  Comparator comparator = {},
+                                                                                  Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto result = adaptive_bubble_sort(arr.begin(), arr.end(), comparator, projection);
+    return std::make_tuple(arr, result);
+}
+
 static_assert(std::get<0>(bubble_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
 static_assert(std::get<0>(bubble_sort(std::array{5, 3, 1, 4, 2}, std::greater<>())) == std::array{5, 4, 3, 2, 1});
+static_assert(std::get<0>(adaptive_bubble_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
+static_assert(std::get<1>(bubble_sort(std::array{5, 3, 1, 4, 2})) == 10);
+static_assert(std::get<1>(adaptive_bubble_sort(std::array{1, 2, 3, 4, 5})) == AdaptiveSortResult<>{4, 1});
 
 }  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,261 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "sort/projection.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// コンパイル時に表を作るためのソート群。
+// 各ヘッダーの std::array 版 (bubble_sort など) は O(n^2) のものが多く、数千要素では定数評価の上限に当たるので、
+// ここでは再帰も動的確保も使わないボトムアップのマージソートで O(n log n) に抑える。
+// 定数評価では比較や代入の回数がそのままコンパイル時間になる (scripts/constexpr-sort-bench.sh で測れる)
+
+namespace detail::constexpr_merge {
+
+// この長さの区間を挿入ソートしてからマージを始める。定数評価ではマージのパスを減らすほうが安い
+inline constexpr std::size_t INSERTION_RUN = 8;
+
+// arr を安定にソートし、比較回数を返す。
+// 定数評価では関数呼び出しも 1 回ずつ数えられる (GCC の既定の上限は 2^25 回) ので、
+// 添字演算子や std::move を避けてポインタで直接読み書きする
+template <typename T, std::size_t N, typename Compare>
+constexpr size_t merge_sort(std::array<T, N>& arr, Compare& compare) {
+    size_t loopCount = 0;
+    T* const data = arr.data();
+    for (std::size_t begin = 0; begin < N; begin += INSERTION_RUN) {
+        T* const first = data + begin;
+        T* const last = data + std::min(begin + INSERTION_RUN, N);
+        for (T* i = first + 1; i < last; ++i) {
+            T value = static_cast<T&&>(*i);
+            T* j = i;
+            for (; j > first; --j) {
+                ++loopCount;
+                if (!compare(value, *(j - 1))) {
+                    break;
+                }
+                *j = static_cast<T&&>(*(j - 1));
+            }
+            *j = static_cast<T&&>(value);
+        }
+    }
+
+    // arr と buffer の間を行き来しながら、ソート済みの区間の長さを倍にしていく
+    std::array<T, N> buffer{};
+    T* from = data;
+    T* to = buffer.data();
+    for (auto width = INSERTION_RUN; width < N; width *= 2) {
+        for (std::size_t begin = 0; begin < N; begin += 2 * width) {
+            T* left = from + begin;
+            T* const middle = from + std::min(begin + width, N);
+            T* right = middle;
+            T* const end = from + std::min(begin + 2 * width, N);
+            T* out = to + begin;
+            while (left < middle && right < end) {
+                ++loopCount;
+                // 等しければ左を先に出して安定にする
+                if (compare(*right, *left)) {
+                    *out++ = static_cast<T&&>(*right++);
+                } else {
+                    *out++ = static_cast<T&&>(*left++);
+                }
+            }
+            while (left < middle) {
+                *out++ = static_cast<T&&>(*left++);
+            }
+            while (right < end) {
+                *out++ = static_cast<T&&>(*right++);
+            }
+        }
+        std::swap(from, to);
+    }
+    if (from != data) {
+        std::ranges::move(buffer, arr.begin());
+    }
+    return loopCount;
+}
+
+// ソート済みの arr から等しい要素の 2 つ目以降を取り除き、残った要素の数を返す
+template <typename T, std::size_t N, typename Compare>
+constexpr std::size_t unique_sorted(std::array<T, N>& arr, Compare& compare) {
+    if constexpr (N == 0) {
+        return 0;
+    } else {
+        T* const data = arr.data();
+        T* last = data;
+        for (T* i = data + 1; i < data + N; ++i) {
+            if (compare(*last, *i)) {
+                *++last = static_cast<T&&>(*i);
+            }
+        }
+        return static_cast<std::size_t>(last - data) + 1;
+    }
+}
+
+}  // namespace detail::constexpr_merge
+
+// 安定な O(n log n) のソート (定数評価向け)。比較回数とともに返す
+template <std::default_initializable T, std::size_t N, typename Comparator = std::less<>,
+          typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> constexpr_sort(const std::array<T, N>& input, Comparator comparator = {},
+                                                              Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    auto loopCount = detail::constexpr_merge::merge_sort(arr, compare);
+    return std::make_tuple(arr, loopCount);
+}
+
+// ソートしたときに i 番目に来る要素の、入力での位置を返す (等しい要素は入力の順)。
+// 要素そのものを動かさないので、大きな要素や複数の配列を同じ順に並べ替えるときに使う
+template <typename T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::array<std::size_t, N> sort_permutation(const std::array<T, N>& input, Comparator comparator = {},
+                                                      Projection projection = {}) {
+    std::array<std::size_t, N> order{};
+    for (std::size_t i = 0; i < N; ++i) {
+        order[i] = i;
+    }
+    auto compare = [values = input.data(), compare = detail::make_projected_comparator(comparator, projection)](
+                       std::size_t a, std::size_t b) mutable { return compare(values[a], values[b]); };
+    detail::constexpr_merge::merge_sort(order, compare);
+    return order;
+}
+
+// 各要素がソート後に来る位置を返す (sort_permutation の逆置換)。等しい要素にも別々の順位を付ける
+template <typename T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::array<std::size_t, N> sort_rank(const std::array<T, N>& input, Comparator comparator = {},
+                                               Projection projection = {}) {
+    const auto order = sort_permutation(input, comparator, projection);
+    std::array<std::size_t, N> rank{};
+    for (std::size_t i = 0; i < N; ++i) {
+        rank[order[i]] = i;
+    }
+    return rank;
+}
+
+// 各要素より小さい異なる値の数を返す (座標圧縮)。等しい要素は同じ順位になる
+template <typename T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::array<std::size_t, N> dense_rank(const std::array<T, N>& input, Comparator comparator = {},
+                                                Projection projection = {}) {
+    const auto order = sort_permutation(input, comparator, projection);
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    std::array<std::size_t, N> rank{};
+    for (std::size_t i = 1; i < N; ++i) {
+        rank[order[i]] = rank[order[i - 1]] + (compare(input[order[i - 1]], input[order[i]]) ? 1 : 0);
+    }
+    return rank;
+}
+
+// ソートして重複を取り除き、(配列, 異なる要素の数) を返す。配列の先頭から数えた要素だけが意味を持ち、残りは値初期化される
+template <std::default_initializable T, std::size_t N, typename Comparator = std::less<>,
+          typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, std::size_t> sorted_unique(const std::array<T, N>& input,
+                                                                  Comparator comparator = {},
+                                                                  Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    detail::constexpr_merge::merge_sort(arr, compare);
+    const auto count = detail::constexpr_merge::unique_sorted(arr, compare);
+    std::fill(arr.begin() + static_cast<std::ptrdiff_t>(count), arr.end(), T{});
+    return std::make_tuple(arr, count);
+}
+
+// Input をソートして重複を取り除いた、ちょうどの長さの配列 (Input は構造的な型の std::array)
+template <auto Input, typename Comparator = std::less<>, typename Projection = std::identity>
+consteval auto sorted_unique_array() {
+    constexpr auto result = sorted_unique(Input, Comparator{}, Projection{});
+    constexpr auto count = std::get<1>(result);
+    std::array<typename decltype(Input)::value_type, count> arr{};
+    std::copy_n(std::get<0>(result).begin(), count, arr.begin());
+    return arr;
+}
+
+// 文字列リテラルをテンプレート引数に渡すための文字列
+template <std::size_t N>
+struct FixedString {
+    consteval FixedString(const char (&str)[N]) { std::copy_n(str, N, chars); }  // NOLINT(google-explicit-constructor)
+
+    constexpr std::string_view view() const { return {chars, N - 1}; }
+
+    char chars[N]{};
+};
+
+// 文字列リテラルの集合をコンパイル時にソートして重複を除いた表。
+// find() は二分探索で位置を返すので、index<"...">() を case ラベルにした switch で文字列を振り分けられる
+template <FixedString... Strings>
+class SortedStringTable {
+    static constexpr auto sorted_ = sorted_unique(std::array<std::string_view, sizeof...(Strings)>{Strings.view()...});
+
+public:
+    static constexpr std::size_t size() { return std::get<1>(sorted_); }
+
+    // 辞書順に並んだ文字列
+    static constexpr auto values = [] {
+        std::array<std::string_view, size()> values{};
+        std::copy_n(std::get<0>(sorted_).begin(), size(), values.begin());
+        return values;
+    }();
+
+    // key の位置を返す。見つからなければ size()
+    static constexpr std::size_t find(std::string_view key) {
+        const auto it = std::ranges::lower_bound(values, key);
+        return it != values.end() && *it == key ? static_cast<std::size_t>(it - values.begin()) : size();
+    }
+
+    // Key の位置。Key が表にない場合はコンパイルエラーになる
+    template <FixedString Key>
+    static consteval std::size_t index() {
+        const auto position = find(Key.view());
+        if (position == size()) {
+            throw "SortedStringTable: key not found";
+        }
+        return position;
+    }
+};
+
+template <typename... Ts>
+struct TypeList {
+    static constexpr std::size_t size = sizeof...(Ts);
+};
+
+namespace detail::constexpr_merge {
+
+template <typename List, template <typename> typename Key, typename Comparator, typename Indices>
+struct SortedTypeList;
+
+template <template <typename> typename Key, typename Comparator>
+struct SortedTypeList<TypeList<>, Key, Comparator, std::index_sequence<>> {
+    using type = TypeList<>;
+};
+
+template <typename... Ts, template <typename> typename Key, typename Comparator, std::size_t... I>
+struct SortedTypeList<TypeList<Ts...>, Key, Comparator, std::index_sequence<I...>> {
+    static constexpr auto order =
+        sort_permutation(std::array<std::common_type_t<decltype(Key<Ts>::value)...>, sizeof...(Ts)>{Key<Ts>::value...},
+                         Comparator{});
+    using type = TypeList<std::tuple_element_t<order[I], std::tuple<Ts...>>...>;
+};
+
+}  // namespace detail::constexpr_merge
+
+// List の型を Key<T>::value の順に安定に並べ替えた TypeList。
+// 例: sorted_type_list_t<TypeList<char, double, int>, std::alignment_of, std::greater<>> は TypeList<double, int, char>
+template <typename List, template <typename> typename Key, typename Comparator = std::less<>>
+using sorted_type_list_t = typename detail::constexpr_merge::SortedTypeList<List, Key, Comparator,
+                                                                           std::make_index_sequence<List::size>>::type;
+
+static_assert(std::get<0>(constexpr_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
+static_assert(std::get<0>(constexpr_sort(std::array{5, 3, 1, 4, 2}, std::greater<>())) == std::array{5, 4, 3, 2, 1});
+static_assert(sort_permutation(std::array{30, 10, 20, 10}) == std::array<std::size_t, 4>{1, 3, 2, 0});
+static_assert(sort_rank(std::array{30, 10, 20, 10}) == std::array<std::size_t, 4>{3, 0, 2, 1});
+static_assert(dense_rank(std::array{30, 10, 20, 10}) == std::array<std::size_t, 4>{2, 0, 1, 0});
+static_assert(sorted_unique_array<std::array{3, 1, 3, 2, 1}>() == std::array{1, 2, 3});
+static_assert(std::is_same_v<sorted_type_list_t<TypeList<char, double, int>, std::alignment_of, std::greater<>>,
+                             TypeList<double, int, char>>);
+
+}  // namespace AlgorithmSamples::Sort
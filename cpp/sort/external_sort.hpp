@@ -0,0 +1,341 @@
+﻿#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "sort/pdq_sort.hpp"
+#include "sort/projection.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// 固定長のバイナリレコードとしてファイルに読み書きできる型
+template <typename T>
+concept FixedSizeRecord = std::is_trivially_copyable_v<T> && std::default_initializable<T>;
+
+struct ExternalSortOptions {
+    // ソート中に保持するレコードの合計バイト数。ランの長さとマージ時の入出力バッファの大きさを決める
+    size_t memory_budget = size_t{64} << 20;
+    // 1 回のマージでまとめるランの数 (2 以上)
+    size_t fan_in = 16;
+    // ランを書き出す一時ディレクトリ
+    std::filesystem::path temp_directory = std::filesystem::temp_directory_path();
+};
+
+struct ExternalSortStats {
+    size_t records = 0;
+    // 最初に作ったソート済みランの数
+    size_t runs = 0;
+    // ランをマージした段数 (最後の出力への書き出しを含む)
+    size_t merge_passes = 0;
+};
+
+namespace detail::external {
+
+// ストリームから out の大きさまでレコードを読み込み、読めた件数を返す
+template <FixedSizeRecord T>
+size_t read_records(std::ifstream& stream, std::span<T> out) {
+    stream.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size_bytes()));
+    const auto bytes = static_cast<size_t>(stream.gcount());
+    if (bytes % sizeof(T) != 0) {
+        throw std::runtime_error("external_sort: file size is not a multiple of the record size");
+    }
+    return bytes / sizeof(T);
+}
+
+template <FixedSizeRecord T>
+void write_records(std::ofstream& stream, std::span<const T> records) {
+    stream.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size_bytes()));
+    if (!stream) {
+        throw std::runtime_error("external_sort: failed to write records");
+    }
+}
+
+inline std::ifstream open_input(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("external_sort: cannot open " + path.string());
+    }
+    return stream;
+}
+
+inline std::ofstream open_output(const std::filesystem::path& path) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        throw std::runtime_error("external_sort: cannot create " + path.string());
+    }
+    return stream;
+}
+
+}  // namespace detail::external
+
+// 固定長レコードのファイルを buffer_records 件ずつまとめて読み込みながら、1 件ずつ取り出す
+template <FixedSizeRecord T>
+class RecordReader {
+public:
+    RecordReader(const std::filesystem::path& path, size_t buffer_records)
+        : stream_(detail::external::open_input(path)),
+          capacity_(std::max<size_t>(buffer_records, 1)),
+          buffer_(std::make_unique_for_overwrite<T[]>(capacity_)) {
+        fill();
+    }
+
+    bool has_value() const { return position_ < size_; }
+    const T& value() const { return buffer_[position_]; }
+
+    void advance() {
+        if (++position_ == size_) {
+            fill();
+        }
+    }
+
+private:
+    void fill() {
+        size_ = detail::external::read_records(stream_, std::span(buffer_.get(), capacity_));
+        position_ = 0;
+    }
+
+    std::ifstream stream_;
+    size_t capacity_;
+    std::unique_ptr<T[]> buffer_;
+    size_t size_ = 0;
+    size_t position_ = 0;
+};
+
+// 固定長レコードを 1 件ずつ受け取り、buffer_records 件たまるごとにファイルへ書き出す
+template <FixedSizeRecord T>
+class RecordWriter {
+public:
+    RecordWriter(const std::filesystem::path& path, size_t buffer_records)
+        : stream_(detail::external::open_output(path)),
+          capacity_(std::max<size_t>(buffer_records, 1)),
+          buffer_(std::make_unique_for_overwrite<T[]>(capacity_)) {}
+
+    void push(const T& record) {
+        buffer_[size_++] = record;
+        if (size_ == capacity_) {
+            flush();
+        }
+    }
+
+    // 残りを書き出してファイルを閉じる。書き込みに失敗していれば例外を投げる
+    void close() {
+        flush();
+        stream_.close();
+        if (!stream_) {
+            throw std::runtime_error("external_sort: failed to close output");
+        }
+    }
+
+private:
+    void flush() {
+        detail::external::write_records(stream_, std::span<const T>(buffer_.get(), size_));
+        size_ = 0;
+    }
+
+    std::ofstream stream_;
+    size_t capacity_;
+    std::unique_ptr<T[]> buffer_;
+    size_t size_ = 0;
+};
+
+namespace detail::external {
+
+// 敗者木 (トーナメント木)。各内部節点に試合の敗者を、根の上 (tree_[0]) に勝者を置く。
+// 勝者の入力を 1 件進めたら、その葉から根までの log k 回の比較だけで次の勝者が決まる。
+// better(a, b) は入力 a の先頭が入力 b の先頭より先に出力されるべきなら true を返す
+template <typename Better>
+class LoserTree {
+public:
+    LoserTree(size_t k, Better better) : k_(k), tree_(std::max<size_t>(k, 1)), better_(std::move(better)) {
+        tree_[0] = k_ == 1 ? 0 : build(1);
+    }
+
+    size_t winner() const { return tree_[0]; }
+
+    // 勝者の入力が進んだ (または尽きた) 後に呼び、勝者を決め直す
+    void replay() {
+        auto winner = tree_[0];
+        for (auto node = (winner + k_) / 2; node >= 1; node /= 2) {
+            if (better_(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+private:
+    // 葉 i は節点 k + i。節点 node を根とする部分木の勝者を返し、敗者を tree_[node] に残す
+    size_t build(size_t node) {
+        if (node >= k_) {
+            return node - k_;
+        }
+        auto left = build(2 * node);
+        auto right = build(2 * node + 1);
+        if (better_(right, left)) {
+            std::swap(left, right);
+        }
+        tree_[node] = right;
+        return left;
+    }
+
+    size_t k_;
+    std::vector<size_t> tree_;
+    Better better_;
+};
+
+// 一時ファイル。破棄時に削除する
+class TempFile {
+public:
+    explicit TempFile(std::filesystem::path path) : path_(std::move(path)) {}
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+    TempFile(TempFile&& other) noexcept : path_(std::exchange(other.path_, {})) {}
+    TempFile& operator=(TempFile&& other) noexcept {
+        if (this != &other) {
+            remove();
+            path_ = std::exchange(other.path_, {});
+        }
+        return *this;
+    }
+    ~TempFile() { remove(); }
+
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    void remove() {
+        if (!path_.empty()) {
+            std::error_code ignored;
+            std::filesystem::remove(path_, ignored);
+        }
+    }
+
+    std::filesystem::path path_;
+};
+
+class TempFileFactory {
+public:
+    explicit TempFileFactory(std::filesystem::path directory)
+        : directory_(std::move(directory)), prefix_("algorithm_samples_" + std::to_string(std::random_device{}())) {}
+
+    TempFile create() { return TempFile(directory_ / (prefix_ + "_" + std::to_string(next_id_++) + ".run")); }
+
+private:
+    std::filesystem::path directory_;
+    std::string prefix_;
+    size_t next_id_ = 0;
+};
+
+// ソート済みの runs を敗者木で output へ k-way マージする
+template <FixedSizeRecord T, typename Comparator>
+void merge_runs(std::span<const TempFile> runs, const std::filesystem::path& output, size_t buffer_records,
+                Comparator& comparator) {
+    std::vector<RecordReader<T>> readers;
+    readers.reserve(runs.size());
+    for (const auto& run : runs) {
+        readers.emplace_back(run.path(), buffer_records);
+    }
+    RecordWriter<T> writer(output, buffer_records);
+
+    // 尽きた入力は常に負ける。値が等しければ前のランを優先する
+    LoserTree tree(readers.size(), [&](size_t a, size_t b) {
+        if (!readers[a].has_value()) {
+            return false;
+        }
+        if (!readers[b].has_value()) {
+            return true;
+        }
+        if (comparator(readers[a].value(), readers[b].value())) {
+            return true;
+        }
+        return !comparator(readers[b].value(), readers[a].value()) && a < b;
+    });
+
+    for (auto winner = tree.winner(); readers[winner].has_value(); winner = tree.winner()) {
+        writer.push(readers[winner].value());
+        readers[winner].advance();
+        tree.replay();
+    }
+    writer.close();
+}
+
+}  // namespace detail::external
+
+// 固定長レコードのファイル input をソートして output に書き出す (外部マージソート)。
+// memory_budget に収まる長さずつ読み込んで pdq_sort でソートしたランを一時ファイルに書き出し、
+// fan_in 本ずつ敗者木でマージする。ランが fan_in 本を超える間は中間ファイルへのマージを繰り返す。
+// input と output は同じパスでもよい。入出力に失敗した場合は std::runtime_error を投げる
+template <FixedSizeRecord T, typename Comparator = std::less<>, typename Projection = std::identity>
+ExternalSortStats external_sort(const std::filesystem::path& input, const std::filesystem::path& output,
+                                Comparator comparator = {}, Projection projection = {},
+                                const ExternalSortOptions& options = {}) {
+    if (options.fan_in < 2) {
+        throw std::invalid_argument("external_sort: fan_in must be at least 2");
+    }
+    const size_t run_capacity = std::max<size_t>(options.memory_budget / sizeof(T), 1);
+    // マージ中は fan_in 本の入力と 1 本の出力でメモリを分け合う
+    const size_t merge_buffer = std::max<size_t>(run_capacity / (options.fan_in + 1), 1);
+
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    ExternalSortStats stats;
+    detail::external::TempFileFactory temp_files(options.temp_directory);
+    std::vector<detail::external::TempFile> runs;
+    {
+        auto stream = detail::external::open_input(input);
+        auto chunk = std::make_unique_for_overwrite<T[]>(run_capacity);
+        while (true) {
+            const auto count = detail::external::read_records(stream, std::span(chunk.get(), run_capacity));
+            if (count == 0) {
+                break;
+            }
+            pdq_sort(chunk.get(), chunk.get() + count, compare);
+            stats.records += count;
+            ++stats.runs;
+
+            const std::span<const T> records(chunk.get(), count);
+            if (runs.empty() && stream.peek() == std::ifstream::traits_type::eof()) {
+                // メモリに収まったので、マージせずにそのまま書き出す
+                stream.close();
+                auto out = detail::external::open_output(output);
+                detail::external::write_records(out, records);
+                return stats;
+            }
+            runs.push_back(temp_files.create());
+            auto out = detail::external::open_output(runs.back().path());
+            detail::external::write_records(out, records);
+        }
+    }
+    if (runs.empty()) {
+        detail::external::open_output(output);
+        return stats;
+    }
+
+    while (runs.size() > options.fan_in) {
+        std::vector<detail::external::TempFile> merged;
+        for (size_t i = 0; i < runs.size(); i += options.fan_in) {
+            const auto group = std::span(runs).subspan(i, std::min(options.fan_in, runs.size() - i));
+            if (group.size() == 1) {
+                merged.push_back(std::move(group.front()));
+                continue;
+            }
+            merged.push_back(temp_files.create());
+            detail::external::merge_runs<T>(group, merged.back().path(), merge_buffer, compare);
+        }
+        runs = std::move(merged);
+        ++stats.merge_passes;
+    }
+    detail::external::merge_runs<T>(runs, output, merge_buffer, compare);
+    ++stats.merge_passes;
+    return stats;
+}
+
+}  // namespace AlgorithmSamples::Sort
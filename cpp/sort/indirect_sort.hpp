@@ -0,0 +1,203 @@
+﻿#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "sort/pdq_sort.hpp"
+#include "sort/projection.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// 要素がこのバイト数を超えたら、交換のたびに要素を動かすソート
+// (bubble_sort, shaker_sort, selection_sort, odd_even_sort) は
+// 自動的に (キーの先頭, 位置) の組の配列をソートしてから、要素を 1 回ずつ動かして並べ替える。
+// その組の配列を 1 回確保するので、これらのソートが作業領域を確保しないのはこのバイト数以下の要素だけ
+inline constexpr std::size_t INDIRECT_SORT_THRESHOLD = 64;
+
+// 型ごとに間接ソートへの自動切り替えを有効にするかどうか。特殊化して切り替えを止めたり、小さい型で有効にしたりできる
+template <typename T>
+inline constexpr bool enable_indirect_sort = sizeof(T) > INDIRECT_SORT_THRESHOLD && std::is_move_constructible_v<T>;
+
+namespace detail::indirect {
+
+// index_at(i) は i 番目に来るべき要素の元の位置への参照を返す
+template <typename Iterator, typename IndexAt, typename Result>
+void apply_permutation(Iterator begin, std::size_t size, IndexAt index_at, Result& loopCount) {
+    for (std::size_t i = 0; i < size; ++i) {
+        if (static_cast<std::size_t>(index_at(i)) == i) {
+            continue;
+        }
+        auto value = std::move(begin[static_cast<std::ptrdiff_t>(i)]);
+        auto hole = i;
+        while (true) {
+            auto& index = index_at(hole);
+            const auto source = static_cast<std::size_t>(index);
+            index = static_cast<std::remove_reference_t<decltype(index)>>(hole);
+            ++loopCount;
+            if (source == i) {
+                begin[static_cast<std::ptrdiff_t>(hole)] = std::move(value);
+                break;
+            }
+            begin[static_cast<std::ptrdiff_t>(hole)] = std::move(begin[static_cast<std::ptrdiff_t>(source)]);
+            hole = source;
+        }
+    }
+}
+
+template <typename Comparator>
+concept StandardOrder = std::same_as<Comparator, std::less<>> || std::same_as<Comparator, std::greater<>>;
+
+// 組に持たせるキーの先頭部分の種類
+enum class PrefixKind {
+    None,    // 持たない。比較のたびに元の要素を参照する
+    Exact,   // 算術型のキーそのもの。元の要素を参照せずに比較が済む
+    String,  // 文字列の先頭 8 バイト (ビッグエンディアン)。等しいときだけ元の要素を参照する
+};
+
+template <typename Key, typename Comparator>
+inline constexpr PrefixKind prefix_kind =
+    std::is_arithmetic_v<Key> &&
+            (StandardOrder<Comparator> || std::same_as<Comparator, std::less<Key>> ||
+             std::same_as<Comparator, std::greater<Key>>)
+        ? PrefixKind::Exact
+    : (std::same_as<Key, std::string> || std::same_as<Key, std::string_view>) && StandardOrder<Comparator>
+        ? PrefixKind::String
+        : PrefixKind::None;
+
+// 先頭 8 バイトを上位から詰めた整数。整数として比べた大小が、文字列の (unsigned char での) 辞書順と矛盾しない
+inline uint64_t string_prefix(std::string_view text) {
+    uint64_t prefix = 0;
+    const auto length = std::min<std::size_t>(text.size(), 8);
+    for (std::size_t i = 0; i < length; ++i) {
+        prefix |= uint64_t{static_cast<unsigned char>(text[i])} << (56 - 8 * i);
+    }
+    return prefix;
+}
+
+template <typename Prefix, typename Index>
+struct PrefixedIndex {
+    Prefix prefix;
+    Index index;
+};
+
+template <typename Index>
+struct PlainIndex {
+    Index index;
+};
+
+// (キーの先頭, 位置) の組の配列を作り、fn(組の配列, 組の比較関数, 組の射影) を呼んでその戻り値を返す。
+// 算術型のキーは (comparator, &Entry::prefix) を渡すので、pdq_sort の分岐なし分割がそのまま効く
+template <typename Index, typename Iterator, typename Comparator, typename Projection, typename Fn>
+auto with_entries(Iterator begin, Iterator end, Comparator& comparator, Projection& projection, Fn&& fn) {
+    using Key = projected_key_t<Iterator, Projection>;
+    constexpr auto kind = prefix_kind<Key, Comparator>;
+    const auto size = static_cast<std::size_t>(end - begin);
+    auto compare = make_projected_comparator(comparator, projection);
+    auto element = [begin](std::size_t index) -> decltype(auto) { return begin[static_cast<std::ptrdiff_t>(index)]; };
+
+    if constexpr (kind == PrefixKind::None) {
+        std::vector<PlainIndex<Index>> entries(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            entries[i].index = static_cast<Index>(i);
+        }
+        auto entry_compare = [&](const PlainIndex<Index>& a, const PlainIndex<Index>& b) {
+            return compare(element(a.index), element(b.index));
+        };
+        return fn(entries, entry_compare, std::identity());
+    } else {
+        using Prefix = std::conditional_t<kind == PrefixKind::Exact, Key, uint64_t>;
+        using Entry = PrefixedIndex<Prefix, Index>;
+        std::vector<Entry> entries;
+        entries.reserve(size);
+        Index index = 0;
+        for (auto it = begin; it != end; ++it) {
+            if constexpr (kind == PrefixKind::Exact) {
+                entries.push_back({std::invoke(projection, *it), index++});
+            } else {
+                entries.push_back({string_prefix(std::invoke(projection, *it)), index++});
+            }
+        }
+        if constexpr (kind == PrefixKind::Exact) {
+            return fn(entries, comparator, &Entry::prefix);
+        } else {
+            auto entry_compare = [&](const Entry& a, const Entry& b) {
+                if (a.prefix != b.prefix) {
+                    return comparator(a.prefix, b.prefix);
+                }
+                return compare(element(a.index), element(b.index));
+            };
+            return fn(entries, entry_compare, std::identity());
+        }
+    }
+}
+
+// 組の配列を sorter でソートし、要素の順序を組の順序に揃える。
+// sorter は (first, last, 組の比較関数, 組の射影) を受け取るソートで、その戻り値をそのまま返す
+template <typename Iterator, typename Comparator, typename Projection, typename Sorter>
+auto sort_indirect(Iterator begin, Iterator end, Comparator& comparator, Projection& projection, Sorter sorter) {
+    auto sort_and_apply = [&](auto& entries, auto entry_compare, auto entry_projection) {
+        auto result = sorter(entries.begin(), entries.end(), entry_compare, entry_projection);
+        std::size_t moves = 0;
+        apply_permutation(
+            begin, entries.size(), [&](std::size_t i) -> auto& { return entries[i].index; }, moves);
+        return result;
+    };
+    if (static_cast<std::size_t>(end - begin) <= std::numeric_limits<uint32_t>::max()) {
+        return with_entries<uint32_t>(begin, end, comparator, projection, sort_and_apply);
+    }
+    return with_entries<std::size_t>(begin, end, comparator, projection, sort_and_apply);
+}
+
+}  // namespace detail::indirect
+
+// order[i] 番目の要素が i 番目に来るように [begin, begin + order.size()) をその場で並べ替える。
+// 巡回置換ごとに要素を 1 回ずつムーブする。order はたどり終えた印に使うので、終了時には 0, 1, 2, ... になる
+template <std::random_access_iterator Iterator, std::integral Index>
+void apply_permutation(Iterator begin, std::span<Index> order) {
+    std::size_t ignored = 0;
+    detail::indirect::apply_permutation(begin, order.size(), [&](std::size_t i) -> Index& { return order[i]; },
+                                        ignored);
+}
+
+// 間接ソート。(キーの先頭, 位置) の詰まった配列を pdq_sort でソートしてから、要素を巡回置換に沿って 1 回ずつ動かす。
+// 算術型のキーは組に丸ごと持たせ、std::string / std::string_view のキーは先頭 8 バイトで比べて等しいときだけ
+// 元の要素を参照する。それ以外のキーは位置だけを持ち、比較のたびに元の要素を参照する。
+// 要素が大きいほど、ソート中に動かすのが 8〜16 バイトの組だけで済む効果が大きい。安定ソートではない
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+Result indirect_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {}) {
+    if (end - begin < 2) {
+        return 0;
+    }
+    auto sorter = [](auto first, auto last, auto compare, auto key) {
+        return pdq_sort<decltype(first), decltype(compare), Result>(first, last, compare, key);
+    };
+    return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
+}
+
+// 並べ替えた後に i 番目に来る要素の元の位置を返す。要素は動かさない。
+// 返した順序は apply_permutation で要素に適用できる
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, typename Projection = std::identity>
+std::vector<std::size_t> sort_permutation(Iterator begin, Iterator end, Comparator comparator = {},
+                                          Projection projection = {}) {
+    return detail::indirect::with_entries<std::size_t>(
+        begin, end, comparator, projection, [](auto& entries, auto entry_compare, auto entry_projection) {
+            pdq_sort(entries.begin(), entries.end(), entry_compare, entry_projection);
+            std::vector<std::size_t> order(entries.size());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                order[i] = entries[i].index;
+            }
+            return order;
+        });
+}
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,95 @@
+﻿#pragma once
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace AlgorithmSamples::Sort {
+
+// ソート中に発生した操作の回数
+struct OperationCounts {
+    size_t comparisons = 0;  // 比較
+    size_t swaps = 0;        // 交換
+    size_t moves = 0;        // 交換以外のムーブ・コピー
+    size_t writes = 0;       // 要素への書き込み (交換は 2 回と数える)
+
+    constexpr bool operator==(const OperationCounts&) const = default;
+};
+
+// 現在のスレッドでの操作回数。計測前に reset_operation_counts() で 0 に戻す
+inline OperationCounts& operation_counts() {
+    thread_local OperationCounts counts;
+    return counts;
+}
+
+inline void reset_operation_counts() { operation_counts() = {}; }
+
+// 比較・交換・ムーブを数える要素ラッパー。
+// ソート本体は std::ranges::iter_swap で交換するので、ここで定義した swap が ADL で選ばれる。
+// 計測しない場合は素の型を使えばよく、ソート本体には一切のオーバーヘッドがかからない。
+template <typename T>
+class Counted {
+public:
+    Counted() = default;
+    Counted(T value) : value_(std::move(value)) {}
+
+    Counted(const Counted& other) : value_(other.value_) { ++operation_counts().moves; }
+    Counted(Counted&& other) noexcept : value_(std::move(other.value_)) { ++operation_counts().moves; }
+
+    Counted& operator=(const Counted& other) {
+        value_ = other.value_;
+        ++operation_counts().moves;
+        ++operation_counts().writes;
+        return *this;
+    }
+
+    Counted& operator=(Counted&& other) noexcept {
+        value_ = std::move(other.value_);
+        ++operation_counts().moves;
+        ++operation_counts().writes;
+        return *this;
+    }
+
+    ~Counted() = default;
+
+    const T& value() const { return value_; }
+
+    friend void swap(Counted& a, Counted& b) noexcept(std::is_nothrow_swappable_v<T>) {
+        using std::swap;
+        swap(a.value_, b.value_);
+        ++operation_counts().swaps;
+        operation_counts().writes += 2;
+    }
+
+    friend auto operator<=>(const Counted& a, const Counted& b) {
+        ++operation_counts().comparisons;
+        return a.value_ <=> b.value_;
+    }
+
+    friend bool operator==(const Counted& a, const Counted& b) {
+        ++operation_counts().comparisons;
+        return a.value_ == b.value_;
+    }
+
+private:
+    T value_{};
+};
+
+// 任意の比較関数を包み、呼び出し回数を数える
+template <typename Comparator>
+struct CountingComparator {
+    Comparator comparator;
+
+    template <typename A, typename B>
+    bool operator()(A&& a, B&& b) const {
+        ++operation_counts().comparisons;
+        return std::invoke(comparator, std::forward<A>(a), std::forward<B>(b));
+    }
+};
+
+template <typename Comparator>
+CountingComparator(Comparator) -> CountingComparator<Comparator>;
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,146 @@
+﻿#pragma once
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include "sort/pdq_sort.hpp"
+#include "sort/projection.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+namespace detail::select {
+
+// 標本から選んだピボットで分割してよい要素数の合計 (入力の要素数に対する倍率)。
+// ランダムな入力では平均 2n 程度で終わるので、これを超えるのは分割が偏り続けたときだけ
+inline constexpr std::ptrdiff_t SAMPLED_PIVOT_WORK_FACTOR = 4;
+
+template <bool Branchless, typename Iterator, typename Comparator, typename Result>
+constexpr void intro_select_loop(Iterator begin, Iterator nth, Iterator end, Comparator& comparator,
+                                 std::ptrdiff_t work_allowed, bool leftmost, Result& loopCount);
+
+// 5 要素ずつの組の中央値を先頭に集め、その中央値 (median of medians) を選んで begin に置く。
+// このピボットより小さい要素と大きい要素はそれぞれ 3/10 程度以上あることが保証される
+template <bool Branchless, typename Iterator, typename Comparator, typename Result>
+constexpr void median_of_medians(Iterator begin, Iterator end, Comparator& comparator, Result& loopCount) {
+    auto medians = begin;
+    for (auto group = begin; end - group >= 5; group += 5) {
+        pdq::insertion_sort(group, group + 5, comparator, loopCount);
+        std::ranges::iter_swap(medians++, group + 2);
+    }
+    const auto mid = begin + (medians - begin) / 2;
+    intro_select_loop<Branchless>(begin, mid, medians, comparator, 0, true, loopCount);
+    std::ranges::iter_swap(begin, mid);
+}
+
+// pdq_sort_loop と同じ分割を使い、nth を含む側だけを処理し続ける。
+// 標本から選んだピボットで分割した要素数の合計が work_allowed を超えたら、以降は median of medians で
+// ピボットを選ぶ。分割 1 回は範囲の要素数に比例するので、切り替えまでの処理は work_allowed + n で抑えられ、
+// 切り替えた後も線形時間なので、全体で O(n) になる
+template <bool Branchless, typename Iterator, typename Comparator, typename Result>
+constexpr void intro_select_loop(Iterator begin, Iterator nth, Iterator end, Comparator& comparator,
+                                 std::ptrdiff_t work_allowed, bool leftmost, Result& loopCount) {
+    while (true) {
+        const auto size = end - begin;
+
+        if (size < pdq::INSERTION_SORT_THRESHOLD) {
+            if (leftmost) {
+                pdq::insertion_sort(begin, end, comparator, loopCount);
+            } else {
+                pdq::unguarded_insertion_sort(begin, end, comparator, loopCount);
+            }
+            return;
+        }
+
+        // ピボットを begin に置く
+        const bool sampled = work_allowed > 0;
+        if (!sampled) {
+            median_of_medians<Branchless>(begin, end, comparator, loopCount);
+        } else if (const auto half = size / 2; size > pdq::NINTHER_THRESHOLD) {
+            pdq::sort3(begin, begin + half, end - 1, comparator);
+            pdq::sort3(begin + 1, begin + (half - 1), end - 2, comparator);
+            pdq::sort3(begin + 2, begin + (half + 1), end - 3, comparator);
+            pdq::sort3(begin + (half - 1), begin + half, begin + (half + 1), comparator);
+            std::ranges::iter_swap(begin, begin + half);
+        } else {
+            pdq::sort3(begin + half, begin, end - 1, comparator);
+        }
+
+        // 左隣 (前回のピボット) とピボットが等しければ、ピボットと等しい要素をまとめて確定させる
+        if (!leftmost && !comparator(*std::prev(begin), *begin)) {
+            const auto equal_end = std::next(pdq::partition_left(begin, end, comparator, loopCount));
+            if (nth < equal_end) {
+                return;
+            }
+            begin = equal_end;
+            continue;
+        }
+
+        std::pair<Iterator, bool> part;
+        if constexpr (Branchless) {
+            part = pdq::partition_right_branchless(begin, end, comparator, loopCount);
+        } else {
+            part = pdq::partition_right(begin, end, comparator, loopCount);
+        }
+        const auto pivot_pos = part.first;
+        if (pivot_pos == nth) {
+            return;
+        }
+
+        const auto l_size = pivot_pos - begin;
+        const auto r_size = end - std::next(pivot_pos);
+        if (sampled) {
+            work_allowed -= size;
+            if (work_allowed > 0 && (l_size < size / 8 || r_size < size / 8)) {
+                pdq::break_patterns(begin, pivot_pos, end);
+            }
+        }
+
+        if (nth < pivot_pos) {
+            end = pivot_pos;
+        } else {
+            begin = std::next(pivot_pos);
+            leftmost = false;
+        }
+    }
+}
+
+}  // namespace detail::select
+
+// introselect による nth_element。
+// nth の位置にソートしたときと同じ要素を置き、それより前にはそれ以下、後ろにはそれ以上の要素を集める。
+// pdq_sort と同じピボット選択と分割で片側だけを処理するので平均 O(n)。分割した要素数の合計が
+// 入力の SAMPLED_PIVOT_WORK_FACTOR 倍を超えたら median of medians に切り替えるため、最悪でも O(n)。
+// std::nth_element と名前を変えているのは、std のイテレータを渡したときに ADL で呼び出しが曖昧になるため
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr Result intro_select(Iterator begin, Iterator nth, Iterator end, Comparator comparator = {},
+                              Projection projection = {}) {
+    if (nth == end || std::next(begin) == end) {
+        return 0;
+    }
+
+    Result loopCount = 0;
+    const auto work_allowed = detail::select::SAMPLED_PIVOT_WORK_FACTOR * (end - begin);
+
+    constexpr bool branchless =
+        detail::pdq::use_branchless_partition<projected_key_t<Iterator, Projection>, Comparator>;
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    detail::select::intro_select_loop<branchless>(begin, nth, end, compare, work_allowed, true, loopCount);
+    return loopCount;
+}
+
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> intro_select(const std::array<T, N>& input, std::size_t nth,
+                                                            Comparator comparator = {}, Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto loopCount = intro_select(arr.begin(), arr.begin() + nth, arr.end(), comparator, projection);
+    return std::make_tuple(arr, loopCount);
+}
+
+static_assert(std::get<0>(intro_select(std::array{5, 3, 1, 4, 2}, 2))[2] == 3);
+static_assert(std::get<0>(intro_select(std::array{5, 3, 1, 4, 2}, 0, std::greater<>()))[0] == 5);
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,300 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "sort/projection.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace AlgorithmSamples::Sort {
+
+// ソーティングネットワークで扱う最大要素数
+inline constexpr std::size_t MAX_NETWORK_SIZE = 64;
+
+// 添字 a, b の要素を比較し、小さい方を a、大きい方を b に置く
+struct CompareExchange {
+    uint8_t a;
+    uint8_t b;
+};
+
+namespace detail::network {
+
+// Batcher の merge-exchange (Knuth, TAOCP 5.2.2 Algorithm M)。任意の N で正しいネットワークを作る。
+// emit(a, b) が比較交換ごとに呼ばれる
+template <typename Emit>
+constexpr void batcher_merge_exchange(std::size_t n, Emit emit) {
+    if (n < 2) {
+        return;
+    }
+    std::size_t t = 0;
+    while ((std::size_t{1} << t) < n) {
+        ++t;
+    }
+    for (std::size_t p = std::size_t{1} << (t - 1); p > 0; p >>= 1) {
+        std::size_t q = std::size_t{1} << (t - 1);
+        std::size_t r = 0;
+        std::size_t d = p;
+        while (true) {
+            for (std::size_t i = 0; i + d < n; ++i) {
+                if ((i & p) == r) {
+                    emit(i, i + d);
+                }
+            }
+            if (q == p) {
+                break;
+            }
+            d = q - p;
+            q >>= 1;
+            r = p;
+        }
+    }
+}
+
+// Batcher より比較回数が少ない、既知の最適ネットワーク
+inline constexpr CompareExchange OPTIMAL_5[] = {{0, 1}, {3, 4}, {2, 4}, {2, 3}, {0, 3},
+                                                {0, 2}, {1, 4}, {1, 3}, {1, 2}};
+inline constexpr CompareExchange OPTIMAL_6[] = {{1, 2}, {4, 5}, {0, 2}, {3, 5}, {0, 1}, {3, 4},
+                                                {2, 5}, {0, 3}, {1, 4}, {2, 4}, {1, 3}, {2, 3}};
+inline constexpr CompareExchange OPTIMAL_7[] = {{1, 2}, {3, 4}, {5, 6}, {0, 2}, {3, 5}, {4, 6}, {0, 1}, {4, 5},
+                                                {2, 6}, {0, 4}, {1, 5}, {0, 3}, {2, 5}, {1, 3}, {2, 4}, {2, 3}};
+
+template <std::size_t N>
+constexpr std::size_t network_size() {
+    if constexpr (N == 5) {
+        return std::size(OPTIMAL_5);
+    } else if constexpr (N == 6) {
+        return std::size(OPTIMAL_6);
+    } else if constexpr (N == 7) {
+        return std::size(OPTIMAL_7);
+    } else {
+        std::size_t count = 0;
+        batcher_merge_exchange(N, [&](std::size_t, std::size_t) { ++count; });
+        return count;
+    }
+}
+
+template <std::size_t N>
+constexpr auto make_network() {
+    std::array<CompareExchange, network_size<N>()> network{};
+    if constexpr (N == 5) {
+        std::ranges::copy(OPTIMAL_5, network.begin());
+    } else if constexpr (N == 6) {
+        std::ranges::copy(OPTIMAL_6, network.begin());
+    } else if constexpr (N == 7) {
+        std::ranges::copy(OPTIMAL_7, network.begin());
+    } else {
+        std::size_t k = 0;
+        batcher_merge_exchange(N, [&](std::size_t a, std::size_t b) {
+            network[k++] = {static_cast<uint8_t>(a), static_cast<uint8_t>(b)};
+        });
+    }
+    return network;
+}
+
+// 比較結果で値を選ぶだけにして、算術型では cmov / min・max 命令になるようにする
+template <typename Iterator, typename Comparator>
+constexpr void compare_exchange(Iterator a, Iterator b, Comparator& comparator) {
+    if constexpr (std::is_arithmetic_v<std::iter_value_t<Iterator>>) {
+        const auto x = *a;
+        const auto y = *b;
+        const bool swap = comparator(y, x);
+        *a = swap ? y : x;
+        *b = swap ? x : y;
+    } else if (comparator(*b, *a)) {
+        std::ranges::iter_swap(a, b);
+    }
+}
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+
+// 複数の配列の同じ添字の要素を 1 本のレジスタのレーンに並べ、比較交換を一度に行う。
+// 整数は min / max で、浮動小数点数は比較のマスクで選ぶ (min / max は NaN や ±0 で第 2 引数を返し、
+// 要素が並べ替えにならなくなるため)
+template <typename T>
+struct SimdLanes;
+
+#if defined(__AVX2__)
+template <>
+struct SimdLanes<int32_t> {
+    using Register = __m256i;
+    static constexpr std::size_t WIDTH = 8;
+    template <std::size_t N>
+    static Register load_column(const int32_t* base, std::size_t j) {
+        const auto index = _mm256_setr_epi32(0, N, 2 * N, 3 * N, 4 * N, 5 * N, 6 * N, 7 * N);
+        return _mm256_i32gather_epi32(base + j, index, sizeof(int32_t));
+    }
+    static constexpr bool TOTAL_ORDER = true;
+    static Register min(Register a, Register b) { return _mm256_min_epi32(a, b); }
+    static Register max(Register a, Register b) { return _mm256_max_epi32(a, b); }
+    static void store(int32_t* out, Register r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), r); }
+};
+
+template <>
+struct SimdLanes<float> {
+    using Register = __m256;
+    static constexpr std::size_t WIDTH = 8;
+    template <std::size_t N>
+    static Register load_column(const float* base, std::size_t j) {
+        const auto index = _mm256_setr_epi32(0, N, 2 * N, 3 * N, 4 * N, 5 * N, 6 * N, 7 * N);
+        return _mm256_i32gather_ps(base + j, index, sizeof(float));
+    }
+    static constexpr bool TOTAL_ORDER = false;
+    static Register less(Register a, Register b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    // mask が立っているレーンは a、それ以外は b から取る
+    static Register select(Register mask, Register a, Register b) { return _mm256_blendv_ps(b, a, mask); }
+    static void store(float* out, Register r) { _mm256_storeu_ps(out, r); }
+};
+#else
+template <>
+struct SimdLanes<int32_t> {
+    using Register = __m128i;
+    static constexpr std::size_t WIDTH = 4;
+    template <std::size_t N>
+    static Register load_column(const int32_t* base, std::size_t j) {
+        return _mm_setr_epi32(base[j], base[N + j], base[2 * N + j], base[3 * N + j]);
+    }
+    static constexpr bool TOTAL_ORDER = true;
+    static Register min(Register a, Register b) { return _mm_min_epi32(a, b); }
+    static Register max(Register a, Register b) { return _mm_max_epi32(a, b); }
+    static void store(int32_t* out, Register r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r); }
+};
+
+template <>
+struct SimdLanes<float> {
+    using Register = __m128;
+    static constexpr std::size_t WIDTH = 4;
+    template <std::size_t N>
+    static Register load_column(const float* base, std::size_t j) {
+        return _mm_setr_ps(base[j], base[N + j], base[2 * N + j], base[3 * N + j]);
+    }
+    static constexpr bool TOTAL_ORDER = false;
+    static Register less(Register a, Register b) { return _mm_cmplt_ps(a, b); }
+    // mask が立っているレーンは a、それ以外は b から取る
+    static Register select(Register mask, Register a, Register b) { return _mm_blendv_ps(b, a, mask); }
+    static void store(float* out, Register r) { _mm_storeu_ps(out, r); }
+};
+#endif
+
+template <typename Lanes, bool Descending>
+void simd_compare_exchange(typename Lanes::Register& a, typename Lanes::Register& b) {
+    if constexpr (Lanes::TOTAL_ORDER) {
+        const auto lo = Lanes::min(a, b);
+        const auto hi = Lanes::max(a, b);
+        a = Descending ? hi : lo;
+        b = Descending ? lo : hi;
+    } else {
+        // スカラーの compare_exchange と同じく、comparator(b, a) が真のレーンだけ入れ替える
+        const auto swap = Descending ? Lanes::less(a, b) : Lanes::less(b, a);
+        const auto first = Lanes::select(swap, b, a);
+        b = Lanes::select(swap, a, b);
+        a = first;
+    }
+}
+
+// WIDTH 個の連続した配列 (各 N 要素) をまとめてソートする
+template <std::size_t N, typename T, bool Descending>
+void simd_network_sort(T* base) {
+    using Lanes = SimdLanes<T>;
+    constexpr auto NETWORK = make_network<N>();
+
+    typename Lanes::Register columns[N];
+    for (std::size_t j = 0; j < N; ++j) {
+        columns[j] = Lanes::template load_column<N>(base, j);
+    }
+    // 添字を定数にするため展開する (レジスタに載せたままにできる)
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (simd_compare_exchange<Lanes, Descending>(columns[NETWORK[I].a], columns[NETWORK[I].b]), ...);
+    }(std::make_index_sequence<NETWORK.size()>{});
+
+    T transposed[N][Lanes::WIDTH];
+    for (std::size_t j = 0; j < N; ++j) {
+        Lanes::store(transposed[j], columns[j]);
+    }
+    for (std::size_t lane = 0; lane < Lanes::WIDTH; ++lane) {
+        for (std::size_t j = 0; j < N; ++j) {
+            base[lane * N + j] = transposed[j][lane];
+        }
+    }
+}
+
+template <typename T, typename Comparator>
+inline constexpr bool use_simd = (std::same_as<T, int32_t> || std::same_as<T, float>) &&
+                                 (std::same_as<Comparator, std::less<>> || std::same_as<Comparator, std::greater<>>);
+#else
+template <typename T, typename Comparator>
+inline constexpr bool use_simd = false;
+#endif
+
+}  // namespace detail::network
+
+// N 要素用のソーティングネットワーク (N <= 64)。
+// 5〜7 要素は既知の最適ネットワーク、それ以外は Batcher の merge-exchange をコンパイル時に生成する
+template <std::size_t N>
+    requires(N <= MAX_NETWORK_SIZE)
+inline constexpr auto SORTING_NETWORK = detail::network::make_network<N>();
+
+// [begin, begin + N) をソーティングネットワークでソートする。
+// 比較の順序が入力に依存しないので分岐予測に左右されず、算術型では分岐なしの min / max になる。
+// 戻り値は比較交換の回数 (ネットワークの大きさ)
+template <std::size_t N, std::random_access_iterator Iterator, typename Comparator = std::less<>,
+          std::integral Result = size_t, typename Projection = std::identity>
+    requires(N <= MAX_NETWORK_SIZE)
+constexpr Result network_sort(Iterator begin, Comparator comparator = {}, Projection projection = {}) {
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    for (const auto& [a, b] : SORTING_NETWORK<N>) {
+        detail::network::compare_exchange(begin + a, begin + b, compare);
+    }
+    return static_cast<Result>(SORTING_NETWORK<N>.size());
+}
+
+template <typename T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+    requires(N <= MAX_NETWORK_SIZE)
+constexpr std::tuple<std::array<T, N>, size_t> network_sort(const std::array<T, N>& input, Comparator comparator = {},
+                                                            Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto loopCount = network_sort<N>(arr.begin(), comparator, projection);
+    return std::make_tuple(arr, loopCount);
+}
+
+// data を N 要素ずつの独立した配列の並びとみなし、それぞれをソートする。
+// int32_t / float を std::less<> / std::greater<> でソートする場合は、AVX2 (8 配列) または
+// SSE4.1 (4 配列) のレーンに配列を割り当てて、比較交換を同時に行う (float も NaN や ±0 を含めてスカラーと同じ結果)。
+// それ以外の型や射影を指定した場合、SIMD 命令が有効でないビルドでは 1 配列ずつスカラーで処理する
+template <std::size_t N, typename T, typename Comparator = std::less<>, typename Projection = std::identity>
+    requires(N > 0 && N <= MAX_NETWORK_SIZE)
+constexpr void network_sort_batch(std::span<T> data, Comparator comparator = {}, Projection projection = {}) {
+    assert(data.size() % N == 0);
+    std::size_t i = 0;
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    if constexpr (detail::network::use_simd<T, Comparator> && std::same_as<Projection, std::identity>) {
+        if (!std::is_constant_evaluated()) {
+            constexpr auto WIDTH = detail::network::SimdLanes<T>::WIDTH;
+            constexpr bool DESCENDING = std::same_as<Comparator, std::greater<>>;
+            for (const auto count = data.size() / N; i + WIDTH <= count; i += WIDTH) {
+                detail::network::simd_network_sort<N, T, DESCENDING>(data.data() + i * N);
+            }
+        }
+    }
+#endif
+
+    for (auto it = data.begin() + static_cast<std::ptrdiff_t>(i * N); it != data.end(); it += N) {
+        network_sort<N>(it, comparator, projection);
+    }
+}
+
+static_assert(std::get<0>(network_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
+static_assert(std::get<0>(network_sort(std::array{5, 3, 1, 4, 2}, std::greater<>())) == std::array{5, 4, 3, 2, 1});
+
+}  // namespace AlgorithmSamples::Sort
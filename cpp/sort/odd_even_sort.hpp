@@ -0,0 +1,362 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "sort/indirect_sort.hpp"
+#include "sort/projection.hpp"
+#include "sort/sort_passes.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace AlgorithmSamples::Sort {
+
+namespace detail::odd_even {
+
+template <typename T, typename Compare>
+inline constexpr bool is_descending = std::same_as<Compare, std::greater<>> || std::same_as<Compare, std::greater<T>>;
+
+// 連続したメモリ上の算術型を標準の比較関数で比べる場合は、値を直接読んで分岐なし (SIMD) で比較交換する
+template <typename Iterator, typename Compare, typename T = std::iter_value_t<Iterator>>
+inline constexpr bool use_fast_exchange =
+    std::contiguous_iterator<Iterator> && std::is_arithmetic_v<T> &&
+    (std::same_as<Compare, std::less<>> || std::same_as<Compare, std::less<T>> || is_descending<T, Compare>);
+
+// 比較結果で値を選ぶだけにして、算術型では cmov になるようにする
+template <bool Descending, typename T>
+bool scalar_exchange_pairs(T* data, std::size_t pairs) {
+    bool swapped = false;
+    for (std::size_t i = 0; i < pairs; ++i) {
+        const auto a = data[2 * i];
+        const auto b = data[2 * i + 1];
+        const bool swap = Descending ? a < b : b < a;
+        data[2 * i] = swap ? b : a;
+        data[2 * i + 1] = swap ? a : b;
+        swapped |= swap;
+    }
+    return swapped;
+}
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+
+// 隣り合う 2 要素を組としてレジスタに載せ、組の中を入れ替えたレジスタと比べて、入れ替えるべき組のレーンを選ぶ。
+// min / max ではなく比較のマスクで選ぶので、±0 や NaN でもスカラーの比較交換と同じ結果になる
+template <typename T>
+struct PairLanes;
+
+#if defined(__AVX2__)
+struct PairMasks {
+    using Mask = __m256i;
+    // 偶数レーンを even、奇数レーンを odd から取る
+    static Mask interleave(Mask even, Mask odd) { return _mm256_blend_epi32(even, odd, 0b10101010); }
+    static Mask merge(Mask a, Mask b) { return _mm256_or_si256(a, b); }
+    static Mask none() { return _mm256_setzero_si256(); }
+    static bool any(Mask mask) { return !_mm256_testz_si256(mask, mask); }
+};
+
+template <>
+struct PairLanes<int32_t> : PairMasks {
+    using Register = __m256i;
+    static constexpr std::size_t WIDTH = 8;
+    static Register load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(int32_t* out, Register r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), r); }
+    static Register swap_adjacent(Register v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static Mask less(Register a, Register b) { return _mm256_cmpgt_epi32(b, a); }
+    static Register select(Mask mask, Register a, Register b) { return _mm256_blendv_epi8(b, a, mask); }
+};
+
+template <>
+struct PairLanes<float> : PairMasks {
+    using Register = __m256;
+    static constexpr std::size_t WIDTH = 8;
+    static Register load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* out, Register r) { _mm256_storeu_ps(out, r); }
+    static Register swap_adjacent(Register v) { return _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static Mask less(Register a, Register b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+    static Register select(Mask mask, Register a, Register b) {
+        return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask));
+    }
+};
+#else
+struct PairMasks {
+    using Mask = __m128i;
+    static Mask interleave(Mask even, Mask odd) { return _mm_blend_epi16(even, odd, 0b11001100); }
+    static Mask merge(Mask a, Mask b) { return _mm_or_si128(a, b); }
+    static Mask none() { return _mm_setzero_si128(); }
+    static bool any(Mask mask) { return !_mm_testz_si128(mask, mask); }
+};
+
+template <>
+struct PairLanes<int32_t> : PairMasks {
+    using Register = __m128i;
+    static constexpr std::size_t WIDTH = 4;
+    static Register load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(int32_t* out, Register r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r); }
+    static Register swap_adjacent(Register v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static Mask less(Register a, Register b) { return _mm_cmplt_epi32(a, b); }
+    static Register select(Mask mask, Register a, Register b) { return _mm_blendv_epi8(b, a, mask); }
+};
+
+template <>
+struct PairLanes<float> : PairMasks {
+    using Register = __m128;
+    static constexpr std::size_t WIDTH = 4;
+    static Register load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* out, Register r) { _mm_storeu_ps(out, r); }
+    static Register swap_adjacent(Register v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static Mask less(Register a, Register b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+    static Register select(Mask mask, Register a, Register b) { return _mm_blendv_ps(b, a, _mm_castsi128_ps(mask)); }
+};
+#endif
+
+template <typename T>
+inline constexpr bool has_pair_lanes = std::same_as<T, int32_t> || std::same_as<T, float>;
+
+// WIDTH / 2 組ずつ比較交換する。WIDTH / 2 組に満たない末尾はスカラーで続ける
+template <bool Descending, typename T>
+bool simd_exchange_pairs(T* data, std::size_t pairs) {
+    using Lanes = PairLanes<T>;
+    constexpr auto PAIRS_PER_REGISTER = Lanes::WIDTH / 2;
+
+    auto swapped = Lanes::none();
+    std::size_t i = 0;
+    for (; i + PAIRS_PER_REGISTER <= pairs; i += PAIRS_PER_REGISTER) {
+        T* p = data + 2 * i;
+        const auto v = Lanes::load(p);
+        // 偶数レーンは (a, b)、奇数レーンは (b, a) を比べる。組の後ろが前に来るべきなら入れ替える
+        const auto w = Lanes::swap_adjacent(v);
+        const auto swap = Descending ? Lanes::interleave(Lanes::less(v, w), Lanes::less(w, v))
+                                     : Lanes::interleave(Lanes::less(w, v), Lanes::less(v, w));
+        Lanes::store(p, Lanes::select(swap, w, v));
+        swapped = Lanes::merge(swapped, swap);
+    }
+    const bool tail = scalar_exchange_pairs<Descending>(data + 2 * i, pairs - i);
+    return Lanes::any(swapped) || tail;
+}
+
+#else
+template <typename T>
+inline constexpr bool has_pair_lanes = false;
+#endif
+
+// first から始まる pairs 組 (first[2i], first[2i + 1]) をそれぞれ比較交換し、交換したかを返す。
+// 組どうしは重ならないので、どの順に (同時に) 処理してもよい
+template <typename Iterator, typename Compare>
+constexpr bool exchange_pairs(Iterator first, std::size_t pairs, Compare& compare) {
+    if constexpr (use_fast_exchange<Iterator, Compare>) {
+        if (!std::is_constant_evaluated()) {
+            using T = std::iter_value_t<Iterator>;
+            constexpr bool DESCENDING = is_descending<T, Compare>;
+#if defined(__AVX2__) || defined(__SSE4_1__)
+            if constexpr (has_pair_lanes<T>) {
+                return simd_exchange_pairs<DESCENDING>(std::to_address(first), pairs);
+            }
+#endif
+            return scalar_exchange_pairs<DESCENDING>(std::to_address(first), pairs);
+        }
+    }
+    bool swapped = false;
+    for (std::size_t i = 0; i < pairs; ++i, first += 2) {
+        if (compare(first[1], first[0])) {
+            std::ranges::iter_swap(first, std::next(first));
+            swapped = true;
+        }
+    }
+    return swapped;
+}
+
+// size 要素の phase 番目のフェーズで比較交換する組の数 (偶数フェーズは (0, 1), (2, 3), ...、奇数フェーズは (1, 2), ...)
+constexpr std::size_t pairs_in_phase(std::size_t size, std::size_t phase) { return (size - phase % 2) / 2; }
+
+}  // namespace detail::odd_even
+
+// 奇偶転置ソート (odd-even transposition sort) を 1 フェーズずつ進める。
+// 偶数フェーズは (0, 1), (2, 3), ...、奇数フェーズは (1, 2), (3, 4), ... の重ならない組をすべて比較交換する。
+// n フェーズで必ずソートが終わり、続けて 2 フェーズ交換がなければそこで終える。
+// バブルソートと違って 1 フェーズの中の比較交換は互いに独立なので、SIMD のレーンやスレッドに分けられる
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+class OddEvenSortPasses {
+public:
+    constexpr OddEvenSortPasses(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {})
+        : begin_(begin),
+          size_(static_cast<size_t>(end - begin)),
+          compare_(detail::make_projected_comparator(std::move(comparator), std::move(projection))),
+          max_passes_(size_ < 2 ? 0 : size_) {}
+
+    constexpr bool done() const { return passCount_ == max_passes_ || quietPasses_ >= 2; }
+
+    constexpr void run_pass() {
+        const auto pairs = detail::odd_even::pairs_in_phase(size_, passCount_);
+        const auto first = begin_ + static_cast<std::ptrdiff_t>(passCount_ % 2);
+        const bool swapped = detail::odd_even::exchange_pairs(first, pairs, compare_);
+        quietPasses_ = swapped ? 0 : quietPasses_ + 1;
+        loopCount_ += static_cast<Result>(pairs);
+        ++passCount_;
+    }
+
+    constexpr Result loop_count() const { return loopCount_; }
+    constexpr size_t pass_count() const { return passCount_; }
+    constexpr size_t max_passes() const { return max_passes_; }
+    // どのフェーズも範囲全体を比較交換するので、終わるまで全体が未確定
+    constexpr std::pair<size_t, size_t> range() const { return {0, done() ? 0 : size_}; }
+
+private:
+    Iterator begin_;
+    size_t size_;
+    decltype(detail::make_projected_comparator(std::declval<Comparator>(), std::declval<Projection>())) compare_;
+    size_t max_passes_;
+    Result loopCount_ = 0;
+    size_t passCount_ = 0;
+    // 続けて交換のなかったフェーズの数
+    size_t quietPasses_ = 0;
+};
+
+// 戻り値は比較回数 (比較交換した組の数の合計)
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr Result odd_even_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {}) {
+    if (begin == end || std::next(begin) == end) {
+        return 0;
+    }
+
+    // 大きな要素は交換のたびに動かさず、(キーの先頭, 位置) の組を同じ手順でソートしてから 1 回ずつ動かす
+    if constexpr (enable_indirect_sort<std::iter_value_t<Iterator>>) {
+        if (!std::is_constant_evaluated()) {
+            auto sorter = [](auto first, auto last, auto compare, auto key) {
+                return odd_even_sort<decltype(first), decltype(compare), Result>(first, last, compare, key);
+            };
+            return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
+        }
+    }
+
+    OddEvenSortPasses<Iterator, Comparator, Result, Projection> passes(begin, end, comparator, projection);
+    run_passes(passes);
+    return passes.loop_count();
+}
+
+struct OddEvenSortOptions {
+    // 呼び出し元のスレッドを含む、フェーズを分担するスレッドの数
+    size_t thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    // 1 スレッドがこれより少ない要素しか受け持てない場合はスレッドを減らす (フェーズごとの待ち合わせの方が高くつく)
+    size_t min_elements_per_thread = 1 << 14;
+};
+
+// odd_even_sort の各フェーズを、範囲を区切ってスレッドで分担する。フェーズの終わりは std::barrier で待ち合わせる。
+// 全スレッドが毎フェーズ揃う必要があるので、WorkStealingPool のタスクではなく専用のスレッドを起動する
+// (プールのワーカーが他のタスクで塞がっていると、揃わないまま待ち続けてしまう)。
+// 比較回数・結果は odd_even_sort と同じ。comparator と projection は例外を投げないこと
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+Result parallel_odd_even_sort(Iterator begin, Iterator end, const OddEvenSortOptions& options = {},
+                              Comparator comparator = {}, Projection projection = {}) {
+    const auto size = static_cast<size_t>(end - begin);
+    const auto thread_count = std::min(std::max<size_t>(options.thread_count, 1),
+                                       size / std::max<size_t>(options.min_elements_per_thread, 2));
+    if (thread_count <= 1) {
+        return odd_even_sort<Iterator, Comparator, Result, Projection>(begin, end, comparator, projection);
+    }
+
+    if constexpr (enable_indirect_sort<std::iter_value_t<Iterator>>) {
+        auto sorter = [&options](auto first, auto last, auto compare, auto key) {
+            return parallel_odd_even_sort<decltype(first), decltype(compare), Result>(first, last, options, compare,
+                                                                                      key);
+        };
+        return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
+    } else {
+        auto compare = detail::make_projected_comparator(comparator, projection);
+
+        // 各スレッドの受け持ちを偶数の位置で区切る。奇数フェーズでは、境界をまたぐ組 (bounds[t + 1] - 1, bounds[t + 1])
+        // を左のスレッドが受け持つ。右のスレッドの奇数フェーズは bounds[t + 1] + 1 から始まるので重ならない
+        std::vector<size_t> bounds(thread_count + 1);
+        for (size_t t = 0; t < thread_count; ++t) {
+            bounds[t] = size * t / thread_count & ~size_t{1};
+        }
+        bounds[thread_count] = size;
+
+        // フェーズの状態は完了関数 (全スレッドが到着した後、解放する前に 1 度だけ呼ばれる) だけが書き換える
+        std::vector<unsigned char> swapped(thread_count);
+        size_t phase = 0;
+        size_t quiet_phases = 0;
+        Result loopCount = 0;
+        bool done = false;
+        detail::PassReporter reporter(size);
+        auto on_phase_end = [&]() noexcept {
+            const bool any = std::ranges::any_of(swapped, [](unsigned char s) { return s != 0; });
+            quiet_phases = any ? 0 : quiet_phases + 1;
+            loopCount += static_cast<Result>(detail::odd_even::pairs_in_phase(size, phase));
+            ++phase;
+            done = phase == size || quiet_phases >= 2;
+            if (reporter.enabled()) {
+                reporter.pass_done(phase, 0, done ? 0 : size, static_cast<size_t>(loopCount));
+            }
+        };
+        std::barrier sync(static_cast<std::ptrdiff_t>(thread_count), on_phase_end);
+
+        // t 番目の受け持ちの組を、今のフェーズで比較交換する
+        auto exchange_range = [&](size_t t) {
+            const auto parity = phase % 2;
+            const auto first = bounds[t] + parity;
+            const auto last = std::min(bounds[t + 1] + parity, size);
+            const auto pairs = last > first ? (last - first) / 2 : 0;
+            swapped[t] = detail::odd_even::exchange_pairs(begin + static_cast<std::ptrdiff_t>(first), pairs, compare);
+        };
+        auto worker = [&](size_t t) {
+            while (!done) {
+                exchange_range(t);
+                sync.arrive_and_wait();
+            }
+        };
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(thread_count - 1);
+            size_t started = 1;
+            try {
+                for (; started < thread_count; ++started) {
+                    threads.emplace_back(worker, started);
+                }
+            } catch (...) {
+                // スレッドを起動できなかった (std::system_error など)。起動できなかった分は参加者から外し、
+                // その受け持ちはこのスレッドが代わりに処理する。外さないと起動済みのスレッドが待ち続ける
+                for (size_t t = started; t < thread_count; ++t) {
+                    sync.arrive_and_drop();
+                }
+            }
+            while (!done) {
+                exchange_range(0);
+                for (size_t t = started; t < thread_count; ++t) {
+                    exchange_range(t);
+                }
+                sync.arrive_and_wait();
+            }
+        }
+        return loopCount;
+    }
+}
+
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> odd_even_sort(const std::array<T, N>& input, Comparator comparator = {},
+                                                             Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto loopCount = odd_even_sort(arr.begin(), arr.end(), comparator, projection);
+    return std::make_tuple(arr, loopCount);
+}
+
+static_assert(std::get<0>(odd_even_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
+static_assert(std::get<0>(odd_even_sort(std::array{5, 3, 1, 4, 2}, std::greater<>())) == std::array{5, 4, 3, 2, 1});
+// 整列済みなら最初の 2 フェーズ (n - 1 組) で終わる
+static_assert(std::get<1>(odd_even_sort(std::array{1, 2, 3, 4, 5})) == 4);
+
+}  // namespace AlgorithmSamples::Sort
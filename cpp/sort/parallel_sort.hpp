@@ -0,0 +1,143 @@
+﻿#pragma once
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "concurrency/work_stealing_pool.hpp"
+#include "sort/pdq_sort.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+namespace detail::parallel {
+
+// これより短い区間はタスクに分けず pdq_sort でソートする
+inline constexpr std::ptrdiff_t MIN_LEAF_SIZE = 1 << 14;
+// これより短いマージは分割せず逐次に行う
+inline constexpr std::ptrdiff_t MIN_MERGE_SIZE = 1 << 14;
+
+template <typename Iterator, typename OutIterator, typename Comparator>
+void move_merge(Iterator first1, Iterator last1, Iterator first2, Iterator last2, OutIterator out,
+                Comparator& comparator) {
+    std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1), std::make_move_iterator(first2),
+               std::make_move_iterator(last2), out, comparator);
+}
+
+// [first1, last1) と [first2, last2) を out へ並列にマージする。
+// 長い方の中央の要素を基準に、短い方を二分探索で分けて、左右を独立したマージにする
+template <typename Iterator, typename OutIterator, typename Comparator>
+void parallel_merge(Iterator first1, Iterator last1, Iterator first2, Iterator last2, OutIterator out,
+                    Comparator& comparator, Concurrency::WorkStealingPool& pool) {
+    const auto size1 = last1 - first1;
+    const auto size2 = last2 - first2;
+    if (size1 + size2 <= MIN_MERGE_SIZE) {
+        move_merge(first1, last1, first2, last2, out, comparator);
+        return;
+    }
+    if (size1 < size2) {
+        // 基準の取り方を片側に揃える。安定性は要求しないので入れ替えてよい
+        parallel_merge(first2, last2, first1, last1, out, comparator, pool);
+        return;
+    }
+
+    auto mid1 = first1 + size1 / 2;
+    auto mid2 = std::lower_bound(first2, last2, *mid1, comparator);
+    auto out_mid = out + ((mid1 - first1) + (mid2 - first2));
+    *out_mid = std::move(*mid1);
+
+    Concurrency::TaskGroup group;
+    pool.submit(group, [=, &comparator, &pool] {
+        parallel_merge(first1, mid1, first2, mid2, out, comparator, pool);
+    });
+    // 比較関数が例外を投げても、comparator を参照しているタスクが終わるまで待ってから抜ける
+    pool.run_and_wait(group, [&] {
+        parallel_merge(std::next(mid1), last1, mid2, last2, std::next(out_mid), comparator, pool);
+    });
+}
+
+// [begin, end) をソートする。to_buffer が true なら結果を buffer 側に置く。
+// 子は逆向きに結果を置くので、各段のマージは buffer と元の範囲を行き来する
+template <typename Iterator, typename BufferIterator, typename Comparator>
+void merge_sort(Iterator begin, Iterator end, BufferIterator buffer, bool to_buffer, std::ptrdiff_t leaf_size,
+                Comparator& comparator, Concurrency::WorkStealingPool& pool, std::atomic<size_t>& loopCount) {
+    const auto size = end - begin;
+    if (size <= leaf_size) {
+        loopCount.fetch_add(pdq_sort(begin, end, comparator), std::memory_order_relaxed);
+        if (to_buffer) {
+            std::move(begin, end, buffer);
+        }
+        return;
+    }
+
+    const auto half = size / 2;
+    auto mid = begin + half;
+    auto buffer_mid = buffer + half;
+
+    Concurrency::TaskGroup group;
+    pool.submit(group, [=, &comparator, &pool, &loopCount] {
+        merge_sort(begin, mid, buffer, !to_buffer, leaf_size, comparator, pool, loopCount);
+    });
+    pool.run_and_wait(group,
+                      [&] { merge_sort(mid, end, buffer_mid, !to_buffer, leaf_size, comparator, pool, loopCount); });
+
+    if (to_buffer) {
+        parallel_merge(begin, mid, mid, end, buffer, comparator, pool);
+    } else {
+        parallel_merge(buffer, buffer_mid, buffer_mid, buffer + size, begin, comparator, pool);
+    }
+    loopCount.fetch_add(static_cast<size_t>(size), std::memory_order_relaxed);
+}
+
+}  // namespace detail::parallel
+
+// pool のスレッドで並列にソートする (並列マージソート)。
+// 区間を参加スレッド数の数倍のブロックに分けて pdq_sort でソートし、二分探索で分割した並列マージで統合する。
+// 要素数と同じ大きさの作業領域を確保する。安定ソートではない。
+// projection を渡すと、comparator(projection(a), projection(b)) で比較する
+template <std::random_access_iterator Iterator, typename Comparator, typename Projection, std::integral Result = size_t>
+    requires std::default_initializable<std::iter_value_t<Iterator>>
+Result parallel_sort(Iterator begin, Iterator end, Comparator comparator, Projection projection,
+                     Concurrency::WorkStealingPool& pool) {
+    const auto size = end - begin;
+    if (size < 2) {
+        return 0;
+    }
+
+    // 1 スレッドあたり 4 ブロック程度に分け、盗み合いで負荷を均す
+    const auto leaf_size = std::max<std::ptrdiff_t>(
+        detail::parallel::MIN_LEAF_SIZE, size / static_cast<std::ptrdiff_t>(pool.thread_count() * 4));
+    if (size <= leaf_size) {
+        return pdq_sort<Iterator, Comparator, Result>(begin, end, comparator, projection);
+    }
+
+    // 葉の pdq_sort も射影済みの比較関数を使う (射影が std::identity なら comparator そのもの)
+    auto compare = detail::make_projected_comparator(comparator, projection);
+
+    auto buffer = std::make_unique_for_overwrite<std::iter_value_t<Iterator>[]>(static_cast<size_t>(size));
+    std::atomic<size_t> loopCount = 0;
+
+    Concurrency::TaskGroup group;
+    pool.submit(group, [&] {
+        detail::parallel::merge_sort(begin, end, buffer.get(), false, leaf_size, compare, pool, loopCount);
+    });
+    pool.wait(group);
+
+    return static_cast<Result>(loopCount.load());
+}
+
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t>
+    requires std::default_initializable<std::iter_value_t<Iterator>>
+Result parallel_sort(Iterator begin, Iterator end, Comparator comparator, Concurrency::WorkStealingPool& pool) {
+    return parallel_sort<Iterator, Comparator, std::identity, Result>(begin, end, comparator, std::identity(), pool);
+}
+
+template <std::random_access_iterator Iterator>
+    requires std::default_initializable<std::iter_value_t<Iterator>>
+size_t parallel_sort(Iterator begin, Iterator end, Concurrency::WorkStealingPool& pool) {
+    return parallel_sort(begin, end, std::less<>(), std::identity(), pool);
+}
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,113 @@
+﻿#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <type_traits>
+
+namespace AlgorithmSamples::Sort {
+
+// ソートの進み具合
+struct ProgressSnapshot {
+    size_t pass = 0;         // 終えたパス (フェーズ) の数
+    size_t max_passes = 0;   // パスの数の上限 (入力によってはこれより早く終わる)
+    size_t range_begin = 0;  // まだ確定していない範囲 [range_begin, range_end) (先頭からの位置)
+    size_t range_end = 0;
+    size_t comparisons = 0;  // これまでの比較回数
+
+    constexpr bool operator==(const ProgressSnapshot&) const = default;
+};
+
+// 定義は sort/progress.hpp と sort/trace.hpp。ソートのヘッダーはポインタを受け渡すだけで、
+// 書き込みは設定した側が渡す関数を通すので、スレッドや書式化のヘッダーを読み込まずに済む
+class ProgressCounter;
+class TraceRecorder;
+
+using TraceClock = std::chrono::steady_clock;
+
+namespace detail {
+
+// 書き込み先と、そこへ書き込む関数の組。ScopedProgress / ScopedTrace が持ち、生存している間だけ有効にする
+struct ProgressHook {
+    ProgressCounter* counter;
+    void (*publish)(ProgressCounter& counter, const ProgressSnapshot& snapshot) noexcept;
+};
+
+struct TraceHook {
+    TraceRecorder* recorder;
+    void (*add_pass)(TraceRecorder& recorder, TraceClock::time_point start, TraceClock::time_point end,
+                     const ProgressSnapshot& snapshot);
+};
+
+namespace progress {
+
+inline std::atomic<const ProgressHook*>& active_slot() {
+    static std::atomic<const ProgressHook*> slot{nullptr};
+    return slot;
+}
+
+}  // namespace progress
+
+namespace trace {
+
+inline std::atomic<const TraceHook*>& active_slot() {
+    static std::atomic<const TraceHook*> slot{nullptr};
+    return slot;
+}
+
+}  // namespace trace
+
+}  // namespace detail
+
+// 書き込み先が設定されていれば、パスに分けて進むソート (bubble_sort など) はパスの終わりごとに進み具合を書き込む
+inline ProgressCounter* active_progress() {
+    const auto* hook = detail::progress::active_slot().load(std::memory_order_acquire);
+    return hook != nullptr ? hook->counter : nullptr;
+}
+
+// 記録先が設定されていれば、パスに分けて進むソートはパスごとの区間をここに記録する
+inline TraceRecorder* active_trace() {
+    const auto* hook = detail::trace::active_slot().load(std::memory_order_acquire);
+    return hook != nullptr ? hook->recorder : nullptr;
+}
+
+namespace detail {
+
+// パスの終わりごとに、有効な ProgressCounter へ進み具合を書き込み、TraceRecorder にパスの区間を記録する。
+// どちらも設定されていなければ (定数評価中も) 何もせず、パスごとの負担はポインタ 2 つの確認だけ
+class PassReporter {
+public:
+    constexpr explicit PassReporter(size_t max_passes) : max_passes_(max_passes) {
+        if (!std::is_constant_evaluated()) {
+            progress_ = progress::active_slot().load(std::memory_order_acquire);
+            trace_ = trace::active_slot().load(std::memory_order_acquire);
+            if (trace_ != nullptr) {
+                pass_start_ = TraceClock::now();
+            }
+        }
+    }
+
+    constexpr bool enabled() const { return progress_ != nullptr || trace_ != nullptr; }
+
+    // pass 番目のパスを終えた。[range_begin, range_end) はまだ確定していない範囲
+    void pass_done(size_t pass, size_t range_begin, size_t range_end, size_t comparisons) {
+        const ProgressSnapshot snapshot{pass, max_passes_, range_begin, range_end, comparisons};
+        if (progress_ != nullptr) {
+            progress_->publish(*progress_->counter, snapshot);
+        }
+        if (trace_ != nullptr) {
+            const auto now = TraceClock::now();
+            trace_->add_pass(*trace_->recorder, pass_start_, now, snapshot);
+            pass_start_ = now;
+        }
+    }
+
+private:
+    size_t max_passes_;
+    const ProgressHook* progress_ = nullptr;
+    const TraceHook* trace_ = nullptr;
+    TraceClock::time_point pass_start_{};
+};
+
+}  // namespace detail
+
+}  // namespace AlgorithmSamples::Sort
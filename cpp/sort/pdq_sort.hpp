@@ -0,0 +1,472 @@
+﻿#pragma once
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "sort/projection.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+namespace detail::pdq {
+
+// これより短い区間は挿入ソートで処理する
+inline constexpr std::ptrdiff_t INSERTION_SORT_THRESHOLD = 24;
+// これより長い区間は ninther (3 つの中央値の中央値) でピボットを選ぶ
+inline constexpr std::ptrdiff_t NINTHER_THRESHOLD = 128;
+// 分割済みに見える区間で、部分挿入ソートが諦めるまでに許す移動量
+inline constexpr std::size_t PARTIAL_INSERTION_SORT_LIMIT = 8;
+// 分岐なし分割で 1 度に調べる要素数 (オフセットは unsigned char に収まること)
+inline constexpr std::size_t BLOCK_SIZE = 64;
+
+// 算術型を標準の比較関数で比べる場合は、比較結果をそのまま加算に使う分岐なし分割が速い
+template <typename T, typename Comparator>
+inline constexpr bool use_branchless_partition =
+    std::is_arithmetic_v<T> && (std::same_as<Comparator, std::less<>> || std::same_as<Comparator, std::greater<>> ||
+                                std::same_as<Comparator, std::less<T>> || std::same_as<Comparator, std::greater<T>>);
+
+template <typename Iterator, typename Comparator, typename Result>
+constexpr void insertion_sort(Iterator begin, Iterator end, Comparator& comparator, Result& loopCount) {
+    if (begin == end) {
+        return;
+    }
+    for (auto cur = std::next(begin); cur != end; ++cur) {
+        auto sift = cur;
+        auto sift_1 = std::prev(cur);
+        if (comparator(*sift, *sift_1)) {
+            auto tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+                ++loopCount;
+            } while (sift != begin && comparator(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+        ++loopCount;
+    }
+}
+
+// begin の直前に、区間内のどの要素よりも小さくない要素があることを前提に、左端の判定を省く
+template <typename Iterator, typename Comparator, typename Result>
+constexpr void unguarded_insertion_sort(Iterator begin, Iterator end, Comparator& comparator, Result& loopCount) {
+    if (begin == end) {
+        return;
+    }
+    for (auto cur = std::next(begin); cur != end; ++cur) {
+        auto sift = cur;
+        auto sift_1 = std::prev(cur);
+        if (comparator(*sift, *sift_1)) {
+            auto tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+                ++loopCount;
+            } while (comparator(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+        ++loopCount;
+    }
+}
+
+// ほぼ整列済みの区間だけを挿入ソートで片付ける。移動量が上限を超えたら false を返す
+template <typename Iterator, typename Comparator, typename Result>
+constexpr bool partial_insertion_sort(Iterator begin, Iterator end, Comparator& comparator, Result& loopCount) {
+    if (begin == end) {
+        return true;
+    }
+    std::size_t limit = 0;
+    for (auto cur = std::next(begin); cur != end; ++cur) {
+        auto sift = cur;
+        auto sift_1 = std::prev(cur);
+        if (comparator(*sift, *sift_1)) {
+            auto tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+                ++loopCount;
+            } while (sift != begin && comparator(tmp, *--sift_1));
+            *sift = std::move(tmp);
+            limit += static_cast<std::size_t>(cur - sift);
+        }
+        ++loopCount;
+        if (limit > PARTIAL_INSERTION_SORT_LIMIT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Iterator, typename Comparator>
+constexpr void sort2(Iterator a, Iterator b, Comparator& comparator) {
+    if (comparator(*b, *a)) {
+        std::ranges::iter_swap(a, b);
+    }
+}
+
+template <typename Iterator, typename Comparator>
+constexpr void sort3(Iterator a, Iterator b, Iterator c, Comparator& comparator) {
+    sort2(a, b, comparator);
+    sort2(b, c, comparator);
+    sort2(a, b, comparator);
+}
+
+template <typename Iterator, typename Comparator, typename Result>
+constexpr void sift_down(Iterator begin, std::ptrdiff_t size, std::ptrdiff_t index, Comparator& comparator,
+                         Result& loopCount) {
+    auto value = std::move(begin[index]);
+    while (true) {
+        auto child = 2 * index + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && comparator(begin[child], begin[child + 1])) {
+            ++child;
+        }
+        if (!comparator(value, begin[child])) {
+            break;
+        }
+        begin[index] = std::move(begin[child]);
+        index = child;
+        ++loopCount;
+    }
+    begin[index] = std::move(value);
+}
+
+// 分割が偏り続けたときの最悪計算量 O(n log n) の保険
+template <typename Iterator, typename Comparator, typename Result>
+constexpr void heap_sort(Iterator begin, Iterator end, Comparator& comparator, Result& loopCount) {
+    const auto size = end - begin;
+    for (auto i = size / 2; i-- > 0;) {
+        sift_down(begin, size, i, comparator, loopCount);
+    }
+    for (auto last = size - 1; last > 0; --last) {
+        std::ranges::iter_swap(begin, begin + last);
+        sift_down(begin, last, 0, comparator, loopCount);
+    }
+}
+
+// *begin をピボットとして、ピボット未満を左、ピボット以上を右に分ける。
+// 戻り値はピボットの最終位置と、1 度も交換せずに済んだかどうか
+template <typename Iterator, typename Comparator, typename Result>
+constexpr std::pair<Iterator, bool> partition_right(Iterator begin, Iterator end, Comparator& comparator,
+                                                    Result& loopCount) {
+    auto pivot = std::move(*begin);
+    auto first = begin;
+    auto last = end;
+
+    // 中央値選択により、ピボット以上の要素が必ず右側に存在する
+    while (comparator(*++first, pivot)) {
+        ++loopCount;
+    }
+    if (std::prev(first) == begin) {
+        while (first < last && !comparator(*--last, pivot)) {
+            ++loopCount;
+        }
+    } else {
+        while (!comparator(*--last, pivot)) {
+            ++loopCount;
+        }
+    }
+
+    const bool already_partitioned = first >= last;
+    while (first < last) {
+        std::ranges::iter_swap(first, last);
+        while (comparator(*++first, pivot)) {
+            ++loopCount;
+        }
+        while (!comparator(*--last, pivot)) {
+            ++loopCount;
+        }
+    }
+
+    auto pivot_pos = std::prev(first);
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return {pivot_pos, already_partitioned};
+}
+
+template <typename Iterator>
+constexpr void swap_offsets(Iterator first, Iterator last, const unsigned char* offsets_l,
+                            const unsigned char* offsets_r, std::size_t count, bool use_swaps) {
+    if (use_swaps) {
+        // 左右の個数が等しいときは、巡回置換にすると要素が正しい側に来ないことがある
+        for (std::size_t i = 0; i < count; ++i) {
+            std::ranges::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+    } else if (count > 0) {
+        auto l = first + offsets_l[0];
+        auto r = last - offsets_r[0];
+        auto tmp = std::move(*l);
+        *l = std::move(*r);
+        for (std::size_t i = 1; i < count; ++i) {
+            l = first + offsets_l[i];
+            *r = std::move(*l);
+            r = last - offsets_r[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(tmp);
+    }
+}
+
+// partition_right と同じ結果を、比較結果でオフセット配列の添字を進める分岐なしのブロック分割で求める。
+// 参考: Edelkamp, Weiss "BlockQuicksort: How Branch Mispredictions don't affect Quicksort"
+template <typename Iterator, typename Comparator, typename Result>
+constexpr std::pair<Iterator, bool> partition_right_branchless(Iterator begin, Iterator end, Comparator& comparator,
+                                                               Result& loopCount) {
+    auto pivot = std::move(*begin);
+    auto first = begin;
+    auto last = end;
+
+    while (comparator(*++first, pivot)) {
+        ++loopCount;
+    }
+    if (std::prev(first) == begin) {
+        while (first < last && !comparator(*--last, pivot)) {
+            ++loopCount;
+        }
+    } else {
+        while (!comparator(*--last, pivot)) {
+            ++loopCount;
+        }
+    }
+
+    const bool already_partitioned = first >= last;
+    if (!already_partitioned) {
+        std::ranges::iter_swap(first, last);
+        ++first;
+
+        // 左ブロックではピボット以上の要素、右ブロックではピボット未満の要素の位置を記録する
+        unsigned char offsets_l[BLOCK_SIZE] = {};
+        unsigned char offsets_r[BLOCK_SIZE] = {};
+        auto offsets_l_base = first;
+        auto offsets_r_base = last;
+        std::size_t num_l = 0;
+        std::size_t num_r = 0;
+        std::size_t start_l = 0;
+        std::size_t start_r = 0;
+
+        while (first < last) {
+            const auto num_unknown = static_cast<std::size_t>(last - first);
+            const auto left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            const auto right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+            const auto left_count = left_split >= BLOCK_SIZE ? BLOCK_SIZE : left_split;
+            for (std::size_t i = 0; i < left_count; ++i) {
+                offsets_l[num_l] = static_cast<unsigned char>(i);
+                num_l += !comparator(*first, pivot);
+                ++first;
+            }
+            const auto right_count = right_split >= BLOCK_SIZE ? BLOCK_SIZE : right_split;
+            for (std::size_t i = 1; i <= right_count; ++i) {
+                offsets_r[num_r] = static_cast<unsigned char>(i);
+                num_r += comparator(*--last, pivot);
+            }
+            loopCount += static_cast<Result>(left_count + right_count);
+
+            const auto count = num_l < num_r ? num_l : num_r;
+            swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, count,
+                         num_l == num_r);
+            num_l -= count;
+            num_r -= count;
+            start_l += count;
+            start_r += count;
+
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // 片側のブロックに残った要素を、境界の反対側へ移す
+        if (num_l > 0) {
+            while (num_l-- > 0) {
+                std::ranges::iter_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+            }
+            first = last;
+        }
+        if (num_r > 0) {
+            while (num_r-- > 0) {
+                std::ranges::iter_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+
+    auto pivot_pos = std::prev(first);
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return {pivot_pos, already_partitioned};
+}
+
+// ピボットと等しい要素を左、ピボットより大きい要素を右に分ける。
+// 直前の区間のピボットと等しい値が続く場合に使い、重複の多い入力を線形時間で片付ける
+template <typename Iterator, typename Comparator, typename Result>
+constexpr Iterator partition_left(Iterator begin, Iterator end, Comparator& comparator, Result& loopCount) {
+    auto pivot = std::move(*begin);
+    auto first = begin;
+    auto last = end;
+
+    while (comparator(pivot, *--last)) {
+        ++loopCount;
+    }
+    if (std::next(last) == end) {
+        while (first < last && !comparator(pivot, *++first)) {
+            ++loopCount;
+        }
+    } else {
+        while (!comparator(pivot, *++first)) {
+            ++loopCount;
+        }
+    }
+
+    while (first < last) {
+        std::ranges::iter_swap(first, last);
+        while (comparator(pivot, *--last)) {
+            ++loopCount;
+        }
+        while (!comparator(pivot, *++first)) {
+            ++loopCount;
+        }
+    }
+
+    auto pivot_pos = last;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+// 偏った分割で区間の要素をかき混ぜ、次のピボット選択で同じパターンを踏まないようにする
+template <typename Iterator>
+constexpr void break_patterns(Iterator begin, Iterator pivot_pos, Iterator end) {
+    const auto l_size = pivot_pos - begin;
+    const auto r_size = end - std::next(pivot_pos);
+
+    if (l_size >= INSERTION_SORT_THRESHOLD) {
+        std::ranges::iter_swap(begin, begin + l_size / 4);
+        std::ranges::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > NINTHER_THRESHOLD) {
+            std::ranges::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+            std::ranges::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+            std::ranges::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+            std::ranges::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+    }
+    if (r_size >= INSERTION_SORT_THRESHOLD) {
+        std::ranges::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        std::ranges::iter_swap(end - 1, end - r_size / 4);
+        if (r_size > NINTHER_THRESHOLD) {
+            std::ranges::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+            std::ranges::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+            std::ranges::iter_swap(end - 2, end - (1 + r_size / 4));
+            std::ranges::iter_swap(end - 3, end - (2 + r_size / 4));
+        }
+    }
+}
+
+template <bool Branchless, typename Iterator, typename Comparator, typename Result>
+constexpr void pdq_sort_loop(Iterator begin, Iterator end, Comparator& comparator, int bad_allowed, bool leftmost,
+                             Result& loopCount) {
+    while (true) {
+        const auto size = end - begin;
+
+        if (size < INSERTION_SORT_THRESHOLD) {
+            if (leftmost) {
+                insertion_sort(begin, end, comparator, loopCount);
+            } else {
+                unguarded_insertion_sort(begin, end, comparator, loopCount);
+            }
+            return;
+        }
+
+        // ピボットを begin に置く
+        const auto half = size / 2;
+        if (size > NINTHER_THRESHOLD) {
+            sort3(begin, begin + half, end - 1, comparator);
+            sort3(begin + 1, begin + (half - 1), end - 2, comparator);
+            sort3(begin + 2, begin + (half + 1), end - 3, comparator);
+            sort3(begin + (half - 1), begin + half, begin + (half + 1), comparator);
+            std::ranges::iter_swap(begin, begin + half);
+        } else {
+            sort3(begin + half, begin, end - 1, comparator);
+        }
+
+        // 左隣 (前回のピボット) とピボットが等しければ、ピボットと等しい要素をまとめて確定させる
+        if (!leftmost && !comparator(*std::prev(begin), *begin)) {
+            begin = std::next(partition_left(begin, end, comparator, loopCount));
+            continue;
+        }
+
+        std::pair<Iterator, bool> part;
+        if constexpr (Branchless) {
+            part = partition_right_branchless(begin, end, comparator, loopCount);
+        } else {
+            part = partition_right(begin, end, comparator, loopCount);
+        }
+        const auto [pivot_pos, already_partitioned] = part;
+
+        const auto l_size = pivot_pos - begin;
+        const auto r_size = end - std::next(pivot_pos);
+        const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            if (--bad_allowed == 0) {
+                heap_sort(begin, end, comparator, loopCount);
+                return;
+            }
+            break_patterns(begin, pivot_pos, end);
+        } else if (already_partitioned && partial_insertion_sort(begin, pivot_pos, comparator, loopCount) &&
+                   partial_insertion_sort(std::next(pivot_pos), end, comparator, loopCount)) {
+            // 交換なしで分割できた区間は整列済みの可能性が高い
+            return;
+        }
+
+        // 左側は再帰、右側はループで処理する
+        pdq_sort_loop<Branchless>(begin, pivot_pos, comparator, bad_allowed, leftmost, loopCount);
+        begin = std::next(pivot_pos);
+        leftmost = false;
+    }
+}
+
+}  // namespace detail::pdq
+
+// pattern-defeating quicksort (Orson Peters)。
+// 平均 O(n log n)、最悪 O(n log n) (ヒープソートへの切り替え)、整列済み・逆順・重複の多い入力では O(n) に近づく
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr Result pdq_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {}) {
+    if (begin == end || std::next(begin) == end) {
+        return 0;
+    }
+
+    Result loopCount = 0;
+    const auto size = static_cast<std::size_t>(end - begin);
+    // 偏った分割を log2(n) 回まで許す
+    const auto bad_allowed = static_cast<int>(std::bit_width(size));
+
+    // 射影したキーが算術型なら、射影を挟んでも比較は安いので分岐なし分割を使う
+    constexpr bool branchless =
+        detail::pdq::use_branchless_partition<projected_key_t<Iterator, Projection>, Comparator>;
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    detail::pdq::pdq_sort_loop<branchless>(begin, end, compare, bad_allowed, true, loopCount);
+    return loopCount;
+}
+
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> pdq_sort(const std::array<T, N>& input, Comparator comparator = {},
+                                                        Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto loopCount = pdq_sort(arr.begin(), arr.end(), comparator, projection);
+    return std::make_tuple(arr, loopCount);
+}
+
+static_assert(std::get<0>(pdq_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
+static_assert(std::get<0>(pdq_sort(std::array{5, 3, 1, 4, 2}, std::greater<>())) == std::array{5, 4, 3, 2, 1});
+
+}  // namespace AlgorithmSamples::Sort
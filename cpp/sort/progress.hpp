@@ -0,0 +1,114 @@
+﻿#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include "sort/pass_hooks.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// ソートしているスレッドがパスの終わりごとに書き、別のスレッド (ProgressSampler) が読む進み具合。
+// 書き込みはロックを取らず (seqlock)、読む側は書き込みの途中を見たら読み直すので、ばらばらの値が混ざらない。
+// 同時に書くのは 1 スレッドだけにすること
+class ProgressCounter {
+public:
+    static_assert(std::atomic<size_t>::is_always_lock_free);
+
+    void publish(const ProgressSnapshot& snapshot) noexcept {
+        const auto sequence = sequence_.load(std::memory_order_relaxed);
+        // 奇数の間は書き込み中
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        pass_.store(snapshot.pass, std::memory_order_relaxed);
+        max_passes_.store(snapshot.max_passes, std::memory_order_relaxed);
+        range_begin_.store(snapshot.range_begin, std::memory_order_relaxed);
+        range_end_.store(snapshot.range_end, std::memory_order_relaxed);
+        comparisons_.store(snapshot.comparisons, std::memory_order_relaxed);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    ProgressSnapshot load() const noexcept {
+        for (;;) {
+            const auto before = sequence_.load(std::memory_order_acquire);
+            ProgressSnapshot snapshot{pass_.load(std::memory_order_relaxed),
+                                      max_passes_.load(std::memory_order_relaxed),
+                                      range_begin_.load(std::memory_order_relaxed),
+                                      range_end_.load(std::memory_order_relaxed),
+                                      comparisons_.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (before % 2 == 0 && sequence_.load(std::memory_order_relaxed) == before) {
+                return snapshot;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // publish された回数。前回読んだときから変わったかを調べるのに使う
+    uint64_t updates() const noexcept { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<size_t> pass_{0};
+    std::atomic<size_t> max_passes_{0};
+    std::atomic<size_t> range_begin_{0};
+    std::atomic<size_t> range_end_{0};
+    std::atomic<size_t> comparisons_{0};
+};
+
+namespace detail::progress {
+
+inline void publish(ProgressCounter& counter, const ProgressSnapshot& snapshot) noexcept { counter.publish(snapshot); }
+
+}  // namespace detail::progress
+
+// 生存している間だけ counter を書き込み先にする。破棄すると元の書き込み先に戻す
+class ScopedProgress {
+public:
+    explicit ScopedProgress(ProgressCounter& counter)
+        : hook_{&counter, &detail::progress::publish},
+          previous_(detail::progress::active_slot().exchange(&hook_, std::memory_order_acq_rel)) {}
+    ~ScopedProgress() { detail::progress::active_slot().store(previous_, std::memory_order_release); }
+
+    ScopedProgress(const ScopedProgress&) = delete;
+    ScopedProgress& operator=(const ScopedProgress&) = delete;
+
+private:
+    detail::ProgressHook hook_;
+    const detail::ProgressHook* previous_;
+};
+
+// counter を一定の間隔で読み、前回から更新されていれば callback を呼ぶスレッド。
+// callback はこのスレッドで呼ばれる。破棄すると (待ち時間の途中でも) すぐに止まる
+class ProgressSampler {
+public:
+    using Callback = std::function<void(const ProgressSnapshot&)>;
+
+    ProgressSampler(const ProgressCounter& counter, std::chrono::milliseconds interval, Callback callback)
+        : thread_([this, &counter, interval, callback = std::move(callback)](std::stop_token stop) {
+              uint64_t seen = counter.updates();
+              std::unique_lock lock(mutex_);
+              while (!wake_.wait_for(lock, stop, interval, [] { return false; }) && !stop.stop_requested()) {
+                  if (const auto updates = counter.updates(); updates != seen) {
+                      seen = updates;
+                      callback(counter.load());
+                  }
+              }
+          }) {}
+
+    ProgressSampler(const ProgressSampler&) = delete;
+    ProgressSampler& operator=(const ProgressSampler&) = delete;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    // mutex_ と wake_ より後に作られ、先に破棄 (停止・合流) されるよう、最後に置く
+    std::jthread thread_;
+};
+
+}  // namespace AlgorithmSamples::Sort
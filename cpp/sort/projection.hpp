@@ -0,0 +1,32 @@
+﻿#pragma once
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace AlgorithmSamples::Sort {
+
+// 要素に projection を適用した値 (ソートのキー) の型
+template <typename Iterator, typename Projection>
+using projected_key_t = std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>;
+
+namespace detail {
+
+// comparator(projection(a), projection(b)) で要素を比べる比較関数を作る。
+// projection が std::identity なら comparator をそのまま返すので、比較関数の型を見て実装を切り替える
+// 最適化 (pdq_sort の分岐なし分割、network_sort_batch の SIMD など) がそのまま効く
+template <typename Comparator, typename Projection>
+constexpr auto make_projected_comparator(Comparator comparator, Projection projection) {
+    if constexpr (std::same_as<Projection, std::identity>) {
+        return comparator;
+    } else {
+        return [comparator = std::move(comparator), projection = std::move(projection)](auto&& a, auto&& b) mutable {
+            return static_cast<bool>(std::invoke(comparator, std::invoke(projection, std::forward<decltype(a)>(a)),
+                                                 std::invoke(projection, std::forward<decltype(b)>(b))));
+        };
+    }
+}
+
+}  // namespace detail
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,225 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace AlgorithmSamples::Sort {
+
+// 基数ソートのキーにできる型。浮動小数点数は IEEE-754 の float / double のみ
+template <typename T>
+concept RadixKey = (std::integral<T> && !std::same_as<T, bool>) || std::same_as<T, float> || std::same_as<T, double>;
+
+namespace detail::radix {
+
+inline constexpr size_t RADIX = 256;
+// MSD 基数ソートで、これより小さいバケットは挿入ソートで片付ける
+inline constexpr std::ptrdiff_t MSD_INSERTION_SORT_THRESHOLD = 32;
+
+template <typename Key>
+using unsigned_key_t = std::conditional_t<
+    sizeof(Key) == 1, uint8_t,
+    std::conditional_t<sizeof(Key) == 2, uint16_t, std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>>>;
+
+// キーを、符号なし整数としての大小がキーの大小と一致するビット列に変換する。
+// 符号付き整数は符号ビットを反転し、浮動小数点数は負なら全ビット、非負なら符号ビットを反転する。
+// (-0.0 は +0.0 の前、NaN は符号に応じて両端に並ぶ)
+template <RadixKey Key>
+constexpr unsigned_key_t<Key> to_bits(Key key) {
+    using Bits = unsigned_key_t<Key>;
+    constexpr Bits SIGN_BIT = Bits(1) << (sizeof(Key) * 8 - 1);
+    if constexpr (std::floating_point<Key>) {
+        auto bits = std::bit_cast<Bits>(key);
+        return (bits & SIGN_BIT) != 0 ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | SIGN_BIT);
+    } else if constexpr (std::signed_integral<Key>) {
+        return static_cast<Bits>(static_cast<Bits>(key) ^ SIGN_BIT);
+    } else {
+        return static_cast<Bits>(key);
+    }
+}
+
+template <typename Bits>
+constexpr size_t digit_of(Bits bits, size_t digit) {
+    return static_cast<size_t>((bits >> (digit * 8)) & 0xFF);
+}
+
+template <typename Iterator, typename Projection>
+using key_t = std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>;
+
+template <typename Iterator, typename Projection>
+constexpr auto bits_of(Iterator it, Projection& projection) {
+    return to_bits(std::invoke(projection, *it));
+}
+
+// digit 桁目 (0 が最下位) の値に従って src から dst へ安定に振り分ける
+template <typename SrcIterator, typename DstIterator, typename Projection>
+constexpr void scatter(SrcIterator src, size_t size, DstIterator dst, const std::array<size_t, RADIX>& counts,
+                       size_t digit, Projection& projection) {
+    std::array<size_t, RADIX> offsets{};
+    size_t sum = 0;
+    for (size_t b = 0; b < RADIX; ++b) {
+        offsets[b] = sum;
+        sum += counts[b];
+    }
+    for (size_t i = 0; i < size; ++i) {
+        auto it = src + static_cast<std::ptrdiff_t>(i);
+        auto& offset = offsets[digit_of(bits_of(it, projection), digit)];
+        dst[static_cast<std::ptrdiff_t>(offset++)] = std::move(*it);
+    }
+}
+
+template <typename Iterator, typename Projection, typename Result>
+constexpr void msd_insertion_sort(Iterator begin, Iterator end, Projection& projection, Result& loopCount) {
+    for (auto cur = begin; cur != end; ++cur) {
+        for (auto sift = cur; sift != begin && bits_of(sift, projection) < bits_of(std::prev(sift), projection);
+             --sift) {
+            std::ranges::iter_swap(sift, std::prev(sift));
+            ++loopCount;
+        }
+        ++loopCount;
+    }
+}
+
+// American flag sort: バケットの境界を求めてから、要素を巡回的に交換して正しいバケットへ送る
+template <typename Iterator, typename Projection, typename Result>
+constexpr void msd_radix_sort(Iterator begin, Iterator end, size_t digit, Projection& projection, Result& loopCount) {
+    while (true) {
+        if (end - begin < MSD_INSERTION_SORT_THRESHOLD) {
+            msd_insertion_sort(begin, end, projection, loopCount);
+            return;
+        }
+
+        std::array<size_t, RADIX> counts{};
+        for (auto it = begin; it != end; ++it) {
+            ++counts[digit_of(bits_of(it, projection), digit)];
+        }
+        loopCount += static_cast<Result>(end - begin);
+
+        // 全要素がこの桁で同じ値なら、振り分けずに次の桁へ進む
+        const auto size = static_cast<size_t>(end - begin);
+        if (std::ranges::find(counts, size) != counts.end()) {
+            if (digit == 0) {
+                return;
+            }
+            --digit;
+            continue;
+        }
+
+        std::array<size_t, RADIX> heads{};
+        std::array<size_t, RADIX> tails{};
+        size_t sum = 0;
+        for (size_t b = 0; b < RADIX; ++b) {
+            heads[b] = sum;
+            sum += counts[b];
+            tails[b] = sum;
+        }
+        for (size_t b = 0; b < RADIX; ++b) {
+            while (heads[b] < tails[b]) {
+                auto it = begin + static_cast<std::ptrdiff_t>(heads[b]);
+                auto target = digit_of(bits_of(it, projection), digit);
+                if (target == b) {
+                    ++heads[b];
+                } else {
+                    std::ranges::iter_swap(it, begin + static_cast<std::ptrdiff_t>(heads[target]++));
+                }
+                ++loopCount;
+            }
+        }
+
+        if (digit == 0) {
+            return;
+        }
+        size_t bucket_begin = 0;
+        for (size_t b = 0; b < RADIX; ++b) {
+            if (counts[b] > 1) {
+                auto first = begin + static_cast<std::ptrdiff_t>(bucket_begin);
+                msd_radix_sort(first, first + static_cast<std::ptrdiff_t>(counts[b]), digit - 1, projection,
+                               loopCount);
+            }
+            bucket_begin += counts[b];
+        }
+        return;
+    }
+}
+
+}  // namespace detail::radix
+
+// LSD 基数ソート (昇順・安定)。projection が返す整数・浮動小数点数のキーを 1 バイトずつ並べ替える。
+// scratch には [begin, end) と同じ要素数の作業領域を渡す。関数内でメモリを確保しない。
+// 全桁のヒストグラムを最初の 1 回の走査でまとめて数え、全要素が同じ値になる桁の振り分けは省略する。
+template <std::random_access_iterator Iterator, std::random_access_iterator ScratchIterator,
+          typename Projection = std::identity, std::integral Result = size_t>
+    requires RadixKey<detail::radix::key_t<Iterator, Projection>>
+constexpr Result radix_sort(Iterator begin, Iterator end, ScratchIterator scratch, Projection projection = {}) {
+    if (begin == end || std::next(begin) == end) {
+        return 0;
+    }
+
+    using Key = detail::radix::key_t<Iterator, Projection>;
+    constexpr size_t DIGITS = sizeof(Key);
+    const auto size = static_cast<size_t>(end - begin);
+
+    Result loopCount = 0;
+    std::array<std::array<size_t, detail::radix::RADIX>, DIGITS> counts{};
+    for (auto it = begin; it != end; ++it) {
+        auto bits = detail::radix::bits_of(it, projection);
+        for (size_t digit = 0; digit < DIGITS; ++digit) {
+            ++counts[digit][detail::radix::digit_of(bits, digit)];
+        }
+        ++loopCount;
+    }
+
+    bool in_scratch = false;
+    for (size_t digit = 0; digit < DIGITS; ++digit) {
+        if (std::ranges::find(counts[digit], size) != counts[digit].end()) {
+            continue;
+        }
+        if (in_scratch) {
+            detail::radix::scatter(scratch, size, begin, counts[digit], digit, projection);
+        } else {
+            detail::radix::scatter(begin, size, scratch, counts[digit], digit, projection);
+        }
+        in_scratch = !in_scratch;
+        loopCount += static_cast<Result>(size);
+    }
+
+    if (in_scratch) {
+        std::move(scratch, scratch + static_cast<std::ptrdiff_t>(size), begin);
+        loopCount += static_cast<Result>(size);
+    }
+    return loopCount;
+}
+
+// MSD 基数ソート (昇順・非安定)。作業領域を使わず、上位バイトから順にバケットへ振り分ける
+template <std::random_access_iterator Iterator, typename Projection = std::identity, std::integral Result = size_t>
+    requires RadixKey<detail::radix::key_t<Iterator, Projection>>
+constexpr Result msd_radix_sort(Iterator begin, Iterator end, Projection projection = {}) {
+    if (begin == end || std::next(begin) == end) {
+        return 0;
+    }
+    Result loopCount = 0;
+    detail::radix::msd_radix_sort(begin, end, sizeof(detail::radix::key_t<Iterator, Projection>) - 1, projection,
+                                  loopCount);
+    return loopCount;
+}
+
+template <std::integral T, std::size_t N>
+constexpr std::tuple<std::array<T, N>, size_t> radix_sort(const std::array<T, N>& input) {
+    std::array<T, N> arr = input;
+    std::array<T, N> scratch{};
+    auto loopCount = radix_sort(arr.begin(), arr.end(), scratch.begin());
+    return std::make_tuple(arr, loopCount);
+}
+
+static_assert(std::get<0>(radix_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
+static_assert(std::get<0>(radix_sort(std::array{5, -3, 1, -4, 2})) == std::array{-4, -3, 1, 2, 5});
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,67 @@
+﻿#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include "sort/indirect_sort.hpp"
+#include "sort/pdq_sort.hpp"
+#include "sort/projection.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+namespace detail::schwartzian {
+
+template <typename Key, typename Index>
+struct Decorated {
+    Key key;
+    Index index;
+};
+
+template <typename Index, typename Iterator, typename Comparator, typename Projection, typename Result>
+void decorate_sort_undecorate(Iterator begin, Iterator end, Comparator& comparator, Projection& projection,
+                              Result& loopCount) {
+    using Key = projected_key_t<Iterator, Projection>;
+    using Element = Decorated<Key, Index>;
+
+    std::vector<Element> decorated;
+    decorated.reserve(static_cast<std::size_t>(end - begin));
+    Index index = 0;
+    for (auto it = begin; it != end; ++it) {
+        decorated.push_back({std::invoke(projection, *it), index++});
+    }
+    loopCount += static_cast<Result>(decorated.size());
+
+    loopCount += pdq_sort<typename std::vector<Element>::iterator, Comparator, Result>(
+        decorated.begin(), decorated.end(), comparator, &Element::key);
+    indirect::apply_permutation(
+        begin, decorated.size(), [&](std::size_t i) -> Index& { return decorated[i].index; }, loopCount);
+}
+
+}  // namespace detail::schwartzian
+
+// Schwartzian 変換 (decorate-sort-undecorate) によるソート。
+// projection でキーを各要素 1 回だけ計算して (キー, 元の位置) の連続した配列を作り、それを pdq_sort でソートしてから、
+// 元の要素を巡回置換に沿って 1 回ずつムーブして並べ替える。
+// キーの計算が重い場合 (文字列の解析やハッシュなど) や、要素が大きく比較のたびに離れた場所を読むことになる場合に、
+// 射影付きの pdq_sort より速い。位置は 2^32 要素未満なら 32 ビットで持つ。
+// 安定ソートではない。n 要素分の (キー, 位置) を確保する
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, typename Projection = std::identity,
+          std::integral Result = size_t>
+Result schwartzian_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {}) {
+    Result loopCount = 0;
+    const auto size = static_cast<std::size_t>(end - begin);
+    if (size < 2) {
+        return loopCount;
+    }
+    if (size <= std::numeric_limits<uint32_t>::max()) {
+        detail::schwartzian::decorate_sort_undecorate<uint32_t>(begin, end, comparator, projection, loopCount);
+    } else {
+        detail::schwartzian::decorate_sort_undecorate<std::size_t>(begin, end, comparator, projection, loopCount);
+    }
+    return loopCount;
+}
+
+}  // namespace AlgorithmSamples::Sort
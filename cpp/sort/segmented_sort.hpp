@@ -0,0 +1,189 @@
+﻿#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "concurrency/work_stealing_pool.hpp"
+#include "sort/network_sort.hpp"
+#include "sort/parallel_sort.hpp"
+#include "sort/pdq_sort.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// 算術型の要素では、この要素数以下のセグメントをソーティングネットワークでソートする。
+// 比較交換が分岐なしの min / max になるので、乱数の int32_t では 64 要素まで pdq_sort より速い。
+// 同じ長さのセグメントが続く部分は network_sort_batch にまとめて渡す (int32_t / float なら SIMD のレーンに並ぶ)
+inline constexpr std::size_t NETWORK_SEGMENT_LIMIT = MAX_NETWORK_SIZE;
+
+namespace detail::segmented {
+
+// 1 スレッドあたりのタスク数。コストの見積もりの誤差を盗み合いで均す
+inline constexpr std::size_t TASKS_PER_THREAD = 4;
+
+// セグメントをソートするコストの見積もり (n log n)
+constexpr std::size_t segment_cost(std::size_t size) { return size * static_cast<std::size_t>(std::bit_width(size)); }
+
+template <typename T, typename Offset>
+void validate_offsets(std::span<T> data, std::span<Offset> offsets) {
+    if (offsets.empty()) {
+        return;
+    }
+    if constexpr (std::is_signed_v<std::remove_const_t<Offset>>) {
+        if (offsets.front() < 0) {
+            throw std::invalid_argument("segmented_sort: offsets must not be negative");
+        }
+    }
+    if (!std::ranges::is_sorted(offsets)) {
+        throw std::invalid_argument("segmented_sort: offsets must be non-decreasing");
+    }
+    if (static_cast<std::size_t>(offsets.back()) > data.size()) {
+        throw std::invalid_argument("segmented_sort: offsets exceed the data size");
+    }
+}
+
+// data を長さ N のセグメント count 個の並びとしてソートし、比較交換の回数を返す
+template <typename Result, typename T, typename Comparator, typename Projection, std::size_t... N>
+Result network_sort_run(std::span<T> data, std::size_t size, std::size_t count, Comparator& comparator,
+                        Projection& projection, std::index_sequence<N...>) {
+    Result loopCount = 0;
+    // N = 2, 3, ..., NETWORK_SEGMENT_LIMIT のうち size に一致するものを呼ぶ
+    (void)((size == N + 2 && (network_sort_batch<N + 2>(data.first(size * count), comparator, projection),
+                              loopCount = static_cast<Result>(SORTING_NETWORK<N + 2>.size() * count), true)) ||
+           ...);
+    return loopCount;
+}
+
+// セグメント [first_segment, last_segment) を順にソートする
+template <typename Result, typename T, typename Offset, typename Comparator, typename Projection>
+Result sort_segments(std::span<T> data, std::span<Offset> offsets, std::size_t first_segment,
+                     std::size_t last_segment, Comparator& comparator, Projection& projection) {
+    Result loopCount = 0;
+    auto bounds = [&](std::size_t segment) {
+        return std::pair(static_cast<std::size_t>(offsets[segment]), static_cast<std::size_t>(offsets[segment + 1]));
+    };
+    // 算術型でなければ比較交換が分岐になり、比較回数も挿入ソートより多いので、小さいセグメントも pdq_sort に任せる
+    constexpr std::size_t network_limit = std::is_arithmetic_v<std::remove_const_t<T>> ? NETWORK_SEGMENT_LIMIT : 1;
+    for (auto segment = first_segment; segment < last_segment;) {
+        const auto [begin, end] = bounds(segment);
+        const auto size = end - begin;
+        if (size > network_limit) {
+            loopCount += pdq_sort<decltype(data.begin()), Comparator, Result>(
+                data.begin() + static_cast<std::ptrdiff_t>(begin), data.begin() + static_cast<std::ptrdiff_t>(end),
+                comparator, projection);
+            ++segment;
+            continue;
+        }
+        // 同じ長さで隣り合うセグメントをまとめる
+        auto run_end = segment + 1;
+        while (run_end < last_segment && bounds(run_end).second - bounds(run_end).first == size) {
+            ++run_end;
+        }
+        if constexpr (network_limit > 1) {
+            if (size >= 2) {
+                loopCount += network_sort_run<Result>(data.subspan(begin), size, run_end - segment, comparator,
+                                                      projection, std::make_index_sequence<NETWORK_SEGMENT_LIMIT - 1>());
+            }
+        }
+        segment = run_end;
+    }
+    return loopCount;
+}
+
+}  // namespace detail::segmented
+
+// data を offsets で区切った独立したセグメント [offsets[i], offsets[i + 1]) ごとにソートする (CSR 形式)。
+// 算術型の要素では NETWORK_SEGMENT_LIMIT 以下のセグメントをソーティングネットワークで、同じ長さで隣り合うものは
+// network_sort_batch でまとめて処理する。それより長いセグメントと、算術型でない要素は pdq_sort でソートする。
+// offsets は非減少で、最後の値が data.size() 以下であること (そうでなければ std::invalid_argument を投げる)。
+// offsets で覆われない data の要素は動かさない。戻り値は比較回数の合計
+template <typename T, typename Offset, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+    requires std::integral<std::remove_const_t<Offset>>
+Result segmented_sort(std::span<T> data, std::span<Offset> offsets, Comparator comparator = {},
+                      Projection projection = {}) {
+    detail::segmented::validate_offsets(data, offsets);
+    if (offsets.size() < 2) {
+        return 0;
+    }
+    return detail::segmented::sort_segments<Result>(data, offsets, 0, offsets.size() - 1, comparator, projection);
+}
+
+// segmented_sort を pool のスレッドで並列に行う。
+// セグメントを n log n で見積もったコストが均等になるよう、参加スレッド数の数倍のタスクに分ける。
+// 1 つでタスク 1 個分のコストを超えるセグメントは単独のタスクにし、十分大きければ parallel_sort で分割する
+template <typename T, typename Offset, typename Comparator, typename Projection, std::integral Result = size_t>
+    requires std::integral<std::remove_const_t<Offset>>
+Result segmented_sort(std::span<T> data, std::span<Offset> offsets, Comparator comparator, Projection projection,
+                      Concurrency::WorkStealingPool& pool) {
+    detail::segmented::validate_offsets(data, offsets);
+    if (offsets.size() < 2) {
+        return 0;
+    }
+    const auto segment_count = offsets.size() - 1;
+    auto segment_cost = [&](std::size_t segment) {
+        return detail::segmented::segment_cost(static_cast<std::size_t>(offsets[segment + 1] - offsets[segment]));
+    };
+    std::size_t total_cost = 0;
+    for (std::size_t segment = 0; segment < segment_count; ++segment) {
+        total_cost += segment_cost(segment);
+    }
+    const auto task_cost = std::max<std::size_t>(
+        total_cost / (pool.thread_count() * detail::segmented::TASKS_PER_THREAD), 1);
+
+    std::atomic<std::size_t> loopCount = 0;
+    Concurrency::TaskGroup group;
+    auto submit_segments = [&](std::size_t first, std::size_t last) {
+        pool.submit(group, [&, first, last] {
+            loopCount += detail::segmented::sort_segments<std::size_t>(data, offsets, first, last, comparator,
+                                                                      projection);
+        });
+    };
+    auto submit_large_segment = [&](std::size_t segment) {
+        pool.submit(group, [&, segment] {
+            auto first = data.begin() + static_cast<std::ptrdiff_t>(offsets[segment]);
+            auto last = data.begin() + static_cast<std::ptrdiff_t>(offsets[segment + 1]);
+            if constexpr (std::default_initializable<T>) {
+                loopCount += parallel_sort<decltype(first), Comparator, Projection, std::size_t>(
+                    first, last, comparator, projection, pool);
+            } else {
+                loopCount += pdq_sort<decltype(first), Comparator, std::size_t>(first, last, comparator, projection);
+            }
+        });
+    };
+
+    // submit が途中で例外を投げても、積んだタスクが終わるまで待ってから抜ける
+    pool.run_and_wait(group, [&] {
+        std::size_t chunk_begin = 0;
+        std::size_t chunk_cost = 0;
+        for (std::size_t segment = 0; segment < segment_count; ++segment) {
+            const auto cost = segment_cost(segment);
+            if (cost >= task_cost) {
+                if (chunk_begin < segment) {
+                    submit_segments(chunk_begin, segment);
+                }
+                submit_large_segment(segment);
+                chunk_begin = segment + 1;
+                chunk_cost = 0;
+                continue;
+            }
+            chunk_cost += cost;
+            if (chunk_cost >= task_cost) {
+                submit_segments(chunk_begin, segment + 1);
+                chunk_begin = segment + 1;
+                chunk_cost = 0;
+            }
+        }
+        if (chunk_begin < segment_count) {
+            submit_segments(chunk_begin, segment_count);
+        }
+    });
+    return static_cast<Result>(loopCount.load());
+}
+
+}  // namespace AlgorithmSamples::Sort
@@ -1,47 +1,376 @@
 ﻿#pragma once
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include "sort/indirect_sort.hpp"
+#include "sort/projection.hpp"
+#include "sort/sort_passes.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
 
 namespace AlgorithmSamples::Sort {
 
-template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t>
-constexpr Result selection_sort(Iterator begin, Iterator end, Comparator comparator = {}) {
-    if (begin == end || std::next(begin) == end) {
-        return 0;
+namespace detail::selection {
+
+// 走査した範囲の先頭からの、最小 (と最大) の要素の位置。同じ値が複数あれば最も前の位置
+struct ScanResult {
+    std::size_t min = 0;
+    std::size_t max = 0;
+};
+
+template <typename T, typename Compare>
+inline constexpr bool is_descending = std::same_as<Compare, std::greater<>> || std::same_as<Compare, std::greater<T>>;
+
+// 連続したメモリ上の算術型を標準の比較関数で比べる場合は、値を直接読んで分岐なし (SIMD) で走査する
+template <typename Iterator, typename Compare, typename T = std::iter_value_t<Iterator>>
+inline constexpr bool use_fast_scan =
+    std::contiguous_iterator<Iterator> && std::is_arithmetic_v<T> &&
+    (std::same_as<Compare, std::less<>> || std::same_as<Compare, std::less<T>> || is_descending<T, Compare>);
+
+// data[first, size) を走査して result を更新する。
+// 最小値の候補をレジスタに持ち、比較結果で値と位置を選ぶだけにして、分岐予測の失敗をなくす
+template <bool FindMax, typename T, typename Compare>
+ScanResult scalar_scan(const T* data, std::size_t first, std::size_t size, Compare& compare, ScanResult result) {
+    auto lo = data[result.min];
+    auto hi = data[result.max];
+    for (std::size_t i = first; i < size; ++i) {
+        const auto x = data[i];
+        const bool lower = compare(x, lo);
+        lo = lower ? x : lo;
+        result.min = lower ? i : result.min;
+        if constexpr (FindMax) {
+            const bool higher = compare(hi, x);
+            hi = higher ? x : hi;
+            result.max = higher ? i : result.max;
+        }
+    }
+    return result;
+}
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+
+// 値と位置 (int32_t) を同じ幅のレジスタに並べ、レーンごとに最小値とその位置を持つ
+template <typename T>
+struct ScanLanes;
+
+#if defined(__AVX2__)
+template <>
+struct ScanLanes<int32_t> {
+    using Register = __m256i;
+    static constexpr std::size_t WIDTH = 8;
+    static Register load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(int32_t* out, Register r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), r); }
+    // a < b のレーンを全ビット 1 にしたマスク
+    static __m256i less(Register a, Register b) { return _mm256_cmpgt_epi32(b, a); }
+    static Register select(__m256i mask, Register a, Register b) { return _mm256_blendv_epi8(b, a, mask); }
+};
+
+template <>
+struct ScanLanes<float> {
+    using Register = __m256;
+    static constexpr std::size_t WIDTH = 8;
+    static Register load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* out, Register r) { _mm256_storeu_ps(out, r); }
+    static __m256i less(Register a, Register b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+    static Register select(__m256i mask, Register a, Register b) {
+        return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask));
     }
+};
 
-    Result loopCount = 0;
+struct ScanIndex {
+    using Register = __m256i;
+    static Register first() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+    static Register broadcast(int32_t x) { return _mm256_set1_epi32(x); }
+    static Register add(Register a, Register b) { return _mm256_add_epi32(a, b); }
+    static void store(int32_t* out, Register r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), r); }
+    static Register select(Register mask, Register a, Register b) { return _mm256_blendv_epi8(b, a, mask); }
+};
+#else
+template <>
+struct ScanLanes<int32_t> {
+    using Register = __m128i;
+    static constexpr std::size_t WIDTH = 4;
+    static Register load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(int32_t* out, Register r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r); }
+    static __m128i less(Register a, Register b) { return _mm_cmplt_epi32(a, b); }
+    static Register select(__m128i mask, Register a, Register b) { return _mm_blendv_epi8(b, a, mask); }
+};
+
+template <>
+struct ScanLanes<float> {
+    using Register = __m128;
+    static constexpr std::size_t WIDTH = 4;
+    static Register load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* out, Register r) { _mm_storeu_ps(out, r); }
+    static __m128i less(Register a, Register b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+    static Register select(__m128i mask, Register a, Register b) { return _mm_blendv_ps(b, a, _mm_castsi128_ps(mask)); }
+};
+
+struct ScanIndex {
+    using Register = __m128i;
+    static Register first() { return _mm_setr_epi32(0, 1, 2, 3); }
+    static Register broadcast(int32_t x) { return _mm_set1_epi32(x); }
+    static Register add(Register a, Register b) { return _mm_add_epi32(a, b); }
+    static void store(int32_t* out, Register r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r); }
+    static Register select(Register mask, Register a, Register b) { return _mm_blendv_epi8(b, a, mask); }
+};
+#endif
+
+template <typename T>
+inline constexpr bool has_scan_lanes = std::same_as<T, int32_t> || std::same_as<T, float>;
 
-    for (auto a = begin; a != end; ++a) {
-        auto target = a;
-        for (auto b = std::next(a); b != end; ++b) {
-            if (comparator(*b, *target)) {
-                target = b;
+// WIDTH 個のレーンで並行して走査し、最後にレーン間で比べる。
+// 比較は狭義なので、各レーンには同じ値のうち最初の位置が残る。
+// WIDTH の倍数に満たない末尾はスカラーで続ける (末尾の位置はどのレーンの位置より後ろなので、同じ値の扱いは変わらない)
+template <bool FindMax, bool Descending, typename T, typename Compare>
+ScanResult simd_scan(const T* data, std::size_t size, Compare& compare) {
+    using Lanes = ScanLanes<T>;
+    constexpr auto WIDTH = Lanes::WIDTH;
+    // 昇順なら小さい方、降順なら大きい方を「前に来る」とみなす
+    auto before = [](auto a, auto b) { return Descending ? Lanes::less(b, a) : Lanes::less(a, b); };
+
+    auto lo = Lanes::load(data);
+    auto hi = lo;
+    auto index = ScanIndex::first();
+    auto lo_index = index;
+    auto hi_index = index;
+    const auto step = ScanIndex::broadcast(static_cast<int32_t>(WIDTH));
+    std::size_t i = WIDTH;
+    for (; i + WIDTH <= size; i += WIDTH) {
+        index = ScanIndex::add(index, step);
+        const auto x = Lanes::load(data + i);
+        const auto lower = before(x, lo);
+        lo = Lanes::select(lower, x, lo);
+        lo_index = ScanIndex::select(lower, index, lo_index);
+        if constexpr (FindMax) {
+            const auto higher = before(hi, x);
+            hi = Lanes::select(higher, x, hi);
+            hi_index = ScanIndex::select(higher, index, hi_index);
+        }
+    }
+
+    int32_t lo_positions[WIDTH];
+    int32_t hi_positions[WIDTH];
+    ScanIndex::store(lo_positions, lo_index);
+    ScanIndex::store(hi_positions, hi_index);
+    ScanResult result{static_cast<std::size_t>(lo_positions[0]), static_cast<std::size_t>(hi_positions[0])};
+    for (std::size_t lane = 1; lane < WIDTH; ++lane) {
+        const auto min = static_cast<std::size_t>(lo_positions[lane]);
+        if (compare(data[min], data[result.min]) || (!compare(data[result.min], data[min]) && min < result.min)) {
+            result.min = min;
+        }
+        if constexpr (FindMax) {
+            const auto max = static_cast<std::size_t>(hi_positions[lane]);
+            if (compare(data[result.max], data[max]) || (!compare(data[max], data[result.max]) && max < result.max)) {
+                result.max = max;
+            }
+        }
+    }
+    return scalar_scan<FindMax>(data, i, size, compare, result);
+}
+
+#else
+template <typename T>
+inline constexpr bool has_scan_lanes = false;
+#endif
+
+template <bool FindMax, typename T, typename Compare>
+ScanResult fast_scan(const T* data, std::size_t size, Compare& compare) {
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    if constexpr (has_scan_lanes<T>) {
+        // 位置は int32_t のレーンに持つ
+        if (size >= ScanLanes<T>::WIDTH && size <= static_cast<std::size_t>(std::numeric_limits<int32_t>::max())) {
+            return simd_scan<FindMax, is_descending<T, Compare>>(data, size, compare);
+        }
+    }
+#endif
+    return scalar_scan<FindMax>(data, 1, size, compare, {});
+}
+
+// [first, first + size) (size >= 1) で最小の要素 (FindMax なら最大の要素も) の位置を返す。
+// 比較回数は最小・最大それぞれ size - 1 回
+template <bool FindMax, typename Iterator, typename Compare>
+constexpr ScanResult scan(Iterator first, std::size_t size, Compare& compare) {
+    if constexpr (use_fast_scan<Iterator, Compare>) {
+        if (!std::is_constant_evaluated()) {
+            return fast_scan<FindMax>(std::to_address(first), size, compare);
+        }
+    }
+    auto min = first;
+    auto max = first;
+    const auto last = first + static_cast<std::ptrdiff_t>(size);
+    for (auto it = std::next(first); it != last; ++it) {
+        if (compare(*it, *min)) {
+            min = it;
+        }
+        if constexpr (FindMax) {
+            if (compare(*max, *it)) {
+                max = it;
             }
-            ++loopCount;
         }
+    }
+    return {static_cast<std::size_t>(min - first), static_cast<std::size_t>(max - first)};
+}
+
+}  // namespace detail::selection
+
+// 選択ソートを 1 パス (未確定の範囲から最小の要素を選んで先頭と交換する) ずつ進める。
+// selection_sort はこれを最後まで回したもので、async_sort はパスの合間に中断・再開する。
+// 連続したメモリ上の算術型を標準の比較関数でソートする場合、最小の要素は分岐なし (SSE4.1 / AVX2 では SIMD) で探す
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+class SelectionSortPasses {
+public:
+    constexpr SelectionSortPasses(Iterator begin, Iterator end, Comparator comparator = {},
+                                  Projection projection = {})
+        : first_(begin),
+          next_(begin),
+          end_(end),
+          compare_(detail::make_projected_comparator(std::move(comparator), std::move(projection))),
+          max_passes_(begin == end ? 0 : static_cast<size_t>(end - begin) - 1) {}
+
+    constexpr bool done() const { return end_ - next_ < 2; }
+
+    constexpr void run_pass() {
+        const auto a = next_;
+        const auto size = static_cast<size_t>(end_ - a);
+        const auto target = a + static_cast<std::ptrdiff_t>(detail::selection::scan<false>(a, size, compare_).min);
         if (target != a) {
-            std::swap(*a, *target);
+            std::ranges::iter_swap(a, target);
+        }
+        ++next_;
+        loopCount_ += static_cast<Result>(size - 1);
+        ++passCount_;
+    }
+
+    constexpr Result loop_count() const { return loopCount_; }
+    constexpr size_t pass_count() const { return passCount_; }
+    constexpr size_t max_passes() const { return max_passes_; }
+    // まだ確定していない範囲 [first, second) の位置
+    constexpr std::pair<size_t, size_t> range() const {
+        const auto next = static_cast<size_t>(next_ - first_);
+        return {next, done() ? next : static_cast<size_t>(end_ - first_)};
+    }
+
+private:
+    Iterator first_;
+    // [next_, end_) が未確定の範囲
+    Iterator next_;
+    Iterator end_;
+    decltype(detail::make_projected_comparator(std::declval<Comparator>(), std::declval<Projection>())) compare_;
+    size_t max_passes_;
+    Result loopCount_ = 0;
+    size_t passCount_ = 0;
+};
+
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr Result selection_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {}) {
+    if (begin == end || std::next(begin) == end) {
+        return 0;
+    }
+
+    // 大きな要素は交換のたびに動かさず、(キーの先頭, 位置) の組を同じ手順でソートしてから 1 回ずつ動かす
+    if constexpr (enable_indirect_sort<std::iter_value_t<Iterator>>) {
+        if (!std::is_constant_evaluated()) {
+            auto sorter = [](auto first, auto last, auto compare, auto key) {
+                return selection_sort<decltype(first), decltype(compare), Result>(first, last, compare, key);
+            };
+            return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
         }
     }
 
+    SelectionSortPasses<Iterator, Comparator, Result, Projection> passes(begin, end, comparator, projection);
+    run_passes(passes);
+    return passes.loop_count();
+}
+
+// 1 パスで最小と最大の要素を選び、未確定の範囲の先頭と末尾に置く (double-ended selection sort)。
+// パスの数は selection_sort の半分になり、SIMD の走査では 1 回の読み込みで最小と最大の両方を更新する。
+// 戻り値は比較回数 (1 パスで未確定の要素数 m に対して 2(m - 1) 回)
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr Result double_selection_sort(Iterator begin, Iterator end, Comparator comparator = {},
+                                       Projection projection = {}) {
+    if (begin == end || std::next(begin) == end) {
+        return 0;
+    }
+
+    if constexpr (enable_indirect_sort<std::iter_value_t<Iterator>>) {
+        if (!std::is_constant_evaluated()) {
+            auto sorter = [](auto first, auto last, auto compare, auto key) {
+                return double_selection_sort<decltype(first), decltype(compare), Result>(first, last, compare, key);
+            };
+            return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
+        }
+    }
+
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    Result loopCount = 0;
+    detail::PassReporter reporter(static_cast<size_t>(end - begin) / 2);
+    size_t pass = 0;
+    for (auto first = begin, last = end; last - first >= 2; ++first) {
+        const auto size = static_cast<size_t>(last - first);
+        const auto [min, max] = detail::selection::scan<true>(first, size, compare);
+        const auto min_it = first + static_cast<std::ptrdiff_t>(min);
+        auto max_it = first + static_cast<std::ptrdiff_t>(max);
+        if (min_it != first) {
+            std::ranges::iter_swap(first, min_it);
+            // 最大の要素が先頭にあった場合は、今の交換で min_it に移っている
+            if (max_it == first) {
+                max_it = min_it;
+            }
+        }
+        --last;
+        if (max_it != last) {
+            std::ranges::iter_swap(last, max_it);
+        }
+        loopCount += static_cast<Result>(2 * (size - 1));
+        ++pass;
+        if (reporter.enabled()) {
+            const auto unsorted_begin = static_cast<size_t>(first - begin) + 1;
+            const auto unsorted_end = std::max(static_cast<size_t>(last - begin), unsorted_begin);
+            reporter.pass_done(pass, unsorted_begin, unsorted_end, static_cast<size_t>(loopCount));
+        }
+    }
     return loopCount;
 }
 
-template <std::integral T, std::size_t N, typename Comparator = std::less<>>
-constexpr std::tuple<std::array<T, N>, size_t> selection_sort(const std::array<T, N>& input,
-                                                              Comparator comparator = {}) {
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> selection_sort(const std::array<T, N>& input, Comparator comparator = {},
+                                                              Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto loopCount = selection_sort(arr.begin(), arr.end(), comparator, projection);
+    return std::make_tuple(arr, loopCount);
+}
+
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> double_selection_sort(const std::array<T, N>& input,
+                                                                     Comparator comparator = {},
+                                                                     Projection projection = {}) {
     std::array<T, N> arr = input;
-    auto loopCount = selection_sort(arr.begin(), arr.end(), comparator);
+    auto loopCount = double_selection_sort(arr.begin(), arr.end(), comparator, projection);
     return std::make_tuple(arr, loopCount);
 }
 
 static_assert(std::get<0>(selection_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
 static_assert(std::get<0>(selection_sort(std::array{5, 3, 1, 4, 2}, std::greater<>())) == std::array{5, 4, 3, 2, 1});
+static_assert(std::get<1>(selection_sort(std::array{5, 3, 1, 4, 2})) == 10);
+static_assert(std::get<0>(double_selection_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
+static_assert(std::get<0>(double_selection_sort(std::array{5, 3, 1, 4, 2}, std::greater<>())) ==
+              std::array{5, 4, 3, 2, 1});
+static_assert(std::get<1>(double_selection_sort(std::array{5, 3, 1, 4, 2})) == 12);
 
 }  // namespace AlgorithmSamples::Sort
@@ -6,53 +6,193 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include "sort/adaptive_sort_result.hpp"
+#include "sort/indirect_sort.hpp"
+#include "sort/projection.hpp"
+#include "sort/sort_passes.hpp"
 
 namespace AlgorithmSamples::Sort {
 
-template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t>
-constexpr Result shaker_sort(Iterator begin, Iterator end, Comparator comparator = {}) {
+// シェーカーソートを 1 パス (往路で最大の要素を右端へ、復路で最小の要素を左端へ送る 1 往復) ずつ進める。
+// shaker_sort はこれを最後まで回したもので、async_sort はパスの合間に中断・再開する
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+class ShakerSortPasses {
+public:
+    constexpr ShakerSortPasses(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {})
+        : first_(begin),
+          left_(begin),
+          right_(begin == end ? end : std::prev(end)),
+          compare_(detail::make_projected_comparator(std::move(comparator), std::move(projection))),
+          max_passes_(static_cast<size_t>(end - begin) / 2) {}
+
+    constexpr bool done() const { return !(left_ < right_); }
+
+    constexpr void run_pass() {
+        auto left = left_;
+        auto right = right_;
+        Result loopCount = 0;
+
+        // left to right
+        for (auto i = left; i != right; ++i) {
+            auto next = std::next(i);
+            if (compare_(*next, *i)) {
+                std::ranges::iter_swap(i, next);
+            }
+            ++loopCount;
+        }
+        --right;
+
+        // right to left
+        for (auto i = right; i != left; --i) {
+            auto prev = std::prev(i);
+            if (compare_(*i, *prev)) {
+                std::ranges::iter_swap(i, prev);
+            }
+            ++loopCount;
+        }
+        ++left;
+
+        left_ = left;
+        right_ = right;
+        loopCount_ += loopCount;
+        ++passCount_;
+    }
+
+    constexpr Result loop_count() const { return loopCount_; }
+    constexpr size_t pass_count() const { return passCount_; }
+    constexpr size_t max_passes() const { return max_passes_; }
+    // まだ確定していない範囲 [first, second) の位置
+    constexpr std::pair<size_t, size_t> range() const {
+        const auto left = static_cast<size_t>(left_ - first_);
+        return {left, done() ? left : static_cast<size_t>(right_ - first_) + 1};
+    }
+
+private:
+    Iterator first_;
+    // [left_, right_] が未確定の範囲
+    Iterator left_;
+    Iterator right_;
+    decltype(detail::make_projected_comparator(std::declval<Comparator>(), std::declval<Projection>())) compare_;
+    size_t max_passes_;
+    Result loopCount_ = 0;
+    size_t passCount_ = 0;
+};
+
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr Result shaker_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {}) {
     if (begin == end || std::next(begin) == end) {
         return 0;
     }
 
-    Result loopCount = 0;
+    // 大きな要素は交換のたびに動かさず、(キーの先頭, 位置) の組を同じ手順でソートしてから 1 回ずつ動かす
+    if constexpr (enable_indirect_sort<std::iter_value_t<Iterator>>) {
+        if (!std::is_constant_evaluated()) {
+            auto sorter = [](auto first, auto last, auto compare, auto key) {
+                return shaker_sort<decltype(first), decltype(compare), Result>(first, last, compare, key);
+            };
+            return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
+        }
+    }
+
+    ShakerSortPasses<Iterator, Comparator, Result, Projection> passes(begin, end, comparator, projection);
+    run_passes(passes);
+    return passes.loop_count();
+}
 
+// 適応型のシェーカーソート。往路で最後に交換した位置を右端に、復路で最後に交換した位置を左端にして範囲を縮め、
+// 交換のない走査で終了する。ソート済みなら n - 1 回、k 要素だけずれた入力 (末尾への追記など) なら
+// ずれの向きによらず O(nk) 回の比較で済む。passCount は往路・復路をそれぞれ 1 回と数える
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr AdaptiveSortResult<Result> adaptive_shaker_sort(Iterator begin, Iterator end, Comparator comparator = {},
+                                                          Projection projection = {}) {
+    AdaptiveSortResult<Result> result;
+    if (begin == end || std::next(begin) == end) {
+        return result;
+    }
+
+    // 大きな要素は交換のたびに動かさず、(キーの先頭, 位置) の組を同じ手順でソートしてから 1 回ずつ動かす
+    if constexpr (enable_indirect_sort<std::iter_value_t<Iterator>>) {
+        if (!std::is_constant_evaluated()) {
+            auto sorter = [](auto first, auto last, auto compare, auto key) {
+                return adaptive_shaker_sort<decltype(first), decltype(compare), Result>(first, last, compare, key);
+            };
+            return detail::indirect::sort_indirect(begin, end, comparator, projection, sorter);
+        }
+    }
+
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    // [left, right] が未確定の範囲
     auto left = begin;
     auto right = std::prev(end);
+    detail::PassReporter reporter(static_cast<size_t>(end - begin) - 1);
+    auto report = [&] {
+        if (reporter.enabled()) {
+            const auto unsorted_begin = static_cast<size_t>(left - begin);
+            const auto unsorted_end = left < right ? static_cast<size_t>(right - begin) + 1 : unsorted_begin;
+            reporter.pass_done(result.passCount, unsorted_begin, unsorted_end, static_cast<size_t>(result.loopCount));
+        }
+    };
 
     while (left < right) {
         // left to right
+        auto last_swap = left;
         for (auto i = left; i != right; ++i) {
             auto next = std::next(i);
-            if (comparator(*next, *i)) {
-                std::swap(*i, *next);
+            if (compare(*next, *i)) {
+                std::ranges::iter_swap(i, next);
+                last_swap = i;
             }
-            ++loopCount;
+            ++result.loopCount;
+        }
+        ++result.passCount;
+        right = last_swap;
+        report();
+        if (left == right) {
+            break;
         }
-        --right;
 
         // right to left
+        last_swap = right;
         for (auto i = right; i != left; --i) {
             auto prev = std::prev(i);
-            if (comparator(*i, *prev)) {
-                std::swap(*i, *prev);
+            if (compare(*i, *prev)) {
+                std::ranges::iter_swap(i, prev);
+                last_swap = i;
             }
-            ++loopCount;
+            ++result.loopCount;
         }
-        ++left;
+        ++result.passCount;
+        left = last_swap;
+        report();
     }
 
-    return loopCount;
+    return result;
 }
 
-template <std::integral T, std::size_t N, typename Comparator = std::less<>>
-constexpr std::tuple<std::array<T, N>, size_t> shaker_sort(const std::array<T, N>& input, Comparator comparator = {}) {
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> shaker_sort(const std::array<T, N>& input, Comparator comparator = {},
+                                                           Projection projection = {}) {
     std::array<T, N> arr = input;
-    auto loopCount = shaker_sort(arr.begin(), arr.end(), comparator);
+    auto loopCount = shaker_sort(arr.begin(), arr.end(), comparator, projection);
     return std::make_tuple(arr, loopCount);
 }
 
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, AdaptiveSortResult<>> adaptive_shaker_sort(const std::array<T, N>& input,
+                                                                                  Comparator comparator = {},
+                                                                                  Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto result = adaptive_shaker_sort(arr.begin(), arr.end(), comparator, projection);
+    return std::make_tuple(arr, result);
+}
+
 static_assert(std::get<0>(shaker_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
 static_assert(std::get<0>(shaker_sort(std::array{5, 3, 1, 4, 2}, std::greater<>())) == std::array{5, 4, 3, 2, 1});
+static_assert(std::get<1>(shaker_sort(std::array{5, 3, 1, 4, 2})) == 10);
+static_assert(std::get<0>(adaptive_shaker_sort(std::array{5, 3, 1, 4, 2})) == std::array{1, 2, 3, 4, 5});
+static_assert(std::get<1>(adaptive_shaker_sort(std::array{1, 2, 3, 4, 5})) == AdaptiveSortResult<>{4, 1});
 
 }  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,38 @@
+﻿#pragma once
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "sort/pass_hooks.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// 1 パスずつ進められるソート (BubbleSortPasses, ShakerSortPasses, SelectionSortPasses, OddEvenSortPasses)
+template <typename P>
+concept SortPasses = requires(P& passes, const P& const_passes) {
+    passes.run_pass();
+    { const_passes.done() } -> std::convertible_to<bool>;
+    { const_passes.loop_count() } -> std::integral;
+    { const_passes.pass_count() } -> std::convertible_to<size_t>;
+    { const_passes.max_passes() } -> std::convertible_to<size_t>;
+};
+
+// passes を最後まで進める。パスの終わりごとに進み具合を報告する (PassReporter)。
+// パスのクラスが range() (まだ確定していない範囲の位置の組) を持っていれば、それも報告する
+template <SortPasses Passes>
+constexpr void run_passes(Passes& passes) {
+    detail::PassReporter reporter(passes.max_passes());
+    while (!passes.done()) {
+        passes.run_pass();
+        if (reporter.enabled()) {
+            size_t range_begin = 0;
+            size_t range_end = 0;
+            if constexpr (requires { passes.range(); }) {
+                std::tie(range_begin, range_end) = passes.range();
+            }
+            reporter.pass_done(passes.pass_count(), range_begin, range_end, static_cast<size_t>(passes.loop_count()));
+        }
+    }
+}
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,187 @@
+﻿#pragma once
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "sort/projection.hpp"
+#include "sort/tim_sort.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// 挿入をまとめて受け付け、次に順序付きで読むときに一括でマージするソート済み配列 (flat_multiset 相当)。
+// insert() は未マージのバッファに積むだけで O(1)。begin() / lower_bound() などの順序付きの読み出しで、
+// バッファを安定ソートしてから後ろ向きにマージする。k 件のバッファを n 件にマージする比較は O(k log(n / k)) 回で、
+// ずらすのは挿入位置より後ろの要素だけ (昇順に届く追記なら末尾に足すだけ)。
+// 等しい要素は挿入順に並ぶ (std::multiset と同じ)。
+// 順序付きの読み出しは const でもマージを行うので、const なメンバ関数も別スレッドから同時に呼んではいけない。
+// insert() は (std::vector と同じく) 取得済みのイテレータを無効にする
+template <typename T, typename Comparator = std::less<>, typename Projection = std::identity>
+class SortedVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using const_iterator = typename std::vector<T>::const_iterator;
+    using iterator = const_iterator;
+
+    explicit SortedVector(Comparator comparator = {}, Projection projection = {})
+        : comparator_(std::move(comparator)), projection_(std::move(projection)) {}
+
+    template <std::input_iterator InputIterator, std::sentinel_for<InputIterator> Sentinel>
+    SortedVector(InputIterator first, Sentinel last, Comparator comparator = {}, Projection projection = {})
+        : SortedVector(std::move(comparator), std::move(projection)) {
+        insert(std::move(first), std::move(last));
+    }
+
+    void insert(const T& value) { pending_.push_back(value); }
+    void insert(T&& value) { pending_.push_back(std::move(value)); }
+
+    template <std::input_iterator InputIterator, std::sentinel_for<InputIterator> Sentinel>
+    void insert(InputIterator first, Sentinel last) {
+        for (; first != last; ++first) {
+            pending_.push_back(*first);
+        }
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        pending_.emplace_back(std::forward<Args>(args)...);
+    }
+
+    // 未マージの挿入をマージする。順序付きの読み出しは自動でこれを呼ぶ
+    void flush() const { merge_pending(); }
+
+    size_type size() const { return sorted_.size() + pending_.size(); }
+    bool empty() const { return sorted_.empty() && pending_.empty(); }
+    // まだマージしていない挿入の数
+    size_type pending_size() const { return pending_.size(); }
+
+    void reserve(size_type capacity) { sorted_.reserve(capacity); }
+
+    void clear() {
+        sorted_.clear();
+        pending_.clear();
+    }
+
+    const_iterator begin() const {
+        merge_pending();
+        return sorted_.begin();
+    }
+    const_iterator end() const {
+        merge_pending();
+        return sorted_.end();
+    }
+
+    const T& operator[](size_type index) const {
+        merge_pending();
+        return sorted_[index];
+    }
+    const T& front() const {
+        merge_pending();
+        return sorted_.front();
+    }
+    const T& back() const {
+        merge_pending();
+        return sorted_.back();
+    }
+
+    // key はソートのキー (projection を適用した値) と比べられる値
+    template <typename Key>
+    const_iterator lower_bound(const Key& key) const {
+        merge_pending();
+        return std::ranges::lower_bound(sorted_, key, comparator_, projection_);
+    }
+
+    template <typename Key>
+    const_iterator upper_bound(const Key& key) const {
+        merge_pending();
+        return std::ranges::upper_bound(sorted_, key, comparator_, projection_);
+    }
+
+    template <typename Key>
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+        merge_pending();
+        auto range = std::ranges::equal_range(sorted_, key, comparator_, projection_);
+        return {range.begin(), range.end()};
+    }
+
+    template <typename Key>
+    bool contains(const Key& key) const {
+        auto [first, last] = equal_range(key);
+        return first != last;
+    }
+
+    template <typename Key>
+    size_type count(const Key& key) const {
+        auto [first, last] = equal_range(key);
+        return static_cast<size_type>(last - first);
+    }
+
+    // position は最後の insert() より後に取得したイテレータであること
+    const_iterator erase(const_iterator position) {
+        assert(pending_.empty());
+        return sorted_.erase(position);
+    }
+
+    template <typename Key>
+    size_type erase_key(const Key& key) {
+        auto [first, last] = equal_range(key);
+        const auto count = static_cast<size_type>(last - first);
+        sorted_.erase(first, last);
+        return count;
+    }
+
+    // マージ済みの配列を取り出す。コンテナは空になる
+    std::vector<T> extract() {
+        merge_pending();
+        return std::exchange(sorted_, {});
+    }
+
+private:
+    void merge_pending() const {
+        if (pending_.empty()) {
+            return;
+        }
+        auto compare = detail::make_projected_comparator(comparator_, projection_);
+        tim_sort(pending_.begin(), pending_.end(), comparator_, projection_);
+
+        // 既存の要素がすべてバッファ以下なら末尾に足すだけで済む
+        if (sorted_.empty() || !compare(pending_.front(), sorted_.back())) {
+            sorted_.insert(sorted_.end(), std::make_move_iterator(pending_.begin()),
+                           std::make_move_iterator(pending_.end()));
+            pending_.clear();
+            return;
+        }
+
+        // 配列を k 要素伸ばし (伸ばした分はバッファへ戻す)、後ろから詰める。バッファの大きい順に、
+        // それより大きい既存の要素の塊を末尾側からのギャロップで見つけ、1 回の move_backward でずらす
+        const auto old_size = static_cast<std::ptrdiff_t>(sorted_.size());
+        sorted_.insert(sorted_.end(), std::make_move_iterator(pending_.begin()),
+                       std::make_move_iterator(pending_.end()));
+        std::move(sorted_.begin() + old_size, sorted_.end(), pending_.begin());
+
+        const auto base = sorted_.begin();
+        auto dest = sorted_.end();
+        // sorted_[0, remaining) がまだ動かしていない既存の要素
+        auto remaining = old_size;
+        for (auto value = pending_.rbegin(); value != pending_.rend(); ++value) {
+            // value 以下の既存の要素の数。等しい要素の後ろに入れる
+            const auto position =
+                remaining == 0 ? 0 : detail::tim::gallop_right(*value, base, remaining, remaining - 1, compare);
+            dest = std::move_backward(base + position, base + remaining, dest);
+            *--dest = std::move(*value);
+            remaining = position;
+        }
+        pending_.clear();
+    }
+
+    Comparator comparator_;
+    Projection projection_;
+    mutable std::vector<T> sorted_;
+    mutable std::vector<T> pending_;
+};
+
+}  // namespace AlgorithmSamples::Sort
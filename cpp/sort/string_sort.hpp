@@ -0,0 +1,206 @@
+﻿#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "sort/indirect_sort.hpp"
+#include "sort/pdq_sort.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// projection が返す値を、要素が生きている間有効な std::string_view として扱えること
+template <typename Iterator, typename Projection>
+concept StringKeyProjection =
+    std::convertible_to<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>, std::string_view> &&
+    (std::is_lvalue_reference_v<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>> ||
+     std::same_as<std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>,
+                  std::string_view>);
+
+namespace detail::string_sort {
+
+// これより短い区間は挿入ソートで処理する
+inline constexpr std::ptrdiff_t INSERTION_SORT_THRESHOLD = 32;
+// これより長い区間は ninther でピボットを選ぶ
+inline constexpr std::ptrdiff_t NINTHER_THRESHOLD = 128;
+
+struct Entry {
+    // key の depth バイト目から 8 バイト。ソート中の比較はまずこの整数で行う
+    uint64_t cache;
+    std::string_view key;
+    std::size_t index;
+};
+
+inline uint64_t load_big_endian(const char* data) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data, sizeof(chunk));
+    if constexpr (std::endian::native == std::endian::little) {
+        chunk = std::byteswap(chunk);
+    }
+    return chunk;
+}
+
+// key の depth バイト目から 8 バイトを上位から詰めた整数。足りない分は 0 で埋める。
+// 整数として比べた大小が、その 8 バイトの (unsigned char での) 辞書順と一致する
+inline uint64_t load_chunk(std::string_view key, std::size_t depth) {
+    if (depth >= key.size()) {
+        return 0;
+    }
+    const auto remaining = key.size() - depth;
+    if (remaining >= 8) {
+        return load_big_endian(key.data() + depth);
+    }
+    uint64_t chunk = 0;
+    for (std::size_t i = 0; i < remaining; ++i) {
+        chunk |= uint64_t{static_cast<unsigned char>(key[depth + i])} << (56 - 8 * i);
+    }
+    return chunk;
+}
+
+// depth バイト目まで等しく、cache に depth バイト目からの 8 バイトを持つ a と b を比べる
+inline bool less_from(const Entry& a, const Entry& b, std::size_t depth) {
+    if (a.cache != b.cache) {
+        return a.cache < b.cache;
+    }
+    return a.key.substr(std::min(depth, a.key.size())) < b.key.substr(std::min(depth, b.key.size()));
+}
+
+template <typename Result>
+void insertion_sort(Entry* first, Entry* last, std::size_t depth, Result& loopCount) {
+    if (first == last) {
+        return;
+    }
+    for (auto cur = first + 1; cur != last; ++cur) {
+        auto sift = cur;
+        if (less_from(*sift, *(sift - 1), depth)) {
+            auto tmp = *sift;
+            do {
+                *sift = *(sift - 1);
+                --sift;
+                ++loopCount;
+            } while (sift != first && less_from(tmp, *(sift - 1), depth));
+            *sift = tmp;
+        }
+        ++loopCount;
+    }
+}
+
+inline uint64_t median3(uint64_t a, uint64_t b, uint64_t c) {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+inline uint64_t choose_pivot(const Entry* first, const Entry* last) {
+    const auto size = last - first;
+    const auto half = size / 2;
+    if (size > NINTHER_THRESHOLD) {
+        const auto step = size / 8;
+        return median3(median3(first[0].cache, first[step].cache, first[2 * step].cache),
+                       median3(first[half - step].cache, first[half].cache, first[half + step].cache),
+                       median3(first[size - 1 - 2 * step].cache, first[size - 1 - step].cache, first[size - 1].cache));
+    }
+    return median3(first[0].cache, first[half].cache, first[size - 1].cache);
+}
+
+// multikey quicksort (Bentley, Sedgewick) を 1 文字ずつではなく 8 バイトずつ行う。
+// [first, last) は先頭 depth バイトが等しく、cache に depth バイト目からの 8 バイトを読み込んである
+template <typename Result>
+void multikey_quicksort(Entry* first, Entry* last, std::size_t depth, Result& loopCount) {
+    while (last - first > INSERTION_SORT_THRESHOLD) {
+        // cache がピボット未満・等しい・より大きいの 3 つに分ける
+        const auto pivot = choose_pivot(first, last);
+        auto lt = first;
+        auto i = first;
+        auto gt = last;
+        while (i < gt) {
+            if (i->cache < pivot) {
+                std::swap(*lt++, *i++);
+            } else if (pivot < i->cache) {
+                std::swap(*i, *--gt);
+            } else {
+                ++i;
+            }
+            ++loopCount;
+        }
+
+        // [lt, gt) は depth + 8 バイトまで等しい。そこで終わる文字列は互いに 0 埋めの分だけ異なるので長さ順に並べ、
+        // 続きのある文字列 (どれも終わる文字列より大きい) は次の 8 バイトで分ける
+        auto finished = std::partition(lt, gt, [&](const Entry& e) { return e.key.size() <= depth + 8; });
+        loopCount += pdq_sort<Entry*, std::less<>, Result>(lt, finished, std::less<>(),
+                                                           [](const Entry& e) { return e.key.size(); });
+        for (auto e = finished; e != gt; ++e) {
+            e->cache = load_chunk(e->key, depth + 8);
+        }
+
+        // 3 つのうち最も大きい部分をループで続け、残りの 2 つを再帰する。
+        // 再帰する部分はどれも全体の半分以下なので、再帰の深さは O(log n) に収まる
+        const auto less_size = lt - first;
+        const auto equal_size = gt - finished;
+        const auto greater_size = last - gt;
+        if (equal_size >= less_size && equal_size >= greater_size) {
+            multikey_quicksort(first, lt, depth, loopCount);
+            multikey_quicksort(gt, last, depth, loopCount);
+            first = finished;
+            last = gt;
+            depth += 8;
+        } else if (less_size >= greater_size) {
+            multikey_quicksort(finished, gt, depth + 8, loopCount);
+            multikey_quicksort(gt, last, depth, loopCount);
+            last = lt;
+        } else {
+            multikey_quicksort(first, lt, depth, loopCount);
+            multikey_quicksort(finished, gt, depth + 8, loopCount);
+            first = gt;
+        }
+    }
+    insertion_sort(first, last, depth, loopCount);
+}
+
+}  // namespace detail::string_sort
+
+// 文字列キー専用のソート。キーを std::string_view として見て、バイト列の辞書順 (std::string の operator< と同じ)
+// に並べる。各キーの先頭 8 バイトを整数として (キャッシュ, キー, 位置) の組に持たせ、8 バイト単位の
+// multikey quicksort で比較をほぼ整数比較だけにする。ヒープ上の文字列を読むのは、先頭が等しい組を次の 8 バイトへ
+// 進めるときだけ。最後に要素をソート後の順に作業領域へムーブしてから書き戻す (巡回置換をたどるより、読み出しが
+// 互いに独立する分速い)。comparator は std::less<> か std::greater<> のみ。安定ソートではない。
+// n 要素分の組と作業領域を確保する
+template <std::random_access_iterator Iterator, detail::indirect::StandardOrder Comparator = std::less<>,
+          std::integral Result = size_t, typename Projection = std::identity>
+    requires StringKeyProjection<Iterator, Projection>
+Result string_sort(Iterator begin, Iterator end, Comparator = {}, Projection projection = {}) {
+    Result loopCount = 0;
+    const auto size = static_cast<std::size_t>(end - begin);
+    if (size < 2) {
+        return loopCount;
+    }
+
+    std::vector<detail::string_sort::Entry> entries;
+    entries.reserve(size);
+    std::size_t index = 0;
+    for (auto it = begin; it != end; ++it) {
+        const std::string_view key = std::invoke(projection, *it);
+        entries.push_back({detail::string_sort::load_chunk(key, 0), key, index++});
+    }
+
+    detail::string_sort::multikey_quicksort(entries.data(), entries.data() + entries.size(), 0, loopCount);
+    if constexpr (std::same_as<Comparator, std::greater<>>) {
+        std::ranges::reverse(entries);
+    }
+
+    std::vector<std::iter_value_t<Iterator>> sorted;
+    sorted.reserve(size);
+    for (const auto& entry : entries) {
+        sorted.push_back(std::move(begin[static_cast<std::ptrdiff_t>(entry.index)]));
+    }
+    std::ranges::move(sorted, begin);
+    loopCount += static_cast<Result>(size);
+    return loopCount;
+}
+
+}  // namespace AlgorithmSamples::Sort
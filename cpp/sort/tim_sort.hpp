@@ -0,0 +1,429 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "sort/projection.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+namespace detail::tim {
+
+// これより短い入力はランを 1 本だけ作り、二分挿入ソートで仕上げる (マージしないので作業領域も使わない)
+inline constexpr std::ptrdiff_t MIN_MERGE = 64;
+// 一方のランから連続してこの回数だけ要素が選ばれたら、ギャロップモードに切り替える
+inline constexpr std::ptrdiff_t MIN_GALLOP = 7;
+// ランのスタックの深さの上限。スタック上のランの長さはフィボナッチ数列より速く増えるので、
+// 64 ビットの要素数ならこれで足りる
+inline constexpr std::size_t MAX_PENDING_RUNS = 96;
+
+// ランの最小長。n をこれで割った商が 2 のべき乗に近くなり、マージが均等になるように選ぶ
+constexpr std::ptrdiff_t min_run_length(std::ptrdiff_t n) {
+    std::ptrdiff_t r = 0;
+    while (n >= MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// [begin, begin + start) が整列済みとして、残りを二分探索で挿入位置を探して挿入する (安定)
+template <typename Iterator, typename Comparator>
+void binary_insertion_sort(Iterator begin, Iterator end, Iterator start, Comparator& comparator) {
+    for (; start != end; ++start) {
+        auto value = std::move(*start);
+        auto pos = std::upper_bound(begin, start, value, comparator);
+        std::move_backward(pos, start, std::next(start));
+        *pos = std::move(value);
+    }
+}
+
+// begin から始まるランの長さを返す。狭義の降順ランは反転して昇順にする (等しい要素を含まないので安定)
+template <typename Iterator, typename Comparator>
+std::ptrdiff_t count_run_and_make_ascending(Iterator begin, Iterator end, Comparator& comparator) {
+    auto run_end = std::next(begin);
+    if (run_end == end) {
+        return 1;
+    }
+    if (comparator(*run_end, *begin)) {
+        while (++run_end != end && comparator(*run_end, *std::prev(run_end))) {
+        }
+        std::reverse(begin, run_end);
+    } else {
+        while (++run_end != end && !comparator(*run_end, *std::prev(run_end))) {
+        }
+    }
+    return run_end - begin;
+}
+
+// 整列済みの base[0, size) で key を入れる位置のうち最も左 (base[k - 1] < key <= base[k]) を返す。
+// hint から 1, 3, 7, ... と間隔を広げて範囲を絞ってから二分探索するので、hint の近くなら O(log d) で済む
+template <typename Iterator, typename T, typename Comparator>
+std::ptrdiff_t gallop_left(const T& key, Iterator base, std::ptrdiff_t size, std::ptrdiff_t hint,
+                           Comparator& comparator) {
+    std::ptrdiff_t last_offset = 0;
+    std::ptrdiff_t offset = 1;
+    if (comparator(base[hint], key)) {
+        // base[hint + last_offset] < key <= base[hint + offset] となるまで右へ
+        const auto max_offset = size - hint;
+        while (offset < max_offset && comparator(base[hint + offset], key)) {
+            last_offset = offset;
+            offset = (offset << 1) + 1;
+        }
+        offset = std::min(offset, max_offset);
+        last_offset += hint;
+        offset += hint;
+    } else {
+        // base[hint - offset] < key <= base[hint - last_offset] となるまで左へ
+        const auto max_offset = hint + 1;
+        while (offset < max_offset && !comparator(base[hint - offset], key)) {
+            last_offset = offset;
+            offset = (offset << 1) + 1;
+        }
+        offset = std::min(offset, max_offset);
+        std::tie(last_offset, offset) = std::pair(hint - offset, hint - last_offset);
+    }
+    // base[last_offset] < key <= base[offset]
+    return std::lower_bound(base + (last_offset + 1), base + offset, key, comparator) - base;
+}
+
+// gallop_left と同様だが、等しい要素の最も右 (base[k - 1] <= key < base[k]) を返す
+template <typename Iterator, typename T, typename Comparator>
+std::ptrdiff_t gallop_right(const T& key, Iterator base, std::ptrdiff_t size, std::ptrdiff_t hint,
+                            Comparator& comparator) {
+    std::ptrdiff_t last_offset = 0;
+    std::ptrdiff_t offset = 1;
+    if (comparator(key, base[hint])) {
+        const auto max_offset = hint + 1;
+        while (offset < max_offset && comparator(key, base[hint - offset])) {
+            last_offset = offset;
+            offset = (offset << 1) + 1;
+        }
+        offset = std::min(offset, max_offset);
+        std::tie(last_offset, offset) = std::pair(hint - offset, hint - last_offset);
+    } else {
+        const auto max_offset = size - hint;
+        while (offset < max_offset && !comparator(key, base[hint + offset])) {
+            last_offset = offset;
+            offset = (offset << 1) + 1;
+        }
+        offset = std::min(offset, max_offset);
+        last_offset += hint;
+        offset += hint;
+    }
+    // base[last_offset] <= key < base[offset]
+    return std::upper_bound(base + (last_offset + 1), base + offset, key, comparator) - base;
+}
+
+template <typename Iterator, typename Comparator>
+class TimSorter {
+public:
+    using value_type = std::iter_value_t<Iterator>;
+
+    TimSorter(Iterator begin, Comparator& comparator, std::pmr::memory_resource* resource)
+        : begin_(begin), comparator_(comparator), buffer_(resource) {}
+
+    void sort(std::ptrdiff_t size) {
+        if (size >= MIN_MERGE) {
+            // 作業領域は最初に一度だけ確保する (マージする短い方のランは全体の半分以下)
+            buffer_.reserve(static_cast<std::size_t>(size / 2));
+        }
+
+        const auto min_run = min_run_length(size);
+        for (std::ptrdiff_t low = 0; low < size;) {
+            auto run = count_run_and_make_ascending(begin_ + low, begin_ + size, comparator_);
+            if (run < min_run) {
+                // 短いランは min_run (残りがそれより短ければ残り全部) まで伸ばす
+                const auto forced = std::min(min_run, size - low);
+                binary_insertion_sort(begin_ + low, begin_ + (low + forced), begin_ + (low + run), comparator_);
+                run = forced;
+            }
+            runs_[pending_++] = {low, run};
+            merge_collapse();
+            low += run;
+        }
+        while (pending_ > 1) {
+            auto n = pending_ - 2;
+            if (n > 0 && runs_[n - 1].size < runs_[n + 1].size) {
+                --n;
+            }
+            merge_at(n);
+        }
+    }
+
+private:
+    struct Run {
+        std::ptrdiff_t base;
+        std::ptrdiff_t size;
+    };
+
+    // スタック上のランの長さが、上から A, B, C, D のとき
+    // B > A かつ C > B + A かつ D > C + B を保つようにマージする
+    void merge_collapse() {
+        while (pending_ > 1) {
+            auto n = pending_ - 2;
+            const auto size = [&](std::size_t i) { return runs_[i].size; };
+            if ((n > 0 && size(n - 1) <= size(n) + size(n + 1)) ||
+                (n > 1 && size(n - 2) <= size(n - 1) + size(n))) {
+                if (size(n - 1) < size(n + 1)) {
+                    --n;
+                }
+            } else if (size(n) > size(n + 1)) {
+                break;
+            }
+            merge_at(n);
+        }
+    }
+
+    // スタックの i 番目と i + 1 番目のランをマージする
+    void merge_at(std::size_t i) {
+        auto base1 = runs_[i].base;
+        auto size1 = runs_[i].size;
+        const auto base2 = runs_[i + 1].base;
+        auto size2 = runs_[i + 1].size;
+
+        runs_[i].size = size1 + size2;
+        if (i + 3 == pending_) {
+            runs_[i + 1] = runs_[i + 2];
+        }
+        --pending_;
+
+        // ラン 1 の先頭のうち、ラン 2 の先頭以下の要素はすでに最終位置にある
+        const auto skip = gallop_right(begin_[base2], begin_ + base1, size1, 0, comparator_);
+        base1 += skip;
+        size1 -= skip;
+        if (size1 == 0) {
+            return;
+        }
+        // ラン 2 の末尾のうち、ラン 1 の末尾以上の要素もすでに最終位置にある
+        size2 = gallop_left(begin_[base1 + size1 - 1], begin_ + base2, size2, size2 - 1, comparator_);
+        if (size2 == 0) {
+            return;
+        }
+
+        // 短い方のランだけを作業領域に退避する
+        if (size1 <= size2) {
+            merge_low(base1, size1, size2);
+        } else {
+            merge_high(base1, size1, size2);
+        }
+    }
+
+    // ラン 1 を作業領域に移し、前から順にマージする。
+    // 前提: ラン 2 の先頭 < ラン 1 の先頭、ラン 1 の末尾 > ラン 2 の末尾
+    void merge_low(std::ptrdiff_t base, std::ptrdiff_t size1, std::ptrdiff_t size2) {
+        auto a = begin_ + base;
+        buffer_.assign(std::make_move_iterator(a), std::make_move_iterator(a + size1));
+        auto tmp = buffer_.begin();
+
+        std::ptrdiff_t cursor1 = 0;      // tmp 上のラン 1 の先頭
+        std::ptrdiff_t cursor2 = size1;  // a 上のラン 2 の先頭
+        std::ptrdiff_t dest = 0;
+
+        a[dest++] = std::move(a[cursor2++]);
+        --size2;
+        auto min_gallop = min_gallop_;
+        [&] {
+            if (size2 == 0 || size1 == 1) {
+                return;
+            }
+            while (true) {
+                // 1 要素ずつ比べながら、どちらかが連続して選ばれる回数を数える
+                std::ptrdiff_t count1 = 0;
+                std::ptrdiff_t count2 = 0;
+                do {
+                    if (comparator_(a[cursor2], tmp[cursor1])) {
+                        a[dest++] = std::move(a[cursor2++]);
+                        ++count2;
+                        count1 = 0;
+                        if (--size2 == 0) {
+                            return;
+                        }
+                    } else {
+                        a[dest++] = std::move(tmp[cursor1++]);
+                        ++count1;
+                        count2 = 0;
+                        if (--size1 == 1) {
+                            return;
+                        }
+                    }
+                } while ((count1 | count2) < min_gallop);
+
+                // 連続が続きそうなので、相手の先頭が入る位置まで指数探索でまとめて移す
+                do {
+                    count1 = gallop_right(a[cursor2], tmp + cursor1, size1, 0, comparator_);
+                    if (count1 != 0) {
+                        std::move(tmp + cursor1, tmp + (cursor1 + count1), a + dest);
+                        dest += count1;
+                        cursor1 += count1;
+                        size1 -= count1;
+                        if (size1 <= 1) {
+                            return;
+                        }
+                    }
+                    a[dest++] = std::move(a[cursor2++]);
+                    if (--size2 == 0) {
+                        return;
+                    }
+
+                    count2 = gallop_left(tmp[cursor1], a + cursor2, size2, 0, comparator_);
+                    if (count2 != 0) {
+                        std::move(a + cursor2, a + (cursor2 + count2), a + dest);
+                        dest += count2;
+                        cursor2 += count2;
+                        size2 -= count2;
+                        if (size2 == 0) {
+                            return;
+                        }
+                    }
+                    a[dest++] = std::move(tmp[cursor1++]);
+                    if (--size1 == 1) {
+                        return;
+                    }
+                    --min_gallop;
+                } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+                // ギャロップが効いているうちは入りやすく、効かなくなったら入りにくくする
+                min_gallop = std::max<std::ptrdiff_t>(min_gallop, 0) + 2;
+            }
+        }();
+        min_gallop_ = std::max<std::ptrdiff_t>(min_gallop, 1);
+
+        if (size1 == 1) {
+            // ラン 1 の最後の要素は、ラン 2 の残りすべてより後ろに来る
+            std::move(a + cursor2, a + (cursor2 + size2), a + dest);
+            a[dest + size2] = std::move(tmp[cursor1]);
+        } else {
+            std::move(tmp + cursor1, tmp + (cursor1 + size1), a + dest);
+        }
+    }
+
+    // ラン 2 を作業領域に移し、後ろから順にマージする。前提は merge_low と同じ。
+    // ラン 1 の残りは a[0, size1)、ラン 2 の残りは tmp[0, size2)、次の書き込み先は a[size1 + size2 - 1]
+    void merge_high(std::ptrdiff_t base, std::ptrdiff_t size1, std::ptrdiff_t size2) {
+        auto a = begin_ + base;
+        buffer_.assign(std::make_move_iterator(a + size1), std::make_move_iterator(a + (size1 + size2)));
+        auto tmp = buffer_.begin();
+
+        a[size1 + size2 - 1] = std::move(a[size1 - 1]);
+        --size1;
+        auto min_gallop = min_gallop_;
+        [&] {
+            if (size1 == 0 || size2 == 1) {
+                return;
+            }
+            while (true) {
+                std::ptrdiff_t count1 = 0;
+                std::ptrdiff_t count2 = 0;
+                do {
+                    if (comparator_(tmp[size2 - 1], a[size1 - 1])) {
+                        a[size1 + size2 - 1] = std::move(a[size1 - 1]);
+                        --size1;
+                        ++count1;
+                        count2 = 0;
+                        if (size1 == 0) {
+                            return;
+                        }
+                    } else {
+                        a[size1 + size2 - 1] = std::move(tmp[size2 - 1]);
+                        --size2;
+                        ++count2;
+                        count1 = 0;
+                        if (size2 == 1) {
+                            return;
+                        }
+                    }
+                } while ((count1 | count2) < min_gallop);
+
+                do {
+                    count1 = size1 - gallop_right(tmp[size2 - 1], a, size1, size1 - 1, comparator_);
+                    if (count1 != 0) {
+                        std::move_backward(a + (size1 - count1), a + size1, a + (size1 + size2));
+                        size1 -= count1;
+                        if (size1 == 0) {
+                            return;
+                        }
+                    }
+                    a[size1 + size2 - 1] = std::move(tmp[size2 - 1]);
+                    if (--size2 == 1) {
+                        return;
+                    }
+
+                    count2 = size2 - gallop_left(a[size1 - 1], tmp, size2, size2 - 1, comparator_);
+                    if (count2 != 0) {
+                        std::move(tmp + (size2 - count2), tmp + size2, a + (size1 + size2 - count2));
+                        size2 -= count2;
+                        if (size2 <= 1) {
+                            return;
+                        }
+                    }
+                    a[size1 + size2 - 1] = std::move(a[size1 - 1]);
+                    if (--size1 == 0) {
+                        return;
+                    }
+                    --min_gallop;
+                } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+                min_gallop = std::max<std::ptrdiff_t>(min_gallop, 0) + 2;
+            }
+        }();
+        min_gallop_ = std::max<std::ptrdiff_t>(min_gallop, 1);
+
+        if (size2 == 1) {
+            // ラン 2 の最初の要素は、ラン 1 の残りすべてより前に来る
+            std::move_backward(a, a + size1, a + (size1 + 1));
+            a[0] = std::move(tmp[0]);
+        } else {
+            std::move(tmp, tmp + size2, a);
+        }
+    }
+
+    Iterator begin_;
+    Comparator& comparator_;
+    std::pmr::vector<value_type> buffer_;
+    std::array<Run, MAX_PENDING_RUNS> runs_{};
+    std::size_t pending_ = 0;
+    std::ptrdiff_t min_gallop_ = MIN_GALLOP;
+};
+
+}  // namespace detail::tim
+
+// n 要素を tim_sort でソートするときに memory_resource から確保する作業領域のバイト数。
+// std::pmr::monotonic_buffer_resource に渡すバッファをこの大きさにすれば、上流のリソースを使わない
+// (アラインメントの調整分を含む)
+template <typename T>
+constexpr std::size_t tim_sort_scratch_size(std::size_t n) {
+    if (n < static_cast<std::size_t>(detail::tim::MIN_MERGE)) {
+        return 0;
+    }
+    return n / 2 * sizeof(T) + alignof(T) - 1;
+}
+
+// 安定ソート (TimSort)。既存の昇順・降順のランを検出し、短いランは二分挿入ソートで伸ばしてから、
+// ランの長さの不変条件を保ちながらマージする。マージでは一方のランが連続して選ばれる間、
+// 指数探索 (ギャロップ) でまとめて移動する。整列済み・逆順の入力は O(n) で済む。
+// 作業領域 (最大 n / 2 要素) は resource から一度だけ確保する。
+// 戻り値は比較回数
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+Result tim_sort(Iterator begin, Iterator end, Comparator comparator = {}, Projection projection = {},
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    Result loopCount = 0;
+    if (end - begin < 2) {
+        return loopCount;
+    }
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    auto counting = [&](const auto& a, const auto& b) {
+        ++loopCount;
+        return compare(a, b);
+    };
+    detail::tim::TimSorter<Iterator, decltype(counting)> sorter(begin, counting, resource);
+    sorter.sort(end - begin);
+    return loopCount;
+}
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,139 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "sort/intro_select.hpp"
+#include "sort/pdq_sort.hpp"
+#include "sort/projection.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+namespace detail::top_k {
+
+// k がこれ以下 (かつ n/8 以下) ならヒープで選ぶ。大きい k では intro_select + pdq_sort の方が速い
+inline constexpr std::ptrdiff_t HEAP_SELECT_LIMIT = 1024;
+
+// [begin, end) の最大ヒープを昇順に並べ替える
+template <typename Iterator, typename Comparator, typename Result>
+constexpr void sort_heap(Iterator begin, Iterator end, Comparator& comparator, Result& loopCount) {
+    for (auto last = end - begin - 1; last > 0; --last) {
+        std::ranges::iter_swap(begin, begin + last);
+        pdq::sift_down(begin, last, 0, comparator, loopCount);
+    }
+}
+
+}  // namespace detail::top_k
+
+// [begin, end) のうち小さい順に middle - begin 個を [begin, middle) にソートして並べる (std::partial_sort 相当)。
+// [middle, end) の順序は不定。
+// k が小さければ先頭 k 個の最大ヒープを作って残りを 1 回ずつ根と比べるだけで済むので、ほぼ n 回の比較で終わる。
+// k が大きければ intro_select で k 個を集めてから pdq_sort する (O(n + k log k))
+template <std::random_access_iterator Iterator, typename Comparator = std::less<>, std::integral Result = size_t,
+          typename Projection = std::identity>
+constexpr Result top_k_sort(Iterator begin, Iterator middle, Iterator end, Comparator comparator = {},
+                            Projection projection = {}) {
+    if (begin == middle) {
+        return 0;
+    }
+
+    const auto k = middle - begin;
+    const auto size = end - begin;
+    if (k > std::min(size / 8, detail::top_k::HEAP_SELECT_LIMIT)) {
+        auto loopCount = intro_select<Iterator, Comparator, Result>(begin, middle, end, comparator, projection);
+        return loopCount + pdq_sort<Iterator, Comparator, Result>(begin, middle, comparator, projection);
+    }
+
+    Result loopCount = 0;
+    auto compare = detail::make_projected_comparator(comparator, projection);
+    for (auto i = k / 2; i-- > 0;) {
+        detail::pdq::sift_down(begin, k, i, compare, loopCount);
+    }
+    for (auto it = middle; it != end; ++it) {
+        if (compare(*it, *begin)) {
+            std::ranges::iter_swap(it, begin);
+            detail::pdq::sift_down(begin, k, 0, compare, loopCount);
+        }
+        ++loopCount;
+    }
+    detail::top_k::sort_heap(begin, middle, compare, loopCount);
+    return loopCount;
+}
+
+template <std::integral T, std::size_t N, typename Comparator = std::less<>, typename Projection = std::identity>
+constexpr std::tuple<std::array<T, N>, size_t> top_k_sort(const std::array<T, N>& input, std::size_t k,
+                                                          Comparator comparator = {}, Projection projection = {}) {
+    std::array<T, N> arr = input;
+    auto loopCount = top_k_sort(arr.begin(), arr.begin() + k, arr.end(), comparator, projection);
+    return std::make_tuple(arr, loopCount);
+}
+
+// 値を 1 つずつ受け取りながら、小さい順に k 個だけを保持する有界ヒープ。
+// 入力全体を保持しないので、ストリームやファイルのように 1 度しか読めない入力の上位 k 件を O(k) のメモリで求められる
+template <typename T, typename Comparator = std::less<>, typename Projection = std::identity>
+class TopK {
+public:
+    explicit TopK(std::size_t k, Comparator comparator = {}, Projection projection = {})
+        : k_(k), compare_(detail::make_projected_comparator(std::move(comparator), std::move(projection))) {
+        heap_.reserve(k_);
+    }
+
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    // 保持している値の数 (min(k, これまでに受け取った数))
+    std::size_t size() const { return heap_.size(); }
+    std::size_t k() const { return k_; }
+
+    // 保持している値を小さい順に並べて取り出す。取り出した後は空になる
+    std::vector<T> take() {
+        std::size_t ignored = 0;
+        detail::top_k::sort_heap(heap_.begin(), heap_.end(), compare_, ignored);
+        return std::exchange(heap_, {});
+    }
+
+private:
+    template <typename U>
+    void emplace(U&& value) {
+        std::size_t ignored = 0;
+        if (heap_.size() < k_) {
+            heap_.push_back(std::forward<U>(value));
+            std::push_heap(heap_.begin(), heap_.end(), std::ref(compare_));
+        } else if (k_ > 0 && compare_(value, heap_.front())) {
+            heap_.front() = std::forward<U>(value);
+            detail::pdq::sift_down(heap_.begin(), static_cast<std::ptrdiff_t>(heap_.size()), 0, compare_, ignored);
+        }
+    }
+
+    std::size_t k_;
+    decltype(detail::make_projected_comparator(std::declval<Comparator>(), std::declval<Projection>())) compare_;
+    std::vector<T> heap_;
+};
+
+// 入力イテレータ [first, last) を 1 度だけ読み、小さい順に k 個を並べて返す
+template <std::input_iterator Iterator, std::sentinel_for<Iterator> Sentinel, typename Comparator = std::less<>,
+          typename Projection = std::identity>
+std::vector<std::iter_value_t<Iterator>> top_k(Iterator first, Sentinel last, std::size_t k,
+                                                Comparator comparator = {}, Projection projection = {}) {
+    TopK<std::iter_value_t<Iterator>, Comparator, Projection> top(k, std::move(comparator), std::move(projection));
+    for (; first != last; ++first) {
+        top.push(*first);
+    }
+    return top.take();
+}
+
+static_assert([] {
+    const auto [arr, loopCount] = top_k_sort(std::array{5, 3, 1, 4, 2}, 2);
+    return arr[0] == 1 && arr[1] == 2;
+}());
+static_assert([] {
+    const auto [arr, loopCount] = top_k_sort(std::array{9, 15, 3, 12, 7, 0, 14, 5, 11, 2, 8, 13, 1, 10, 6, 4}, 2);
+    return arr[0] == 0 && arr[1] == 1;
+}());
+
+}  // namespace AlgorithmSamples::Sort
@@ -0,0 +1,179 @@
+﻿#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "sort/pass_hooks.hpp"
+
+namespace AlgorithmSamples::Sort {
+
+// イベントに付ける値。名前は文字列リテラルなど、レコーダーより長く生きる文字列を渡す
+using TraceArgs = std::vector<std::pair<const char*, uint64_t>>;
+
+struct TraceEvent {
+    std::string name;
+    const char* category = "";
+    char phase = 'X';           // 'X' は区間 (開始と長さ)、'C' はカウンタ (args の値をグラフにする)
+    double timestamp_us = 0;    // レコーダーを作った時点からの経過時間
+    double duration_us = 0;     // 'X' のみ
+    uint32_t thread_id = 0;     // 記録したスレッド (1 から順に振る)
+    TraceArgs args;
+};
+
+namespace detail::trace {
+
+inline uint32_t current_thread_id() {
+    static std::atomic<uint32_t> next_id{1};
+    thread_local const uint32_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+inline void write_escaped(std::ostream& os, std::string_view text) {
+    for (const char c : text) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << std::format("\\u{:04x}", static_cast<unsigned>(c));
+                } else {
+                    os << c;
+                }
+        }
+    }
+}
+
+}  // namespace detail::trace
+
+// 区間とカウンタの時系列を記録し、Chrome の trace event 形式の JSON に書き出す
+// (chrome://tracing や Perfetto で開ける)。
+// どのスレッドから記録してもよい
+class TraceRecorder {
+public:
+    using Clock = TraceClock;
+
+    TraceRecorder() : origin_(Clock::now()) {}
+
+    void add_span(std::string name, const char* category, Clock::time_point start, Clock::time_point end,
+                  TraceArgs args = {}) {
+        add({std::move(name), category, 'X', since_origin(start), to_us(end - start),
+             detail::trace::current_thread_id(), std::move(args)});
+    }
+
+    void add_counter(std::string name, Clock::time_point at, TraceArgs values) {
+        add({std::move(name), "", 'C', since_origin(at), 0, detail::trace::current_thread_id(), std::move(values)});
+    }
+
+    std::vector<TraceEvent> events() const {
+        std::lock_guard lock(mutex_);
+        return events_;
+    }
+
+    void write_json(std::ostream& os) const {
+        std::lock_guard lock(mutex_);
+        os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (size_t i = 0; i < events_.size(); ++i) {
+            const auto& event = events_[i];
+            os << (i == 0 ? "\n" : ",\n") << "{\"name\":\"";
+            detail::trace::write_escaped(os, event.name);
+            os << "\",\"cat\":\"";
+            detail::trace::write_escaped(os, event.category);
+            os << std::format("\",\"ph\":\"{}\",\"ts\":{:.3f},", event.phase, event.timestamp_us);
+            if (event.phase == 'X') {
+                os << std::format("\"dur\":{:.3f},", event.duration_us);
+            }
+            os << std::format("\"pid\":1,\"tid\":{},\"args\":{{", event.thread_id);
+            for (size_t j = 0; j < event.args.size(); ++j) {
+                os << (j == 0 ? "\"" : ",\"");
+                detail::trace::write_escaped(os, event.args[j].first);
+                os << "\":" << event.args[j].second;
+            }
+            os << "}}";
+        }
+        os << "\n]}\n";
+    }
+
+private:
+    static double to_us(Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); }
+    double since_origin(Clock::time_point t) const { return to_us(t - origin_); }
+
+    void add(TraceEvent event) {
+        std::lock_guard lock(mutex_);
+        events_.push_back(std::move(event));
+    }
+
+    Clock::time_point origin_;
+    mutable std::mutex mutex_;
+    std::vector<TraceEvent> events_;
+};
+
+namespace detail::trace {
+
+inline void add_pass(TraceRecorder& recorder, TraceClock::time_point start, TraceClock::time_point end,
+                     const ProgressSnapshot& snapshot) {
+    recorder.add_span("pass", "sort", start, end,
+                      {{"pass", snapshot.pass},
+                       {"range_begin", snapshot.range_begin},
+                       {"range_end", snapshot.range_end},
+                       {"comparisons", snapshot.comparisons}});
+}
+
+}  // namespace detail::trace
+
+// 生存している間だけ recorder を記録先にする。破棄すると元の記録先に戻す
+class ScopedTrace {
+public:
+    explicit ScopedTrace(TraceRecorder& recorder)
+        : hook_{&recorder, &detail::trace::add_pass},
+          previous_(detail::trace::active_slot().exchange(&hook_, std::memory_order_acq_rel)) {}
+    ~ScopedTrace() { detail::trace::active_slot().store(previous_, std::memory_order_release); }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+private:
+    detail::TraceHook hook_;
+    const detail::TraceHook* previous_;
+};
+
+// 生存期間を 1 つの区間として記録先に記録する。記録先がなければ何もしない
+class TraceSpan {
+public:
+    explicit TraceSpan(std::string name, const char* category = "demo") : recorder_(active_trace()) {
+        if (recorder_ != nullptr) {
+            name_ = std::move(name);
+            category_ = category;
+            start_ = TraceRecorder::Clock::now();
+        }
+    }
+    ~TraceSpan() {
+        if (recorder_ != nullptr) {
+            recorder_->add_span(std::move(name_), category_, start_, TraceRecorder::Clock::now());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    TraceRecorder* recorder_;
+    std::string name_;
+    const char* category_ = "";
+    TraceRecorder::Clock::time_point start_;
+};
+
+}  // namespace AlgorithmSamples::Sort
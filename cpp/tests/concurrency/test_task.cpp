@@ -0,0 +1,72 @@
+﻿#include "concurrency/task.hpp"
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "concurrency/executor.hpp"
+
+using namespace AlgorithmSamples::Concurrency;
+
+namespace {
+Task<int> answer() { co_return 42; }
+
+Task<int> add_answers() {
+    int a = co_await answer();
+    int b = co_await answer();
+    co_return a + b;
+}
+
+Task<void> fail() {
+    throw std::runtime_error("失敗");
+    co_return;
+}
+
+template <typename E>
+Task<std::thread::id> hop(E& executor) {
+    co_await schedule(executor);
+    co_return std::this_thread::get_id();
+}
+
+Task<int> count_steps(ManualExecutor& executor, std::vector<int>& log, int id, int steps) {
+    for (int i = 0; i < steps; ++i) {
+        log.push_back(id);
+        co_await schedule(executor);
+    }
+    co_return steps;
+}
+}  // namespace
+
+TEST_CASE("Task - co_await で結果を受け取る") { REQUIRE(sync_wait(add_answers()) == 84); }
+
+TEST_CASE("Task - 例外は get() で投げ直される") { REQUIRE_THROWS_AS(sync_wait(fail()), std::runtime_error); }
+
+TEST_CASE("Task - start() するまで開始しない") {
+    auto task = answer();
+    REQUIRE_FALSE(task.done());
+    task.start();
+    REQUIRE(task.done());
+    REQUIRE(task.get() == 42);
+}
+
+TEST_CASE("ThreadExecutor - 専用スレッドで再開される") {
+    ThreadExecutor executor;
+    auto id = sync_wait(hop(executor));
+    REQUIRE(id != std::this_thread::get_id());
+}
+
+TEST_CASE("ManualExecutor - 積まれたタスクを交互に進める") {
+    ManualExecutor executor;
+    std::vector<int> log;
+    auto a = count_steps(executor, log, 1, 3);
+    auto b = count_steps(executor, log, 2, 3);
+    a.start();
+    b.start();
+    REQUIRE(log == std::vector{1, 2});
+    REQUIRE(executor.pending() == 2);
+
+    executor.run_until_idle();
+    REQUIRE(a.done());
+    REQUIRE(b.done());
+    REQUIRE(log == std::vector{1, 2, 1, 2, 1, 2});
+    REQUIRE(a.get() == 3);
+}
@@ -0,0 +1,74 @@
+﻿#include "concurrency/work_stealing_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Concurrency;
+using namespace std::chrono_literals;
+
+namespace {
+long long fibonacci(WorkStealingPool& pool, int n) {
+    if (n < 2) {
+        return n;
+    }
+    long long a = 0;
+    TaskGroup group;
+    pool.submit(group, [&] { a = fibonacci(pool, n - 1); });
+    long long b = fibonacci(pool, n - 2);
+    pool.wait(group);
+    return a + b;
+}
+}  // namespace
+
+TEST_CASE("WorkStealingPool - 全タスクが実行される") {
+    WorkStealingPool pool(4);
+    std::atomic<int> count = 0;
+    TaskGroup group;
+    for (int i = 0; i < 1'000; ++i) {
+        pool.submit(group, [&] { ++count; });
+    }
+    pool.wait(group);
+    REQUIRE(count == 1'000);
+}
+
+TEST_CASE("WorkStealingPool - 入れ子のタスク") {
+    WorkStealingPool pool(4);
+    REQUIRE(fibonacci(pool, 20) == 6'765);
+}
+
+TEST_CASE("WorkStealingPool - 1 スレッドでは wait の中で実行する") {
+    WorkStealingPool pool(1);
+    REQUIRE(pool.thread_count() == 1);
+    REQUIRE(fibonacci(pool, 15) == 610);
+}
+
+TEST_CASE("WorkStealingPool - 例外は wait で再送出される") {
+    WorkStealingPool pool(2);
+    TaskGroup group;
+    pool.submit(group, [] { throw std::runtime_error("task failed"); });
+    pool.submit(group, [] {});
+    REQUIRE_THROWS_AS(pool.wait(group), std::runtime_error);
+    REQUIRE(group.done());
+}
+
+TEST_CASE("WorkStealingPool - run_and_wait は例外で抜ける前に積んだタスクを待つ") {
+    WorkStealingPool pool(2);
+    TaskGroup group;
+    std::atomic<bool> finished = false;
+    pool.submit(group, [&] {
+        std::this_thread::sleep_for(20ms);
+        finished = true;
+    });
+    pool.submit(group, [] { throw std::logic_error("discarded"); });
+    REQUIRE_THROWS_AS(pool.run_and_wait(group, [] { throw std::runtime_error("caller failed"); }), std::runtime_error);
+    REQUIRE(finished);
+    REQUIRE(group.done());
+
+    // 例外がなければ wait と同じ
+    int count = 0;
+    pool.submit(group, [&] { ++count; });
+    pool.run_and_wait(group, [&] { ++count; });
+    REQUIRE(count == 2);
+}
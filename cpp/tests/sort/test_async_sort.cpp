@@ -0,0 +1,138 @@
+﻿#include "sort/async_sort.hpp"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <stop_token>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "concurrency/executor.hpp"
+#include "concurrency/task.hpp"
+#include "sort/bubble_sort.hpp"
+#include "sort/odd_even_sort.hpp"
+#include "sort/pdq_sort.hpp"
+#include "sort/selection_sort.hpp"
+#include "sort/shaker_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+using namespace AlgorithmSamples::Concurrency;
+
+namespace Workload = AlgorithmSamples::Workload;
+
+namespace {
+// 0, 1, ..., n - 1 の並べ替え
+constexpr Workload::Options SHUFFLED = {.distribution = Workload::Distribution::Shuffled};
+}  // namespace
+
+TEST_CASE("async_sort - 同期版と同じ結果・比較回数") {
+    ThreadExecutor executor;
+    auto input = Workload::generate<int>(500, SHUFFLED);
+    auto expected = input;
+    std::ranges::sort(expected);
+
+    auto v = input;
+    auto result = sync_wait(async_sort(executor, BubbleSortPasses(v.begin(), v.end())));
+    REQUIRE(v == expected);
+    REQUIRE_FALSE(result.cancelled);
+    auto w = input;
+    REQUIRE(result.loop_count == bubble_sort(w.begin(), w.end()));
+    REQUIRE(result.passes == 499);
+
+    v = input;
+    result = sync_wait(async_sort(executor, ShakerSortPasses(v.begin(), v.end(), std::greater<>())));
+    REQUIRE(std::ranges::equal(v, expected | std::views::reverse));
+    w = input;
+    REQUIRE(result.loop_count == shaker_sort(w.begin(), w.end(), std::greater<>()));
+
+    v = input;
+    result = sync_wait(async_sort(executor, SelectionSortPasses(v.begin(), v.end(), std::less<>(), std::negate<>())));
+    REQUIRE(std::ranges::equal(v, expected | std::views::reverse));
+
+    v = input;
+    result = sync_wait(async_sort(executor, OddEvenSortPasses(v.begin(), v.end())));
+    REQUIRE(v == expected);
+    w = input;
+    REQUIRE(result.loop_count == odd_even_sort(w.begin(), w.end()));
+}
+
+TEST_CASE("async_sort - イベントループで他の処理と交互に進む") {
+    ManualExecutor loop;
+    auto v = Workload::generate<int>(1'000, SHUFFLED);
+    AsyncSortOptions options;
+    options.yield_every = 10'000;
+    auto task = async_sort(loop, BubbleSortPasses(v.begin(), v.end()), options);
+    task.start();
+
+    size_t slices = 0;
+    while (!task.done()) {
+        REQUIRE(loop.run_one());
+        ++slices;
+    }
+    auto result = task.get();
+    REQUIRE(std::ranges::is_sorted(v));
+    // 開始の 1 回と、約 10,000 回の比較ごとの中断
+    REQUIRE(slices > result.loop_count / 11'000);
+    REQUIRE(slices <= result.loop_count / 10'000 + 1);
+}
+
+TEST_CASE("async_sort - 進捗を報告する") {
+    ThreadExecutor executor;
+    auto v = Workload::generate<int>(100, SHUFFLED);
+    std::vector<SortProgress> reports;
+    AsyncSortOptions options;
+    options.on_progress = [&](const SortProgress& progress) { reports.push_back(progress); };
+    auto result = sync_wait(async_sort(executor, SelectionSortPasses(v.begin(), v.end()), options));
+
+    REQUIRE(reports.size() == 99);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        REQUIRE(reports[i].passes == i + 1);
+        REQUIRE(reports[i].max_passes == 99);
+    }
+    REQUIRE(reports.back().loop_count == result.loop_count);
+}
+
+TEST_CASE("async_sort - stop_token で中断する") {
+    ManualExecutor loop;
+    auto v = Workload::generate<int>(1'000, SHUFFLED);
+    std::stop_source stop;
+    AsyncSortOptions options;
+    options.stop_token = stop.get_token();
+    options.yield_every = 0;
+    auto task = async_sort(loop, ShakerSortPasses(v.begin(), v.end()), options);
+    task.start();
+    for (int i = 0; i < 10; ++i) {
+        loop.run_one();
+    }
+    stop.request_stop();
+    loop.run_until_idle();
+
+    REQUIRE(task.done());
+    auto result = task.get();
+    REQUIRE(result.cancelled);
+    REQUIRE(result.passes == 10);
+    REQUIRE_FALSE(std::ranges::is_sorted(v));
+    std::ranges::sort(v);
+    REQUIRE(v == [] {
+        std::vector<int> expected(1'000);
+        std::iota(expected.begin(), expected.end(), 0);
+        return expected;
+    }());
+}
+
+TEST_CASE("async_sort - パスに分けられないソートを別スレッドで実行する") {
+    ThreadExecutor executor;
+    auto v = Workload::generate<int>(10'000, SHUFFLED);
+    auto result = sync_wait(async_sort(executor, [&] { return pdq_sort(v.begin(), v.end()); }));
+    REQUIRE(std::ranges::is_sorted(v));
+    REQUIRE(result.passes == 1);
+
+    std::stop_source stop;
+    stop.request_stop();
+    v = Workload::generate<int>(10'000, SHUFFLED);
+    AsyncSortOptions options;
+    options.stop_token = stop.get_token();
+    result = sync_wait(async_sort(executor, [&] { return pdq_sort(v.begin(), v.end()); }, options));
+    REQUIRE(result.cancelled);
+    REQUIRE(v == Workload::generate<int>(10'000, SHUFFLED));
+}
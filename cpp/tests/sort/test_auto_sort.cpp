@@ -0,0 +1,119 @@
+﻿#include "sort/auto_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+namespace {
+struct Large {
+    int key;
+    std::array<char, 128> payload;
+};
+}  // namespace
+
+TEST_CASE("choose_sort - 入力に応じて選ぶ") {
+    REQUIRE(choose_sort(std::vector<int>{}.begin(), std::vector<int>{}.end()).engine == SortEngine::None);
+
+    auto small = Workload::generate<int>(20);
+    REQUIRE(choose_sort(small.begin(), small.end()).engine == SortEngine::PdqSort);
+
+    auto random = Workload::generate<int>(10'000);
+    auto decision = choose_sort(random.begin(), random.end());
+    REQUIRE(decision.engine == SortEngine::RadixSort);
+    REQUIRE(decision.profile.size == 10'000);
+    REQUIRE(decision.profile.element_size == sizeof(int));
+    REQUIRE(decision.profile.key_kind == SortKeyKind::Radix);
+    REQUIRE(decision.profile.duplicate_ratio < 0.1);
+    REQUIRE(decision.profile.monotone_windows < decision.profile.sampled_windows / 2);
+
+    auto sorted = random;
+    std::ranges::sort(sorted);
+    REQUIRE(choose_sort(sorted.begin(), sorted.end()).engine == SortEngine::TimSort);
+    REQUIRE(choose_sort(sorted.rbegin(), sorted.rend()).engine == SortEngine::TimSort);
+
+    const Workload::Options four_values = {.distribution = Workload::Distribution::FewUnique, .unique_values = 4};
+    auto few_unique = Workload::generate<int>(10'000, four_values);
+    decision = choose_sort(few_unique.begin(), few_unique.end());
+    REQUIRE(decision.engine == SortEngine::RadixSort);
+    REQUIRE(decision.profile.duplicate_ratio > 0.9);
+    // 大きな入力では重複の多さを見て pdq_sort に切り替える
+    few_unique = Workload::generate<int>(100'000, four_values);
+    REQUIRE(choose_sort(few_unique.begin(), few_unique.end()).engine == SortEngine::PdqSort);
+
+    // 比較関数が std::less / std::greater でなければ基数ソートは使えない
+    auto by_mod = [](int a, int b) { return a % 1000 < b % 1000; };
+    REQUIRE(choose_sort(random.begin(), random.end(), by_mod).engine == SortEngine::PdqSort);
+
+    std::vector<std::string> strings(1'000);
+    std::ranges::generate(strings, [i = 0]() mutable { return std::to_string(i++ * 7919 % 1000); });
+    REQUIRE(choose_sort(strings.begin(), strings.end()).engine == SortEngine::StringSort);
+
+    std::vector<Large> large(1'000);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i].key = random[i];
+    }
+    REQUIRE(choose_sort(large.begin(), large.end(), std::less<>(), &Large::key).engine == SortEngine::IndirectSort);
+}
+
+TEST_CASE("auto_sort - どの選択でも正しくソートされる") {
+    for (size_t size : {0, 1, 10, 100, 1'000, 20'000}) {
+        for (const auto distribution : {Workload::Distribution::FewUnique, Workload::Distribution::Random}) {
+            auto random = Workload::generate<int>(size, {.distribution = distribution, .unique_values = 4});
+            auto expected = random;
+            std::ranges::sort(expected);
+
+            auto v = random;
+            auto_sort(v.begin(), v.end());
+            REQUIRE(v == expected);
+
+            v = random;
+            auto_sort(v.begin(), v.end(), std::greater<>());
+            REQUIRE(std::ranges::equal(v, expected | std::views::reverse));
+
+            auto organ_pipe = expected;
+            std::reverse(organ_pipe.begin() + static_cast<std::ptrdiff_t>(size / 2), organ_pipe.end());
+            auto_sort(organ_pipe.begin(), organ_pipe.end());
+            REQUIRE(organ_pipe == expected);
+        }
+    }
+}
+
+TEST_CASE("auto_sort - 選んだ結果を通知する") {
+    auto v = Workload::generate<int>(5'000, {.distribution = Workload::Distribution::Shuffled});
+    std::vector<SortDecision> decisions;
+    auto_sort(v.begin(), v.end(), std::less<>(), std::negate<>(),
+              [&](const SortDecision& decision) { decisions.push_back(decision); });
+    REQUIRE(decisions.size() == 1);
+    // 射影したキーが整数なら基数ソートが使える
+    REQUIRE(decisions[0].engine == SortEngine::RadixSort);
+    REQUIRE(to_string(decisions[0].engine) == "radix_sort");
+    REQUIRE(std::ranges::is_sorted(v, std::greater<>()));
+}
+
+TEST_CASE("auto_sort - 文字列・大きな要素") {
+    std::vector<std::string> strings(2'000);
+    std::ranges::generate(strings, [i = 0]() mutable { return "key" + std::to_string(i++ * 7919 % 2000); });
+    auto expected = strings;
+    std::ranges::sort(expected);
+    auto_sort(strings.begin(), strings.end());
+    REQUIRE(strings == expected);
+
+    auto keys = Workload::generate<int>(1'000);
+    std::vector<Large> large(keys.size());
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i].key = keys[i];
+        large[i].payload[0] = static_cast<char>(keys[i]);
+    }
+    auto_sort(large.begin(), large.end(), std::less<>(), &Large::key);
+    REQUIRE(std::ranges::is_sorted(large, std::less<>(), &Large::key));
+    REQUIRE(std::ranges::all_of(large, [](const Large& e) { return e.payload[0] == static_cast<char>(e.key); }));
+}
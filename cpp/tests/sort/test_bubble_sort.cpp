@@ -1,5 +1,9 @@
 ﻿#include "sort/bubble_sort.hpp"
+#include <algorithm>
 #include <array>
+#include <numeric>
+#include <random>
+#include <string>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
 
@@ -96,3 +100,100 @@ TEST_CASE("bubble_sort - 浮動小数点数") {
     bubble_sort(floats.begin(), floats.end());
     REQUIRE(floats == std::vector<double>{1.41, 1.73, 2.71, 3.14});
 }
+
+TEST_CASE("adaptive_bubble_sort - 昇順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    auto result = adaptive_bubble_sort(v.begin(), v.end());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(result.loopCount > 0);
+    REQUIRE(result.passCount > 0);
+}
+
+TEST_CASE("adaptive_bubble_sort - 降順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    adaptive_bubble_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(v == std::vector{5, 4, 3, 2, 1});
+}
+
+TEST_CASE("adaptive_bubble_sort - 要素数 0 と 1") {
+    std::vector<int> empty;
+    REQUIRE(adaptive_bubble_sort(empty.begin(), empty.end()) == AdaptiveSortResult<>{0, 0});
+    std::vector single = {42};
+    REQUIRE(adaptive_bubble_sort(single.begin(), single.end()) == AdaptiveSortResult<>{0, 0});
+}
+
+TEST_CASE("adaptive_bubble_sort - 既にソート済みなら 1 パスで終わる") {
+    std::vector<int> sorted(1'000);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    auto result = adaptive_bubble_sort(sorted.begin(), sorted.end());
+    REQUIRE(std::ranges::is_sorted(sorted));
+    REQUIRE(result.loopCount == sorted.size() - 1);
+    REQUIRE(result.passCount == 1);
+}
+
+TEST_CASE("adaptive_bubble_sort - 前方にずれた要素") {
+    // 本来より前にある k 要素は 1 パスで末尾側へ運ばれるので、O(nk) 回の比較で済む
+    constexpr size_t SIZE = 1'000;
+    constexpr size_t DISPLACED = 3;
+    std::vector<int> v(SIZE);
+    std::iota(v.begin(), v.end(), 0);
+    std::ranges::rotate(v.begin() + 100, v.begin() + 900, v.begin() + 901);
+    std::ranges::rotate(v.begin() + 10, v.begin() + 500, v.begin() + 501);
+    std::ranges::rotate(v.begin(), v.begin() + 998, v.begin() + 999);
+    auto expected = v;
+    std::ranges::sort(expected);
+
+    auto result = adaptive_bubble_sort(v.begin(), v.end());
+    REQUIRE(v == expected);
+    REQUIRE(result.passCount <= DISPLACED + 1);
+    REQUIRE(result.loopCount <= SIZE * (DISPLACED + 1));
+}
+
+TEST_CASE("adaptive_bubble_sort - 逆順は通常版と同じ回数") {
+    std::vector reversed = {5, 4, 3, 2, 1};
+    auto result = adaptive_bubble_sort(reversed.begin(), reversed.end());
+    REQUIRE(reversed == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(result.loopCount == 10);
+}
+
+TEST_CASE("adaptive_bubble_sort - 重複要素あり") {
+    std::vector duplicates = {3, 1, 4, 1, 5, 9, 2, 6, 5};
+    adaptive_bubble_sort(duplicates.begin(), duplicates.end());
+    REQUIRE(duplicates == std::vector{1, 1, 2, 3, 4, 5, 5, 6, 9});
+}
+
+TEST_CASE("adaptive_bubble_sort - ランダムな入力") {
+    std::mt19937 engine(42);
+    std::vector<int> v(500);
+    std::ranges::generate(v, [&] { return static_cast<int>(engine() % 100); });
+    auto expected = v;
+    std::ranges::sort(expected);
+    adaptive_bubble_sort(v.begin(), v.end());
+    REQUIRE(v == expected);
+}
+
+TEST_CASE("adaptive_bubble_sort - コンパイル時ソート") {
+    constexpr auto result = adaptive_bubble_sort(std::array{1, 2, 3, 5, 4});
+    REQUIRE(std::get<0>(result) == std::array{1, 2, 3, 4, 5});
+    STATIC_REQUIRE(std::get<1>(result).passCount <= 2);
+}
+
+TEST_CASE("bubble_sort - 射影でメンバをキーにする") {
+    struct Item {
+        int key;
+        std::string name;
+    };
+    std::vector<Item> v = {{3, "c"}, {1, "a"}, {2, "b"}};
+    bubble_sort(v.begin(), v.end(), std::less<>(), &Item::key);
+    REQUIRE(v[0].name == "a");
+    REQUIRE(v[1].name == "b");
+    REQUIRE(v[2].name == "c");
+
+    adaptive_bubble_sort(v.begin(), v.end(), std::greater<>(), &Item::key);
+    REQUIRE(std::ranges::is_sorted(v, std::greater<>(), &Item::key));
+}
+
+TEST_CASE("bubble_sort - 射影付きのコンパイル時ソート") {
+    constexpr auto result = bubble_sort(std::array{-3, 1, -2, 0}, std::less<>(), [](int n) { return n * n; });
+    static_assert(std::get<0>(result) == std::array{0, 1, -2, -3});
+}
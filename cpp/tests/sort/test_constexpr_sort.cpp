@@ -0,0 +1,144 @@
+﻿#include "sort/constexpr_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Sort;
+
+namespace {
+
+constexpr std::size_t LARGE_SIZE = 2'000;
+
+// 重複を含む乱数の配列 (線形合同法)
+template <std::size_t N>
+constexpr std::array<int, N> make_random_array(std::uint32_t modulo) {
+    std::array<int, N> arr{};
+    std::uint32_t state = 12345;
+    for (auto& value : arr) {
+        state = state * 1664525U + 1013904223U;
+        value = static_cast<int>((state >> 8) % modulo);
+    }
+    return arr;
+}
+
+constexpr auto LARGE_INPUT = make_random_array<LARGE_SIZE>(500);
+
+struct Entry {
+    int key = 0;
+    int order = 0;
+};
+
+std::string_view dispatch(std::string_view command) {
+    using Commands = SortedStringTable<"stop", "start", "list", "status">;
+    switch (Commands::find(command)) {
+        case Commands::index<"start">():
+            return "starting";
+        case Commands::index<"stop">():
+            return "stopping";
+        case Commands::index<"list">():
+        case Commands::index<"status">():
+            return "reporting";
+        default:
+            return "unknown";
+    }
+}
+
+}  // namespace
+
+TEST_CASE("constexpr_sort - コンパイル時に大きな配列をソート") {
+    constexpr auto result = constexpr_sort(LARGE_INPUT);
+    auto expected = std::vector(LARGE_INPUT.begin(), LARGE_INPUT.end());
+    std::ranges::sort(expected);
+    REQUIRE(std::ranges::equal(std::get<0>(result), expected));
+    REQUIRE(std::get<1>(result) > 0);
+
+    constexpr auto descending = std::get<0>(constexpr_sort(LARGE_INPUT, std::greater<>()));
+    STATIC_REQUIRE(std::ranges::is_sorted(descending, std::greater<>()));
+}
+
+TEST_CASE("constexpr_sort - 安定") {
+    constexpr auto sorted = [] {
+        std::array<Entry, 64> entries{};
+        for (int i = 0; i < 64; ++i) {
+            entries[static_cast<std::size_t>(i)] = Entry{(i * 7) % 5, i};
+        }
+        return std::get<0>(constexpr_sort(entries, std::less<>(), &Entry::key));
+    }();
+    for (std::size_t i = 1; i < sorted.size(); ++i) {
+        REQUIRE(sorted[i - 1].key <= sorted[i].key);
+        if (sorted[i - 1].key == sorted[i].key) {
+            REQUIRE(sorted[i - 1].order < sorted[i].order);
+        }
+    }
+}
+
+TEST_CASE("constexpr_sort - 空と 1 要素") {
+    STATIC_REQUIRE(std::get<0>(constexpr_sort(std::array<int, 0>{})).empty());
+    STATIC_REQUIRE(std::get<0>(constexpr_sort(std::array{7})) == std::array{7});
+    STATIC_REQUIRE(std::get<1>(sorted_unique(std::array<int, 0>{})) == 0);
+}
+
+TEST_CASE("sort_permutation / sort_rank / dense_rank - 大きな配列") {
+    constexpr auto order = sort_permutation(LARGE_INPUT);
+    constexpr auto rank = sort_rank(LARGE_INPUT);
+    constexpr auto dense = dense_rank(LARGE_INPUT);
+
+    std::vector<std::size_t> expected_order(LARGE_SIZE);
+    for (std::size_t i = 0; i < LARGE_SIZE; ++i) {
+        expected_order[i] = i;
+    }
+    std::ranges::stable_sort(expected_order, {}, [](std::size_t i) { return LARGE_INPUT[i]; });
+    REQUIRE(std::ranges::equal(order, expected_order));
+
+    auto unique = std::vector(LARGE_INPUT.begin(), LARGE_INPUT.end());
+    std::ranges::sort(unique);
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    for (std::size_t i = 0; i < LARGE_SIZE; ++i) {
+        REQUIRE(order[rank[i]] == i);
+        REQUIRE(unique[dense[i]] == LARGE_INPUT[i]);
+    }
+}
+
+TEST_CASE("sorted_unique - 重複を除く") {
+    constexpr auto result = sorted_unique(LARGE_INPUT);
+    auto expected = std::vector(LARGE_INPUT.begin(), LARGE_INPUT.end());
+    std::ranges::sort(expected);
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+    REQUIRE(std::get<1>(result) == expected.size());
+    REQUIRE(std::ranges::equal(std::get<0>(result).begin(), std::get<0>(result).begin() + expected.size(),
+                               expected.begin(), expected.end()));
+
+    constexpr auto exact = sorted_unique_array<make_random_array<200>(20)>();
+    STATIC_REQUIRE(exact.size() == 20);
+    STATIC_REQUIRE(exact.front() == 0 && exact.back() == 19);
+}
+
+TEST_CASE("SortedStringTable - 文字列リテラルの表") {
+    using Table = SortedStringTable<"pear", "apple", "fig", "apple", "banana">;
+    STATIC_REQUIRE(Table::size() == 4);
+    STATIC_REQUIRE(Table::values == std::array<std::string_view, 4>{"apple", "banana", "fig", "pear"});
+    STATIC_REQUIRE(Table::index<"fig">() == 2);
+    REQUIRE(Table::find("banana") == 1);
+    REQUIRE(Table::find("cherry") == Table::size());
+
+    REQUIRE(dispatch("start") == "starting");
+    REQUIRE(dispatch("stop") == "stopping");
+    REQUIRE(dispatch("status") == "reporting");
+    REQUIRE(dispatch("restart") == "unknown");
+}
+
+TEST_CASE("sorted_type_list_t - 型の並べ替え") {
+    STATIC_REQUIRE(std::is_same_v<sorted_type_list_t<TypeList<>, std::alignment_of>, TypeList<>>);
+    STATIC_REQUIRE(
+        std::is_same_v<sorted_type_list_t<TypeList<double, char, int, short>, std::alignment_of>,
+                       TypeList<char, short, int, double>>);
+    // 同じキーの型は元の順を保つ
+    STATIC_REQUIRE(
+        std::is_same_v<sorted_type_list_t<TypeList<std::int64_t, char, double, std::uint8_t>, std::alignment_of,
+                                          std::greater<>>,
+                       TypeList<std::int64_t, double, char, std::uint8_t>>);
+}
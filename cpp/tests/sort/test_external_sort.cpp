@@ -0,0 +1,183 @@
+﻿#include "sort/external_sort.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Sort;
+
+namespace {
+struct Record {
+    uint32_t key;
+    uint32_t payload;
+};
+
+// テストごとに一時ディレクトリを作り、終了時に削除する
+class TestDirectory {
+public:
+    explicit TestDirectory(const std::string& name)
+        : path_(std::filesystem::temp_directory_path() / ("algorithm_samples_test_" + name)) {
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+    ~TestDirectory() { std::filesystem::remove_all(path_); }
+
+    std::filesystem::path operator/(const std::string& name) const { return path_ / name; }
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+template <typename T>
+void write_file(const std::filesystem::path& path, const std::vector<T>& records) {
+    std::ofstream stream(path, std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(T)));
+}
+
+template <typename T>
+std::vector<T> read_file(const std::filesystem::path& path) {
+    std::vector<T> records(std::filesystem::file_size(path) / sizeof(T));
+    std::ifstream stream(path, std::ios::binary);
+    stream.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(T)));
+    return records;
+}
+
+std::vector<uint64_t> random_values(size_t count, unsigned seed) {
+    std::mt19937_64 engine(seed);
+    std::vector<uint64_t> values(count);
+    std::ranges::generate(values, [&] { return engine() % 1'000; });
+    return values;
+}
+
+size_t temp_file_count(const std::filesystem::path& directory) {
+    return static_cast<size_t>(std::distance(std::filesystem::directory_iterator(directory), {}));
+}
+}  // namespace
+
+TEST_CASE("external_sort - メモリに収まる入力") {
+    TestDirectory dir("fits");
+    auto values = random_values(1'000, 1);
+    write_file(dir / "input.bin", values);
+
+    auto stats = external_sort<uint64_t>(dir / "input.bin", dir / "output.bin", std::less<>(), std::identity(),
+                                         {.memory_budget = 1 << 20, .fan_in = 4, .temp_directory = dir.path()});
+    std::ranges::sort(values);
+    REQUIRE(read_file<uint64_t>(dir / "output.bin") == values);
+    REQUIRE(stats.records == 1'000);
+    REQUIRE(stats.runs == 1);
+    REQUIRE(stats.merge_passes == 0);
+}
+
+TEST_CASE("external_sort - 複数段のマージ") {
+    TestDirectory dir("multi_pass");
+    auto values = random_values(10'000, 2);
+    write_file(dir / "input.bin", values);
+
+    // 1 ラン 100 件 → 100 ラン → fan_in 4 で 4 段のマージ
+    auto stats = external_sort<uint64_t>(dir / "input.bin", dir / "output.bin", std::less<>(), std::identity(),
+                                         {.memory_budget = 800, .fan_in = 4, .temp_directory = dir.path()});
+    std::ranges::sort(values);
+    REQUIRE(read_file<uint64_t>(dir / "output.bin") == values);
+    REQUIRE(stats.records == 10'000);
+    REQUIRE(stats.runs == 100);
+    REQUIRE(stats.merge_passes == 4);
+    // 一時ファイルは残らない
+    REQUIRE(temp_file_count(dir.path()) == 2);
+}
+
+TEST_CASE("external_sort - 降順と構造体のレコード") {
+    TestDirectory dir("records");
+    std::mt19937 engine(3);
+    std::vector<Record> records(5'000);
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        records[i] = {static_cast<uint32_t>(engine() % 100), i};
+    }
+    write_file(dir / "input.bin", records);
+
+    external_sort<Record>(dir / "input.bin", dir / "output.bin", std::greater<>(), &Record::key,
+                          {.memory_budget = 8 * 300, .fan_in = 3, .temp_directory = dir.path()});
+
+    auto sorted = read_file<Record>(dir / "output.bin");
+    REQUIRE(sorted.size() == records.size());
+    REQUIRE(std::ranges::is_sorted(sorted, std::greater<>(), &Record::key));
+    auto payloads = [](const std::vector<Record>& v) {
+        std::vector<uint32_t> result;
+        for (const auto& r : v) {
+            result.push_back(r.payload);
+        }
+        std::ranges::sort(result);
+        return result;
+    };
+    REQUIRE(payloads(sorted) == payloads(records));
+}
+
+TEST_CASE("external_sort - 入力と出力が同じファイル") {
+    TestDirectory dir("in_place");
+    auto values = random_values(2'000, 4);
+    write_file(dir / "data.bin", values);
+
+    external_sort<uint64_t>(dir / "data.bin", dir / "data.bin", std::less<>(), std::identity(),
+                            {.memory_budget = 800, .fan_in = 8, .temp_directory = dir.path()});
+    std::ranges::sort(values);
+    REQUIRE(read_file<uint64_t>(dir / "data.bin") == values);
+}
+
+TEST_CASE("external_sort - 空のファイル") {
+    TestDirectory dir("empty");
+    write_file(dir / "input.bin", std::vector<uint64_t>{});
+
+    auto stats = external_sort<uint64_t>(dir / "input.bin", dir / "output.bin");
+    REQUIRE(std::filesystem::exists(dir / "output.bin"));
+    REQUIRE(std::filesystem::file_size(dir / "output.bin") == 0);
+    REQUIRE(stats.records == 0);
+    REQUIRE(stats.runs == 0);
+}
+
+TEST_CASE("external_sort - 不正な入力") {
+    TestDirectory dir("invalid");
+    REQUIRE_THROWS_AS(external_sort<uint64_t>(dir / "missing.bin", dir / "output.bin"), std::runtime_error);
+
+    write_file(dir / "odd.bin", std::vector<uint8_t>{1, 2, 3});
+    REQUIRE_THROWS_AS(external_sort<uint64_t>(dir / "odd.bin", dir / "output.bin"), std::runtime_error);
+
+    write_file(dir / "input.bin", std::vector<uint64_t>{1});
+    REQUIRE_THROWS_AS(
+        external_sort<uint64_t>(dir / "input.bin", dir / "output.bin", std::less<>(), std::identity(), {.fan_in = 1}),
+        std::invalid_argument);
+}
+
+TEST_CASE("LoserTree - 任意の入力数で最小の入力を選ぶ") {
+    for (size_t k = 1; k <= 9; ++k) {
+        std::vector<std::vector<int>> inputs(k);
+        std::mt19937 engine(static_cast<unsigned>(k));
+        std::vector<int> expected;
+        for (auto& input : inputs) {
+            input.resize(engine() % 20);
+            std::ranges::generate(input, [&] { return static_cast<int>(engine() % 50); });
+            std::ranges::sort(input);
+            expected.insert(expected.end(), input.begin(), input.end());
+        }
+        std::ranges::sort(expected);
+
+        std::vector<size_t> positions(k);
+        auto has_value = [&](size_t i) { return positions[i] < inputs[i].size(); };
+        detail::external::LoserTree tree(k, [&](size_t a, size_t b) {
+            if (!has_value(a)) {
+                return false;
+            }
+            return !has_value(b) || inputs[a][positions[a]] < inputs[b][positions[b]];
+        });
+
+        std::vector<int> merged;
+        for (auto winner = tree.winner(); has_value(winner); winner = tree.winner()) {
+            merged.push_back(inputs[winner][positions[winner]++]);
+            tree.replay();
+        }
+        REQUIRE(merged == expected);
+    }
+}
@@ -0,0 +1,179 @@
+﻿#include "allocation_tracker.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "sort/bubble_sort.hpp"
+#include "sort/indirect_sort.hpp"
+#include "sort/intro_select.hpp"
+#include "sort/network_sort.hpp"
+#include "sort/odd_even_sort.hpp"
+#include "sort/pdq_sort.hpp"
+#include "sort/radix_sort.hpp"
+#include "sort/segmented_sort.hpp"
+#include "sort/selection_sort.hpp"
+#include "sort/shaker_sort.hpp"
+#include "sort/tim_sort.hpp"
+#include "sort/top_k.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+using AlgorithmSamples::Benchmark::AllocationSection;
+namespace Workload = AlgorithmSamples::Workload;
+
+namespace {
+
+// sort() の呼び出しの間に確保した回数。入力の準備は呼び出し側で済ませておく
+template <typename F>
+size_t allocations_during(F&& sort) {
+    AllocationSection section;
+    sort();
+    return section.stats().allocations;
+}
+
+template <typename T>
+using Sorter = std::function<void(std::vector<T>&)>;
+
+// その場でソートする (作業領域を確保しない) と宣言しているソート。
+// sort/ に in-place のソートを追加したら、ここにも加える
+template <typename T>
+std::vector<std::pair<std::string, Sorter<T>>> in_place_sorts() {
+    std::vector<std::pair<std::string, Sorter<T>>> sorts = {
+        {"bubble_sort", [](auto& v) { bubble_sort(v.begin(), v.end()); }},
+        {"adaptive_bubble_sort", [](auto& v) { adaptive_bubble_sort(v.begin(), v.end()); }},
+        {"shaker_sort", [](auto& v) { shaker_sort(v.begin(), v.end()); }},
+        {"adaptive_shaker_sort", [](auto& v) { adaptive_shaker_sort(v.begin(), v.end()); }},
+        {"selection_sort", [](auto& v) { selection_sort(v.begin(), v.end()); }},
+        {"double_selection_sort", [](auto& v) { double_selection_sort(v.begin(), v.end()); }},
+        {"odd_even_sort", [](auto& v) { odd_even_sort(v.begin(), v.end()); }},
+        {"pdq_sort", [](auto& v) { pdq_sort(v.begin(), v.end()); }},
+        {"intro_select + pdq_sort",
+         [](auto& v) {
+             const auto nth = v.begin() + static_cast<std::ptrdiff_t>(v.size() / 2);
+             intro_select(v.begin(), nth, v.end());
+             pdq_sort(v.begin(), nth);
+             pdq_sort(nth, v.end());
+         }},
+        {"top_k_sort", [](auto& v) { top_k_sort(v.begin(), v.end(), v.end()); }},
+    };
+    if constexpr (std::integral<T>) {
+        sorts.emplace_back("msd_radix_sort", [](auto& v) { msd_radix_sort(v.begin(), v.end()); });
+    }
+    return sorts;
+}
+
+// INDIRECT_SORT_THRESHOLD を超える要素。交換で進むソート (bubble_sort など) は間接ソートに切り替わり、
+// (キー, 位置) の配列を 1 回だけ確保する。in-place と言えるのは INDIRECT_SORT_THRESHOLD 以下の要素だけ
+struct Large {
+    int key = 0;
+    std::array<std::byte, 124> payload{};
+
+    friend constexpr auto operator<=>(const Large& a, const Large& b) { return a.key <=> b.key; }
+    friend constexpr bool operator==(const Large& a, const Large& b) { return a.key == b.key; }
+};
+static_assert(sizeof(Large) > INDIRECT_SORT_THRESHOLD && enable_indirect_sort<Large>);
+
+std::vector<Large> large_elements(size_t size, Workload::Distribution distribution) {
+    const auto keys = Workload::generate<int>(size, {.distribution = distribution});
+    std::vector<Large> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i].key = keys[i];
+    }
+    return v;
+}
+
+constexpr Workload::Distribution DISTRIBUTIONS[] = {
+    Workload::Distribution::Random,    Workload::Distribution::Sorted,       Workload::Distribution::Reversed,
+    Workload::Distribution::FewUnique, Workload::Distribution::OrganPipe,    Workload::Distribution::NearlySorted,
+    Workload::Distribution::AllEqual,  Workload::Distribution::Sawtooth,
+};
+
+constexpr size_t SIZES[] = {0, 1, 2, 17, 100, 1'000};
+
+}  // namespace
+
+TEST_CASE("in-place のソートはソートの呼び出し中にメモリを確保しない") {
+    for (const auto& [name, sort] : in_place_sorts<int>()) {
+        for (const auto distribution : DISTRIBUTIONS) {
+            for (const auto size : SIZES) {
+                auto v = Workload::generate<int>(size, {.distribution = distribution});
+                const auto allocations = allocations_during([&] { sort(v); });
+                INFO(name << " " << Workload::to_string(distribution) << " " << size);
+                REQUIRE(allocations == 0);
+                REQUIRE(std::ranges::is_sorted(v));
+            }
+        }
+    }
+}
+
+TEST_CASE("in-place のソートは射影と降順の比較でもメモリを確保しない") {
+    auto records = Workload::generate<Workload::Record>(1'000);
+    auto descending = records;
+    auto selection = std::vector(records.begin(), records.begin() + 200);
+    const auto allocations = allocations_during([&] {
+        pdq_sort(records.begin(), records.end(), std::less<>(), &Workload::Record::key);
+        pdq_sort(descending.begin(), descending.end(), std::greater<>(), &Workload::Record::key);
+        double_selection_sort(selection.begin(), selection.end(), std::less<>(), &Workload::Record::key);
+    });
+    REQUIRE(allocations == 0);
+    REQUIRE(std::ranges::is_sorted(records, std::less<>(), &Workload::Record::key));
+    REQUIRE(std::ranges::is_sorted(descending, std::greater<>(), &Workload::Record::key));
+    REQUIRE(std::ranges::is_sorted(selection, std::less<>(), &Workload::Record::key));
+}
+
+TEST_CASE("in-place のソートは大きな要素でも確保するのは間接ソートの配列の 1 回まで") {
+    for (const auto& [name, sort] : in_place_sorts<Large>()) {
+        for (const auto distribution : DISTRIBUTIONS) {
+            for (const auto size : SIZES) {
+                auto v = large_elements(size, distribution);
+                const auto allocations = allocations_during([&] { sort(v); });
+                INFO(name << " " << Workload::to_string(distribution) << " " << size);
+                REQUIRE(allocations <= 1);
+                REQUIRE(std::ranges::is_sorted(v));
+            }
+        }
+    }
+}
+
+TEST_CASE("大きな要素では交換で進むソートは確保し、pdq_sort は確保しない") {
+    auto v = large_elements(1'000, Workload::Distribution::Random);
+    auto w = v;
+    REQUIRE(allocations_during([&] { bubble_sort(v.begin(), v.end()); }) == 1);
+    REQUIRE(allocations_during([&] { pdq_sort(w.begin(), w.end()); }) == 0);
+    REQUIRE(std::ranges::is_sorted(v));
+    REQUIRE(std::ranges::is_sorted(w));
+}
+
+TEST_CASE("作業領域を受け取るソートは渡された領域だけを使う") {
+    auto v = Workload::generate<int>(10'000);
+    std::vector<int> scratch(v.size());
+    auto batches = Workload::generate<float>(8 * 64);
+    auto segments = Workload::generate<int>(1'000);
+    std::vector<uint32_t> offsets = {0, 3, 8, 8, 24, 200, 1'000};
+    const auto allocations = allocations_during([&] {
+        radix_sort(v.begin(), v.end(), scratch.begin());
+        network_sort_batch<8>(std::span(batches));
+        segmented_sort(std::span(segments), std::span(offsets));
+    });
+    REQUIRE(allocations == 0);
+    REQUIRE(std::ranges::is_sorted(v));
+    for (size_t i = 0; i < batches.size(); i += 8) {
+        REQUIRE(std::is_sorted(batches.begin() + static_cast<std::ptrdiff_t>(i),
+                               batches.begin() + static_cast<std::ptrdiff_t>(i + 8)));
+    }
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        REQUIRE(std::is_sorted(segments.begin() + offsets[i], segments.begin() + offsets[i + 1]));
+    }
+}
+
+TEST_CASE("作業領域を確保するソートは検査で見つかる") {
+    auto v = Workload::generate<int>(1'000);
+    REQUIRE(allocations_during([&] { tim_sort(v.begin(), v.end()); }) > 0);
+    v = Workload::generate<int>(1'000);
+    REQUIRE(allocations_during([&] { std::stable_sort(v.begin(), v.end()); }) > 0);
+}
@@ -0,0 +1,156 @@
+﻿#include "sort/indirect_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "sort/bubble_sort.hpp"
+#include "sort/selection_sort.hpp"
+#include "sort/shaker_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+namespace {
+
+// 200 バイトのレコード。ムーブの回数を数える (Workload::Record は 64 バイトで間接ソートの対象にならない)
+struct Record {
+    int key = 0;
+    int order = 0;
+    std::array<char, 192> payload{};
+
+    static inline size_t moves = 0;
+
+    Record() = default;
+    Record(int key, int order) : key(key), order(order) {}
+    Record(const Record&) = default;
+    Record(Record&& other) noexcept : key(other.key), order(other.order), payload(other.payload) { ++moves; }
+    Record& operator=(const Record&) = default;
+    Record& operator=(Record&& other) noexcept {
+        key = other.key;
+        order = other.order;
+        payload = other.payload;
+        ++moves;
+        return *this;
+    }
+};
+
+struct SmallRecord {
+    int key;
+    int order;
+};
+
+// キーが unique_values 種類のレコード。order は生成した位置
+std::vector<Record> random_records(size_t size, size_t unique_values, uint64_t seed) {
+    const auto keys = Workload::generate<Workload::Record>(
+        size, {.distribution = Workload::Distribution::FewUnique, .seed = seed, .unique_values = unique_values});
+    std::vector<Record> v;
+    v.reserve(size);
+    for (const auto& key : keys) {
+        v.emplace_back(static_cast<int>(key.key), static_cast<int>(key.id));
+    }
+    return v;
+}
+
+}  // namespace
+
+TEST_CASE("indirect_sort - 自動切り替えの判定") {
+    static_assert(sizeof(Record) > INDIRECT_SORT_THRESHOLD);
+    static_assert(enable_indirect_sort<Record>);
+    static_assert(!enable_indirect_sort<SmallRecord>);
+    static_assert(!enable_indirect_sort<int>);
+}
+
+TEST_CASE("indirect_sort - 算術型のキー") {
+    auto v = random_records(10000, 1000, 1);
+    auto loop_count = indirect_sort(v.begin(), v.end(), std::less<>(), &Record::key);
+    REQUIRE(loop_count > 0);
+    REQUIRE(std::ranges::is_sorted(v, {}, &Record::key));
+}
+
+TEST_CASE("indirect_sort - 各要素のムーブは高々 1 回と巡回ごとに 1 回") {
+    auto v = random_records(10000, 1 << 30, 2);
+    Record::moves = 0;
+    indirect_sort(v.begin(), v.end(), std::greater<>(), &Record::key);
+    REQUIRE(std::ranges::is_sorted(v, std::greater<>(), &Record::key));
+    REQUIRE(Record::moves <= 2 * v.size());
+}
+
+TEST_CASE("indirect_sort - 文字列キーは先頭 8 バイトが等しいときだけ元の要素で比べる") {
+    std::vector<std::string> v = {"prefix__zeta", "prefix__alpha", "prefix_", "b", "", "prefix__", "a", "prefix__al"};
+    auto expected = v;
+    std::ranges::sort(expected);
+    indirect_sort(v.begin(), v.end());
+    REQUIRE(v == expected);
+
+    std::ranges::sort(expected, std::greater<>());
+    indirect_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(v == expected);
+}
+
+TEST_CASE("indirect_sort - 先頭の組に持てない比較関数") {
+    auto v = random_records(1000, 100, 3);
+    indirect_sort(v.begin(), v.end(), [](const Record& a, const Record& b) {
+        return a.key != b.key ? a.key < b.key : a.order < b.order;
+    });
+    REQUIRE(std::ranges::is_sorted(v, [](const Record& a, const Record& b) {
+        return a.key != b.key ? a.key < b.key : a.order < b.order;
+    }));
+}
+
+TEST_CASE("sort_permutation - 要素を動かさずに順序を返す") {
+    auto v = random_records(1000, 100, 4);
+    const auto original_orders = [&] {
+        std::vector<int> orders;
+        for (const auto& r : v) {
+            orders.push_back(r.order);
+        }
+        return orders;
+    }();
+    auto order = sort_permutation(v.begin(), v.end(), std::less<>(), &Record::key);
+    REQUIRE(order.size() == v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(v[i].order == original_orders[i]);
+    }
+    for (size_t i = 1; i < order.size(); ++i) {
+        REQUIRE(v[order[i - 1]].key <= v[order[i]].key);
+    }
+
+    apply_permutation(v.begin(), std::span(order));
+    REQUIRE(std::ranges::is_sorted(v, {}, &Record::key));
+    std::vector<size_t> identity(order.size());
+    std::iota(identity.begin(), identity.end(), size_t{0});
+    REQUIRE(order == identity);
+}
+
+TEST_CASE("indirect_sort - 大きな要素の bubble_sort は同じ手順で安定") {
+    auto v = random_records(500, 20, 5);
+    std::vector<SmallRecord> small;
+    for (const auto& r : v) {
+        small.push_back({r.key, r.order});
+    }
+    Record::moves = 0;
+    auto loop_count = bubble_sort(v.begin(), v.end(), std::less<>(), &Record::key);
+    REQUIRE(loop_count == bubble_sort(small.begin(), small.end(), std::less<>(), &SmallRecord::key));
+    REQUIRE(Record::moves <= 2 * v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(v[i].key == small[i].key);
+        REQUIRE(v[i].order == small[i].order);
+    }
+
+    auto shuffled = random_records(500, 20, 6);
+    auto result = adaptive_shaker_sort(shuffled.begin(), shuffled.end(), std::less<>(), &Record::key);
+    REQUIRE(result.passCount > 0);
+    REQUIRE(std::ranges::is_sorted(shuffled, [](const Record& a, const Record& b) {
+        return a.key != b.key ? a.key < b.key : a.order < b.order;
+    }));
+
+    auto selected = random_records(500, 1000, 7);
+    Record::moves = 0;
+    selection_sort(selected.begin(), selected.end(), std::greater<>(), &Record::key);
+    REQUIRE(std::ranges::is_sorted(selected, std::greater<>(), &Record::key));
+    REQUIRE(Record::moves <= 2 * selected.size());
+}
@@ -0,0 +1,66 @@
+﻿#include "sort/instrumentation.hpp"
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "sort/bubble_sort.hpp"
+#include "sort/selection_sort.hpp"
+#include "sort/shaker_sort.hpp"
+
+using namespace AlgorithmSamples::Sort;
+
+namespace {
+std::vector<Counted<int>> counted(const std::vector<int>& values) {
+    std::vector<Counted<int>> v(values.begin(), values.end());
+    reset_operation_counts();
+    return v;
+}
+
+std::vector<int> values(const std::vector<Counted<int>>& v) {
+    std::vector<int> result;
+    for (const auto& c : v) {
+        result.push_back(c.value());
+    }
+    return result;
+}
+}  // namespace
+
+TEST_CASE("instrumentation - bubble_sort 逆順") {
+    auto v = counted({5, 4, 3, 2, 1});
+    auto loop_count = bubble_sort(v.begin(), v.end());
+    auto counts = operation_counts();
+    REQUIRE(values(v) == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(counts.comparisons == loop_count);
+    REQUIRE(counts.swaps == 10);
+    REQUIRE(counts.writes == 20);
+    REQUIRE(counts.moves == 0);
+}
+
+TEST_CASE("instrumentation - bubble_sort 既にソート済み") {
+    auto v = counted({1, 2, 3, 4, 5});
+    bubble_sort(v.begin(), v.end());
+    REQUIRE(operation_counts() == OperationCounts{10, 0, 0, 0});
+}
+
+TEST_CASE("instrumentation - selection_sort の交換回数") {
+    auto v = counted({5, 4, 3, 2, 1});
+    selection_sort(v.begin(), v.end());
+    REQUIRE(values(v) == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(operation_counts().comparisons == 10);
+    REQUIRE(operation_counts().swaps == 2);
+}
+
+TEST_CASE("instrumentation - shaker_sort 降順") {
+    auto v = counted({1, 2, 3, 4, 5});
+    auto loop_count = shaker_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(values(v) == std::vector{5, 4, 3, 2, 1});
+    REQUIRE(operation_counts().comparisons == loop_count);
+    REQUIRE(operation_counts().swaps == 10);
+}
+
+TEST_CASE("instrumentation - CountingComparator") {
+    std::vector v = {3, 1, 2};
+    reset_operation_counts();
+    auto loop_count = bubble_sort(v.begin(), v.end(), CountingComparator{std::less<>()});
+    REQUIRE(v == std::vector{1, 2, 3});
+    REQUIRE(operation_counts().comparisons == loop_count);
+    REQUIRE(operation_counts().swaps == 0);
+}
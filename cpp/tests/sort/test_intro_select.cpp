@@ -0,0 +1,158 @@
+﻿#include "sort/intro_select.hpp"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+namespace {
+
+// nth の位置がソート後と一致し、前後がそれぞれ以下・以上になっているか
+template <typename Comparator = std::less<>>
+bool is_selected(const std::vector<int>& v, size_t nth, const std::vector<int>& sorted, Comparator comparator = {}) {
+    const auto& pivot = v[nth];
+    return pivot == sorted[nth] &&
+           std::all_of(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(nth),
+                       [&](int x) { return !comparator(pivot, x); }) &&
+           std::all_of(v.begin() + static_cast<std::ptrdiff_t>(nth), v.end(),
+                       [&](int x) { return !comparator(x, pivot); });
+}
+
+}  // namespace
+
+TEST_CASE("intro_select - 中央値") {
+    std::vector v = {5, 3, 1, 4, 2};
+    intro_select(v.begin(), v.begin() + 2, v.end());
+    REQUIRE(v[2] == 3);
+    REQUIRE(std::max(v[0], v[1]) <= 3);
+    REQUIRE(std::min(v[3], v[4]) >= 3);
+}
+
+TEST_CASE("intro_select - 要素数 0 と 1・nth が末尾") {
+    std::vector<int> empty;
+    REQUIRE(intro_select(empty.begin(), empty.begin(), empty.end()) == 0);
+    std::vector single = {42};
+    REQUIRE(intro_select(single.begin(), single.begin(), single.end()) == 0);
+    std::vector v = {3, 1, 2};
+    REQUIRE(intro_select(v.begin(), v.end(), v.end()) == 0);
+    REQUIRE(v == std::vector{3, 1, 2});
+}
+
+TEST_CASE("intro_select - ランダムな入力のすべての位置") {
+    for (auto size : {2, 7, 24, 25, 100, 1000}) {
+        const Workload::Options options = {.distribution = Workload::Distribution::FewUnique,
+                                           .seed = static_cast<uint64_t>(size),
+                                           .unique_values = static_cast<size_t>(size / 2 + 1)};
+        auto input = Workload::generate<int>(static_cast<size_t>(size), options);
+        auto sorted = input;
+        std::ranges::sort(sorted);
+        for (size_t nth = 0; nth < input.size(); nth += std::max<size_t>(1, input.size() / 50)) {
+            auto v = input;
+            intro_select(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(nth), v.end());
+            REQUIRE(is_selected(v, nth, sorted));
+        }
+    }
+}
+
+TEST_CASE("intro_select - 降順・重複あり・大きな入力") {
+    auto input = Workload::generate<int>(200000, {.distribution = Workload::Distribution::FewUnique,
+                                                  .seed = 7,
+                                                  .unique_values = 101});
+    auto sorted = input;
+    std::ranges::sort(sorted, std::greater<>());
+    for (size_t nth : {size_t{0}, size_t{1}, size_t{99999}, size_t{199999}}) {
+        auto v = input;
+        intro_select(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(nth), v.end(), std::greater<>());
+        REQUIRE(is_selected(v, nth, sorted, std::greater<>()));
+    }
+}
+
+TEST_CASE("intro_select - 全要素が等しい入力は線形時間") {
+    std::vector<int> v(100000, 7);
+    auto loop_count = intro_select(v.begin(), v.begin() + 50000, v.end());
+    REQUIRE(v[50000] == 7);
+    REQUIRE(loop_count < 4 * v.size());
+}
+
+TEST_CASE("intro_select - median of medians だけでも正しく選べる") {
+    // 標本のピボットで分割してよい要素数を 0 にして、最初から median of medians でピボットを選ばせる
+    for (auto pattern : {0, 1, 2, 3}) {
+        std::vector<int> input(10007);
+        if (pattern == 0) {
+            input = Workload::generate<int>(input.size(), {.seed = 3});
+        } else if (pattern == 1) {
+            std::iota(input.begin(), input.end(), 0);
+        } else if (pattern == 2) {
+            std::iota(input.rbegin(), input.rend(), 0);
+        } else {
+            input = Workload::generate<int>(input.size(), {.distribution = Workload::Distribution::FewUnique,
+                                                           .seed = 5,
+                                                           .unique_values = 4});
+        }
+        auto sorted = input;
+        std::ranges::sort(sorted);
+        for (size_t nth : {size_t{0}, size_t{17}, size_t{5003}, size_t{10006}}) {
+            auto v = input;
+            std::less<> comparator;
+            size_t loop_count = 0;
+            detail::select::intro_select_loop<false>(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(nth),
+                                                     v.end(), comparator, 0, true, loop_count);
+            REQUIRE(is_selected(v, nth, sorted));
+            // 最悪でも線形時間
+            REQUIRE(loop_count < 40 * v.size());
+        }
+    }
+}
+
+TEST_CASE("intro_select - 分割が偏るように作った入力でも比較回数は線形") {
+    // McIlroy の "A Killer Adversary for Quicksort" の方法で入力を作る。値を未定のまま比較させ、
+    // 未定どうしを比べたらピボットの候補を小さい値に固定していくので、毎回の分割が端に偏る
+    for (size_t size : {size_t{1} << 12, size_t{1} << 16}) {
+        const auto nth = static_cast<std::ptrdiff_t>(size / 2);
+        const int gas = static_cast<int>(size);
+        std::vector<int> input(size, gas);
+        int solid = 0;
+        int candidate = 0;
+        std::vector<int> indices(size);
+        std::iota(indices.begin(), indices.end(), 0);
+        intro_select(indices.begin(), indices.begin() + nth, indices.end(), [&](int x, int y) {
+            if (input[x] == gas && input[y] == gas) {
+                input[x == candidate ? x : y] = solid++;
+            }
+            if (input[x] == gas) {
+                candidate = x;
+            } else if (input[y] == gas) {
+                candidate = y;
+            }
+            return input[x] < input[y];
+        });
+
+        // 作った入力を、同じ (汎用の) 比較関数の経路で選び直して比較回数を数える
+        auto v = input;
+        size_t comparisons = 0;
+        intro_select(v.begin(), v.begin() + nth, v.end(), [&](int a, int b) {
+            ++comparisons;
+            return a < b;
+        });
+        auto sorted = input;
+        std::ranges::sort(sorted);
+        REQUIRE(is_selected(v, static_cast<size_t>(nth), sorted));
+        REQUIRE(comparisons < 16 * size);
+    }
+}
+
+TEST_CASE("intro_select - 射影") {
+    std::vector<std::string> v = {"pear", "apple", "fig", "banana", "kiwi"};
+    intro_select(v.begin(), v.begin(), v.end(), std::less<>(), &std::string::size);
+    REQUIRE(v.front() == "fig");
+}
+
+TEST_CASE("intro_select - コンパイル時選択") {
+    constexpr auto result = intro_select(std::array{9, 4, 7, 1, 8, 2, 6, 3, 5}, 4);
+    static_assert(std::get<0>(result)[4] == 5);
+}
@@ -0,0 +1,199 @@
+﻿#include "sort/network_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Sort;
+
+namespace {
+// 0-1 原理: 0 と 1 からなる全入力をソートできれば、任意の入力をソートできる
+template <std::size_t N>
+bool sorts_all_binary_inputs() {
+    for (uint32_t bits = 0; bits < (uint32_t{1} << N); ++bits) {
+        std::array<int, N> arr{};
+        for (std::size_t i = 0; i < N; ++i) {
+            arr[i] = static_cast<int>((bits >> i) & 1);
+        }
+        network_sort<N>(arr.begin());
+        if (!std::ranges::is_sorted(arr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::size_t... N>
+bool sorts_all_binary_inputs(std::index_sequence<N...>) {
+    return (sorts_all_binary_inputs<N>() && ...);
+}
+
+template <std::size_t N, typename T>
+void require_batch_sorted(unsigned seed) {
+    constexpr std::size_t ARRAY_COUNT = 37;  // SIMD の幅で割り切れない数
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<int> dist(-1'000, 1'000);
+    std::vector<T> data(N * ARRAY_COUNT);
+    std::ranges::generate(data, [&] { return static_cast<T>(dist(engine)); });
+
+    auto ascending = data;
+    auto descending = data;
+    network_sort_batch<N>(std::span(ascending));
+    network_sort_batch<N>(std::span(descending), std::greater<>());
+
+    for (std::size_t i = 0; i < ARRAY_COUNT; ++i) {
+        std::vector<T> expected(data.begin() + i * N, data.begin() + (i + 1) * N);
+        std::ranges::sort(expected);
+        REQUIRE(std::equal(expected.begin(), expected.end(), ascending.begin() + i * N));
+        REQUIRE(std::equal(expected.rbegin(), expected.rend(), descending.begin() + i * N));
+    }
+}
+
+std::vector<uint32_t> bit_patterns(std::span<const float> values) {
+    std::vector<uint32_t> bits;
+    for (const auto value : values) {
+        bits.push_back(std::bit_cast<uint32_t>(value));
+    }
+    return bits;
+}
+}  // namespace
+
+TEST_CASE("network_sort - 昇順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    auto loop_count = network_sort<5>(v.begin());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count == 9);
+}
+
+TEST_CASE("network_sort - 降順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    network_sort<5>(v.begin(), std::greater<>());
+    REQUIRE(v == std::vector{5, 4, 3, 2, 1});
+}
+
+TEST_CASE("network_sort - ネットワークの大きさ") {
+    // 既知の最適値 (N <= 8) と Batcher のネットワークの大きさ
+    REQUIRE(SORTING_NETWORK<0>.size() == 0);
+    REQUIRE(SORTING_NETWORK<1>.size() == 0);
+    REQUIRE(SORTING_NETWORK<2>.size() == 1);
+    REQUIRE(SORTING_NETWORK<3>.size() == 3);
+    REQUIRE(SORTING_NETWORK<4>.size() == 5);
+    REQUIRE(SORTING_NETWORK<5>.size() == 9);
+    REQUIRE(SORTING_NETWORK<6>.size() == 12);
+    REQUIRE(SORTING_NETWORK<7>.size() == 16);
+    REQUIRE(SORTING_NETWORK<8>.size() == 19);
+    REQUIRE(SORTING_NETWORK<16>.size() == 63);
+    REQUIRE(SORTING_NETWORK<32>.size() == 191);
+    REQUIRE(SORTING_NETWORK<64>.size() == 543);
+}
+
+TEST_CASE("network_sort - 0-1 原理による全入力の検証 (N <= 16)") {
+    REQUIRE(sorts_all_binary_inputs(std::make_index_sequence<17>{}));
+}
+
+TEST_CASE("network_sort - 大きな N") {
+    std::mt19937 engine(1);
+    std::array<int, 64> arr{};
+    for (int round = 0; round < 100; ++round) {
+        std::ranges::generate(arr, [&] { return static_cast<int>(engine() % 100); });
+        auto expected = arr;
+        std::ranges::sort(expected);
+        network_sort<64>(arr.begin());
+        REQUIRE(arr == expected);
+    }
+}
+
+TEST_CASE("network_sort - 文字列") {
+    std::vector<std::string> strings = {"banana", "apple", "cherry", "date"};
+    network_sort<4>(strings.begin());
+    REQUIRE(strings == std::vector<std::string>{"apple", "banana", "cherry", "date"});
+}
+
+TEST_CASE("network_sort_batch - int32_t") {
+    require_batch_sorted<8, int32_t>(1);
+    require_batch_sorted<13, int32_t>(2);
+    require_batch_sorted<64, int32_t>(3);
+}
+
+TEST_CASE("network_sort_batch - float") {
+    require_batch_sorted<8, float>(4);
+    require_batch_sorted<24, float>(5);
+}
+
+TEST_CASE("network_sort_batch - NaN と ±0 を含む float もスカラーと同じ並べ替えになる") {
+    constexpr std::size_t N = 8;
+    constexpr std::size_t ARRAY_COUNT = 16;
+    constexpr float SPECIAL[] = {std::numeric_limits<float>::quiet_NaN(), -0.0f, 0.0f, 1.0f};
+    std::vector<float> data(N * ARRAY_COUNT);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = SPECIAL[(i * 7 + i / N) % std::size(SPECIAL)];
+    }
+    // std::less<> / std::greater<> 以外の比較関数はスカラーの比較交換で処理する
+    auto scalar_less = [](float a, float b) { return a < b; };
+    auto scalar_greater = [](float a, float b) { return a > b; };
+    for (const bool descending : {false, true}) {
+        auto simd = data;
+        auto scalar = data;
+        if (descending) {
+            network_sort_batch<N>(std::span(simd), std::greater<>());
+            network_sort_batch<N>(std::span(scalar), scalar_greater);
+        } else {
+            network_sort_batch<N>(std::span(simd));
+            network_sort_batch<N>(std::span(scalar), scalar_less);
+        }
+        REQUIRE(bit_patterns(simd) == bit_patterns(scalar));
+        for (std::size_t i = 0; i < ARRAY_COUNT; ++i) {
+            // 要素の並べ替えになっている (NaN が消えたり、-0.0 が 0.0 に書き換わったりしない)
+            auto before = bit_patterns(std::span(data).subspan(i * N, N));
+            auto after = bit_patterns(std::span(simd).subspan(i * N, N));
+            std::ranges::sort(before);
+            std::ranges::sort(after);
+            REQUIRE(before == after);
+        }
+    }
+}
+
+TEST_CASE("network_sort_batch - その他の型はスカラーで処理する") {
+    require_batch_sorted<16, int64_t>(6);
+    require_batch_sorted<16, double>(7);
+}
+
+TEST_CASE("network_sort - コンパイル時ソート") {
+    constexpr auto result = network_sort(std::array{5, 3, 1, 4, 2});
+    REQUIRE(std::get<0>(result) == std::array{1, 2, 3, 4, 5});
+    REQUIRE(std::get<1>(result) == 9);
+    STATIC_REQUIRE(std::ranges::is_sorted(std::get<0>(network_sort(std::array{9, 8, 7, 6, 5, 4, 3, 2, 1, 0, -1}))));
+}
+
+TEST_CASE("network_sort - 空配列") {
+    constexpr auto result = network_sort(std::array<int, 0>{});
+    REQUIRE(std::get<0>(result) == std::array<int, 0>{});
+    REQUIRE(std::get<1>(result) == 0);
+}
+
+TEST_CASE("network_sort - 単一要素") {
+    constexpr auto result = network_sort(std::array{42});
+    REQUIRE(std::get<0>(result) == std::array{42});
+    REQUIRE(std::get<1>(result) == 0);
+}
+
+TEST_CASE("network_sort - 射影でメンバをキーにする") {
+    struct Item {
+        int key;
+        std::string name;
+    };
+    std::vector<Item> v = {{4, "d"}, {2, "b"}, {3, "c"}, {1, "a"}};
+    network_sort<4>(v.begin(), std::less<>(), &Item::key);
+    REQUIRE(std::ranges::is_sorted(v, {}, &Item::key));
+    REQUIRE(v.front().name == "a");
+
+    // 射影があるときは SIMD を使わずスカラーで処理する
+    std::vector<int32_t> batch = {3, -1, 2, -4, 1, -2, 4, -3};
+    network_sort_batch<4>(std::span(batch), std::less<>(), [](int32_t n) { return n < 0 ? -n : n; });
+    REQUIRE(batch == std::vector<int32_t>{-1, 2, 3, -4, 1, -2, -3, 4});
+}
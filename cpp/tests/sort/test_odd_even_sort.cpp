@@ -0,0 +1,186 @@
+﻿#include "sort/odd_even_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "sort/bubble_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+namespace {
+
+// 比較関数をラムダで包んで高速版 (分岐なし・SIMD) を通らないようにした結果と、標準の比較関数での結果を比べる
+template <typename T, typename Compare>
+void check_fast_exchange(std::vector<T> input, Compare compare) {
+    auto expected = input;
+    const auto expected_count =
+        odd_even_sort(expected.begin(), expected.end(), [&](const T& a, const T& b) { return compare(a, b); });
+    const auto count = odd_even_sort(input.begin(), input.end(), compare);
+    REQUIRE(std::ranges::is_sorted(input, compare));
+    REQUIRE(std::ranges::equal(input, expected, [](T a, T b) { return std::signbit(a) == std::signbit(b) && a == b; }));
+    REQUIRE(count == expected_count);
+}
+
+}  // namespace
+
+TEST_CASE("odd_even_sort - 昇順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    auto loop_count = odd_even_sort(v.begin(), v.end());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("odd_even_sort - 降順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    odd_even_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(v == std::vector{5, 4, 3, 2, 1});
+}
+
+TEST_CASE("odd_even_sort - 要素数 0, 1, 2") {
+    std::vector<int> empty;
+    REQUIRE(odd_even_sort(empty.begin(), empty.end()) == 0);
+    std::vector single = {42};
+    REQUIRE(odd_even_sort(single.begin(), single.end()) == 0);
+    std::vector two_elements = {2, 1};
+    REQUIRE(odd_even_sort(two_elements.begin(), two_elements.end()) == 1);
+    REQUIRE(two_elements == std::vector{1, 2});
+}
+
+TEST_CASE("odd_even_sort - 既にソート済みなら 2 フェーズで終わる") {
+    std::vector<int> sorted(1'001);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    REQUIRE(odd_even_sort(sorted.begin(), sorted.end()) == sorted.size() - 1);
+    REQUIRE(std::ranges::is_sorted(sorted));
+}
+
+TEST_CASE("odd_even_sort - 逆順は n フェーズかかる") {
+    // 各フェーズで n / 2 組 (n が偶数なら偶数フェーズ n / 2 組、奇数フェーズ n / 2 - 1 組) を比べる
+    std::vector<int> reversed(100);
+    std::iota(reversed.rbegin(), reversed.rend(), 0);
+    OddEvenSortPasses passes(reversed.begin(), reversed.end());
+    while (!passes.done()) {
+        passes.run_pass();
+    }
+    REQUIRE(std::ranges::is_sorted(reversed));
+    REQUIRE(passes.pass_count() == 100);
+    REQUIRE(passes.loop_count() == 50 * 50 + 50 * 49);
+}
+
+TEST_CASE("odd_even_sort - 重複要素あり") {
+    std::vector duplicates = {3, 1, 4, 1, 5, 9, 2, 6, 5};
+    odd_even_sort(duplicates.begin(), duplicates.end());
+    REQUIRE(duplicates == std::vector{1, 1, 2, 3, 4, 5, 5, 6, 9});
+}
+
+TEST_CASE("odd_even_sort - 文字列と射影") {
+    std::vector<std::string> strings = {"banana", "apple", "cherry", "date"};
+    odd_even_sort(strings.begin(), strings.end());
+    REQUIRE(strings == std::vector<std::string>{"apple", "banana", "cherry", "date"});
+
+    struct Item {
+        int key;
+        std::string name;
+    };
+    std::vector<Item> v = {{3, "c"}, {1, "a"}, {2, "b"}};
+    odd_even_sort(v.begin(), v.end(), std::greater<>(), &Item::key);
+    REQUIRE(v[0].name == "c");
+    REQUIRE(v[2].name == "a");
+}
+
+TEST_CASE("odd_even_sort - 大きな要素は間接ソートでも同じ比較回数") {
+    auto records = Workload::generate<Workload::Record>(300);
+    auto keys = std::vector<int64_t>(records.size());
+    std::ranges::transform(records, keys.begin(), [](const auto& r) { return r.key; });
+    const auto count = odd_even_sort(records.begin(), records.end(), std::less<>(), &Workload::Record::key);
+    REQUIRE(std::ranges::is_sorted(records, std::less<>(), &Workload::Record::key));
+    REQUIRE(count == odd_even_sort(keys.begin(), keys.end()));
+}
+
+TEST_CASE("odd_even_sort - 高速版は汎用版と同じ結果・比較回数") {
+    for (size_t size : {3, 8, 17, 64, 257}) {
+        for (auto distribution : {Workload::Distribution::Random, Workload::Distribution::Reversed,
+                                  Workload::Distribution::FewUnique}) {
+            const auto ints = Workload::generate<int>(size, {.distribution = distribution});
+            check_fast_exchange(ints, std::less<>());
+            check_fast_exchange(ints, std::greater<int>());
+            check_fast_exchange(Workload::generate<float>(size, {.distribution = distribution}), std::less<>());
+            check_fast_exchange(Workload::generate<double>(size, {.distribution = distribution}), std::greater<>());
+            std::vector<int64_t> wide(ints.begin(), ints.end());
+            check_fast_exchange(wide, std::less<>());
+        }
+    }
+}
+
+TEST_CASE("odd_even_sort - ±0 と NaN を含む浮動小数点数") {
+    // 等しい値は入れ替えないので、-0.0 と 0.0 が並んでいても交換が繰り返されない
+    std::vector<float> zeros(64);
+    for (size_t i = 0; i < zeros.size(); ++i) {
+        zeros[i] = i % 2 == 0 ? -0.0f : 0.0f;
+    }
+    check_fast_exchange(zeros, std::less<>());
+    REQUIRE(odd_even_sort(zeros.begin(), zeros.end()) == zeros.size() - 1);
+
+    std::vector<float> with_nan = {3, 1, std::numeric_limits<float>::quiet_NaN(), 2, 0, 5, 4, 7, 6, 9, 8, 1};
+    auto expected = with_nan;
+    const auto expected_count = odd_even_sort(expected.begin(), expected.end(), [](float a, float b) { return a < b; });
+    REQUIRE(odd_even_sort(with_nan.begin(), with_nan.end()) == expected_count);
+    for (size_t i = 0; i < with_nan.size(); ++i) {
+        REQUIRE((with_nan[i] == expected[i] || (std::isnan(with_nan[i]) && std::isnan(expected[i]))));
+    }
+}
+
+TEST_CASE("odd_even_sort - コンパイル時ソート") {
+    constexpr auto result = odd_even_sort(std::array{9, 7, 5, 3, 1, 8, 6, 4, 2, 0});
+    STATIC_REQUIRE(std::get<0>(result) == std::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    STATIC_REQUIRE(std::get<1>(result) > 0);
+}
+
+TEST_CASE("parallel_odd_even_sort - 逐次版と同じ結果・比較回数") {
+    for (size_t threads : {1, 2, 3, 4, 7}) {
+        for (size_t size : {0, 1, 2, 15, 16, 101, 1'000}) {
+            auto input = Workload::generate<int>(size);
+            auto expected = input;
+            const auto expected_count = odd_even_sort(expected.begin(), expected.end());
+            // 小さな入力でもスレッドに分かれるように、1 スレッドあたりの下限を下げる
+            const auto count = parallel_odd_even_sort(input.begin(), input.end(),
+                                                      {.thread_count = threads, .min_elements_per_thread = 2});
+            REQUIRE(input == expected);
+            REQUIRE(count == expected_count);
+        }
+    }
+}
+
+TEST_CASE("parallel_odd_even_sort - 比較関数・射影と汎用の型") {
+    const OddEvenSortOptions options{.thread_count = 4, .min_elements_per_thread = 8};
+    auto v = Workload::generate<int>(500, {.distribution = Workload::Distribution::OrganPipe});
+    parallel_odd_even_sort(v.begin(), v.end(), options, std::greater<>());
+    REQUIRE(std::ranges::is_sorted(v, std::greater<>()));
+
+    auto strings = Workload::generate<std::string>(300);
+    auto expected = strings;
+    std::ranges::stable_sort(expected, std::less<>(), [](const std::string& s) { return s.size(); });
+    parallel_odd_even_sort(strings.begin(), strings.end(), options, std::less<>(),
+                           [](const std::string& s) { return s.size(); });
+    // 隣り合う要素しか入れ替えないので安定
+    REQUIRE(strings == expected);
+
+    auto records = Workload::generate<Workload::Record>(300);
+    parallel_odd_even_sort(records.begin(), records.end(), options, std::less<>(), &Workload::Record::key);
+    REQUIRE(std::ranges::is_sorted(records, std::less<>(), &Workload::Record::key));
+}
+
+TEST_CASE("odd_even_sort - 比較回数はバブルソート以下") {
+    auto v = Workload::generate<int>(1'000);
+    auto w = v;
+    REQUIRE(odd_even_sort(v.begin(), v.end()) <= bubble_sort(w.begin(), w.end()));
+    REQUIRE(v == w);
+}
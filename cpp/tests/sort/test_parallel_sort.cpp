@@ -0,0 +1,101 @@
+﻿#include "sort/parallel_sort.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Concurrency;
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+TEST_CASE("parallel_sort - 昇順") {
+    WorkStealingPool pool(4);
+    std::vector v = {5, 3, 1, 4, 2};
+    parallel_sort(v.begin(), v.end(), pool);
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+}
+
+TEST_CASE("parallel_sort - 要素数 0") {
+    WorkStealingPool pool(4);
+    std::vector<int> empty;
+    auto loop_count = parallel_sort(empty.begin(), empty.end(), pool);
+    REQUIRE(empty.empty());
+    REQUIRE(loop_count == 0);
+}
+
+TEST_CASE("parallel_sort - 大きなランダム配列") {
+    for (size_t threads : {1, 2, 4, 8}) {
+        WorkStealingPool pool(threads);
+        auto v = Workload::generate<int>(500'000, {.seed = threads});
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+        auto loop_count = parallel_sort(v.begin(), v.end(), pool);
+        REQUIRE(v == expected);
+        REQUIRE(loop_count > 0);
+    }
+}
+
+TEST_CASE("parallel_sort - 降順・重複あり") {
+    WorkStealingPool pool(4);
+    auto v = Workload::generate<int>(300'000, {.distribution = Workload::Distribution::FewUnique,
+                                               .seed = 1,
+                                               .unique_values = 11});
+    auto expected = v;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    parallel_sort(v.begin(), v.end(), std::greater<>(), pool);
+    REQUIRE(v == expected);
+}
+
+TEST_CASE("parallel_sort - 文字列") {
+    WorkStealingPool pool(3);
+    std::vector<std::string> strings;
+    for (auto n : Workload::generate<int>(100'000, {.seed = 2})) {
+        strings.push_back(std::to_string(n));
+    }
+    auto expected = strings;
+    std::sort(expected.begin(), expected.end());
+    parallel_sort(strings.begin(), strings.end(), pool);
+    REQUIRE(strings == expected);
+}
+
+TEST_CASE("parallel_sort - 射影でメンバをキーにする") {
+    struct Item {
+        int key;
+        int original;
+    };
+    WorkStealingPool pool(4);
+    auto keys = Workload::generate<int>(100000, {.distribution = Workload::Distribution::FewUnique,
+                                                 .seed = 3,
+                                                 .unique_values = 1000});
+    std::vector<Item> v(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        v[i] = {keys[i], keys[i]};
+    }
+    parallel_sort(v.begin(), v.end(), std::greater<>(), &Item::key, pool);
+    REQUIRE(std::ranges::is_sorted(v, std::greater<>(), &Item::key));
+    REQUIRE(std::ranges::all_of(v, [](const Item& item) { return item.key == item.original; }));
+}
+
+TEST_CASE("parallel_sort - 比較関数の例外はタスクが終わってから呼び出し元に届く") {
+    WorkStealingPool pool(4);
+    const auto input = Workload::generate<int>(1 << 20);
+    // 葉の pdq_sort・並列マージ・最初の比較のそれぞれで投げる
+    for (size_t limit : {size_t{1}, size_t{100'000}, size_t{3'000'000}}) {
+        auto v = input;
+        std::atomic<size_t> calls = 0;
+        auto throwing = [&](int a, int b) {
+            if (calls.fetch_add(1, std::memory_order_relaxed) + 1 == limit) {
+                throw std::runtime_error("comparator failed");
+            }
+            return a < b;
+        };
+        REQUIRE_THROWS_AS(parallel_sort(v.begin(), v.end(), throwing, pool), std::runtime_error);
+    }
+    // 例外の後もプールは使える
+    auto v = input;
+    parallel_sort(v.begin(), v.end(), pool);
+    REQUIRE(std::ranges::is_sorted(v));
+}
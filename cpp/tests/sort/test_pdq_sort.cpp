@@ -0,0 +1,200 @@
+﻿#include "sort/pdq_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+TEST_CASE("pdq_sort - 昇順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    auto loop_count = pdq_sort(v.begin(), v.end());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("pdq_sort - 降順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    auto loop_count = pdq_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(v == std::vector{5, 4, 3, 2, 1});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("pdq_sort - 要素数 0") {
+    std::vector<int> empty;
+    auto loop_count = pdq_sort(empty.begin(), empty.end());
+    REQUIRE(empty.empty());
+    REQUIRE(loop_count == 0);
+}
+
+TEST_CASE("pdq_sort - 要素数 1") {
+    std::vector single = {42};
+    auto loop_count = pdq_sort(single.begin(), single.end());
+    REQUIRE(single == std::vector{42});
+    REQUIRE(loop_count == 0);
+}
+
+TEST_CASE("pdq_sort - 要素数 2") {
+    std::vector two_elements = {2, 1};
+    auto loop_count = pdq_sort(two_elements.begin(), two_elements.end());
+    REQUIRE(two_elements == std::vector{1, 2});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("pdq_sort - 既にソート済み") {
+    std::vector sorted = {1, 2, 3, 4, 5};
+    auto loop_count = pdq_sort(sorted.begin(), sorted.end());
+    REQUIRE(sorted == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("pdq_sort - 逆順") {
+    std::vector reversed = {5, 4, 3, 2, 1};
+    auto loop_count = pdq_sort(reversed.begin(), reversed.end());
+    REQUIRE(reversed == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("pdq_sort - 重複要素あり") {
+    std::vector duplicates = {3, 1, 4, 1, 5, 9, 2, 6, 5};
+    auto loop_count = pdq_sort(duplicates.begin(), duplicates.end());
+    REQUIRE(duplicates == std::vector{1, 1, 2, 3, 4, 5, 5, 6, 9});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("pdq_sort - コンパイル時ソート") {
+    constexpr auto result = pdq_sort(std::array{5, 3, 1, 4, 2});
+    REQUIRE(std::get<0>(result) == std::array{1, 2, 3, 4, 5});
+    REQUIRE(std::get<1>(result) > 0);
+}
+
+TEST_CASE("pdq_sort - コンパイル時降順ソート") {
+    constexpr auto result = pdq_sort(std::array{5, 3, 1, 4, 2}, std::greater<>());
+    REQUIRE(std::get<0>(result) == std::array{5, 4, 3, 2, 1});
+    REQUIRE(std::get<1>(result) > 0);
+}
+
+TEST_CASE("pdq_sort - 空配列") {
+    constexpr auto result = pdq_sort(std::array<int, 0>{});
+    REQUIRE(std::get<0>(result) == std::array<int, 0>{});
+    REQUIRE(std::get<1>(result) == 0);
+}
+
+TEST_CASE("pdq_sort - 単一要素") {
+    constexpr auto result = pdq_sort(std::array{42});
+    REQUIRE(std::get<0>(result) == std::array{42});
+    REQUIRE(std::get<1>(result) == 0);
+}
+
+TEST_CASE("pdq_sort - 文字列ソート") {
+    std::vector<std::string> strings = {"banana", "apple", "cherry", "date"};
+    pdq_sort(strings.begin(), strings.end());
+    REQUIRE(strings == std::vector<std::string>{"apple", "banana", "cherry", "date"});
+}
+
+TEST_CASE("pdq_sort - 浮動小数点数") {
+    std::vector<double> floats = {3.14, 2.71, 1.41, 1.73};
+    pdq_sort(floats.begin(), floats.end());
+    REQUIRE(floats == std::vector<double>{1.41, 1.73, 2.71, 3.14});
+}
+
+namespace {
+template <typename T, typename Comparator = std::less<>>
+void require_same_as_std_sort(std::vector<T> v, Comparator comparator = {}) {
+    auto expected = v;
+    std::sort(expected.begin(), expected.end(), comparator);
+    pdq_sort(v.begin(), v.end(), comparator);
+    REQUIRE(v == expected);
+}
+}  // namespace
+
+TEST_CASE("pdq_sort - 大きなランダム配列") {
+    require_same_as_std_sort(Workload::generate<int>(100'000, {.seed = 1}));
+    require_same_as_std_sort(Workload::generate<int>(100'000, {.seed = 2}), std::greater<>());
+}
+
+TEST_CASE("pdq_sort - 重複の多い配列") {
+    require_same_as_std_sort(Workload::generate<int>(100'000, {.distribution = Workload::Distribution::FewUnique,
+                                                               .seed = 3,
+                                                               .unique_values = 4}));
+    require_same_as_std_sort(std::vector<int>(10'000, 7));
+}
+
+TEST_CASE("pdq_sort - パターンのある配列") {
+    std::vector<int> ascending(50'000);
+    std::iota(ascending.begin(), ascending.end(), 0);
+    require_same_as_std_sort(ascending);
+
+    std::vector<int> descending(ascending.rbegin(), ascending.rend());
+    require_same_as_std_sort(descending);
+
+    std::vector<int> organ_pipe(50'000);
+    for (size_t i = 0; i < organ_pipe.size(); ++i) {
+        organ_pipe[i] = static_cast<int>(std::min(i, organ_pipe.size() - 1 - i));
+    }
+    require_same_as_std_sort(organ_pipe);
+
+    std::vector<int> sawtooth(50'000);
+    for (size_t i = 0; i < sawtooth.size(); ++i) {
+        sawtooth[i] = static_cast<int>(i % 1'000);
+    }
+    require_same_as_std_sort(sawtooth);
+}
+
+TEST_CASE("pdq_sort - 分岐あり分割 (ユーザー定義の比較関数)") {
+    auto v = Workload::generate<int>(100'000, {.distribution = Workload::Distribution::FewUnique,
+                                               .seed = 4,
+                                               .unique_values = 1'000});
+    require_same_as_std_sort(v, [](int a, int b) { return a > b; });
+
+    std::vector<std::string> strings;
+    for (auto n : Workload::generate<int>(10'000, {.seed = 5})) {
+        strings.push_back(std::to_string(n));
+    }
+    require_same_as_std_sort(strings);
+}
+
+TEST_CASE("pdq_sort - 整列済みの入力は線形時間") {
+    std::vector<int> sorted(100'000);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    auto loop_count = pdq_sort(sorted.begin(), sorted.end());
+    REQUIRE(std::is_sorted(sorted.begin(), sorted.end()));
+    REQUIRE(loop_count < 4 * sorted.size());
+}
+
+TEST_CASE("pdq_sort - コンパイル時ソート (分割あり)") {
+    constexpr auto result = [] {
+        std::array<int, 300> arr{};
+        for (size_t i = 0; i < arr.size(); ++i) {
+            arr[i] = static_cast<int>((i * 7'919) % 301);
+        }
+        return std::get<0>(pdq_sort(arr));
+    }();
+    STATIC_REQUIRE(std::is_sorted(result.begin(), result.end()));
+}
+
+TEST_CASE("pdq_sort - 射影でメンバをキーにする") {
+    struct Item {
+        int key;
+        std::string name;
+    };
+    std::vector<Item> v = {{3, "c"}, {1, "a"}, {2, "b"}, {5, "e"}, {4, "d"}};
+    pdq_sort(v.begin(), v.end(), std::less<>(), &Item::key);
+    REQUIRE(std::ranges::is_sorted(v, {}, &Item::key));
+    REQUIRE(v.front().name == "a");
+    REQUIRE(v.back().name == "e");
+}
+
+TEST_CASE("pdq_sort - 射影で絶対値順") {
+    std::mt19937 engine(7);
+    std::vector<int> v(1000);
+    std::ranges::generate(v, [&] { return static_cast<int>(engine() % 2001) - 1000; });
+    auto abs = [](int n) { return n < 0 ? -n : n; };
+    pdq_sort(v.begin(), v.end(), std::greater<>(), abs);
+    REQUIRE(std::ranges::is_sorted(v, std::greater<>(), abs));
+}
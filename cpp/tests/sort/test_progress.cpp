@@ -0,0 +1,169 @@
+﻿#include "sort/progress.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "sort/bubble_sort.hpp"
+#include "sort/odd_even_sort.hpp"
+#include "sort/selection_sort.hpp"
+#include "sort/shaker_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+using namespace std::chrono_literals;
+
+TEST_CASE("ProgressCounter - 書き込んだ値を読み出す") {
+    ProgressCounter counter;
+    REQUIRE(counter.updates() == 0);
+    REQUIRE(counter.load() == ProgressSnapshot{});
+
+    counter.publish({3, 10, 2, 8, 42});
+    REQUIRE(counter.updates() == 1);
+    REQUIRE(counter.load() == ProgressSnapshot{3, 10, 2, 8, 42});
+}
+
+TEST_CASE("ProgressCounter - 書き込み中の値が混ざらない") {
+    // すべての値が同じになるように書き続け、別スレッドで読んだ値が揃っていることを確かめる
+    ProgressCounter counter;
+    std::atomic<bool> stop = false;
+    std::jthread writer([&] {
+        for (size_t i = 1; !stop.load(std::memory_order_relaxed); ++i) {
+            counter.publish({i, i, i, i, i});
+        }
+    });
+    for (int i = 0; i < 10'000; ++i) {
+        const auto s = counter.load();
+        REQUIRE((s.max_passes == s.pass && s.range_begin == s.pass && s.range_end == s.pass &&
+                 s.comparisons == s.pass));
+    }
+    stop = true;
+}
+
+TEST_CASE("active_progress - bubble_sort はパスごとに進み具合を書き込む") {
+    auto v = Workload::generate<int>(200);
+    ProgressCounter counter;
+    size_t loop_count = 0;
+    {
+        ScopedProgress scope(counter);
+        REQUIRE(active_progress() == &counter);
+        loop_count = bubble_sort(v.begin(), v.end());
+    }
+    REQUIRE(active_progress() == nullptr);
+    REQUIRE(std::ranges::is_sorted(v));
+    REQUIRE(counter.updates() == 199);
+    REQUIRE(counter.load() == ProgressSnapshot{199, 199, 0, 0, loop_count});
+}
+
+TEST_CASE("active_progress - 未確定の範囲が縮んでいく") {
+    std::vector<int> v(100);
+    std::iota(v.rbegin(), v.rend(), 0);
+    ProgressCounter counter;
+    ScopedProgress scope(counter);
+
+    ShakerSortPasses passes(v.begin(), v.end());
+    passes.run_pass();
+    REQUIRE(passes.range() == std::pair<size_t, size_t>{1, 99});
+    run_passes(passes);
+    REQUIRE(std::ranges::is_sorted(v));
+    const auto last = counter.load();
+    REQUIRE(last.pass == passes.pass_count());
+    REQUIRE(last.range_begin == last.range_end);
+    REQUIRE(last.comparisons == passes.loop_count());
+
+    auto w = Workload::generate<int>(50);
+    SelectionSortPasses selection(w.begin(), w.end());
+    selection.run_pass();
+    REQUIRE(selection.range() == std::pair<size_t, size_t>{1, 50});
+}
+
+TEST_CASE("active_progress - 入れ子にすると内側が優先され、抜けると元に戻る") {
+    ProgressCounter outer;
+    ProgressCounter inner;
+    ScopedProgress outer_scope(outer);
+    {
+        ScopedProgress inner_scope(inner);
+        auto v = Workload::generate<int>(50);
+        selection_sort(v.begin(), v.end());
+    }
+    REQUIRE(active_progress() == &outer);
+    REQUIRE(inner.updates() == 49);
+    REQUIRE(outer.updates() == 0);
+
+    auto v = Workload::generate<int>(50);
+    const auto count = double_selection_sort(v.begin(), v.end());
+    REQUIRE(outer.updates() == 25);
+    REQUIRE(outer.load().comparisons == count);
+}
+
+TEST_CASE("active_progress - 適応型と奇偶転置ソートも書き込む") {
+    ProgressCounter counter;
+    ScopedProgress scope(counter);
+
+    auto v = Workload::generate<int>(300, {.distribution = Workload::Distribution::NearlySorted});
+    const auto bubble = adaptive_bubble_sort(v.begin(), v.end());
+    REQUIRE(counter.updates() == bubble.passCount);
+    REQUIRE(counter.load().comparisons == bubble.loopCount);
+
+    v = Workload::generate<int>(300);
+    const auto before = counter.updates();
+    const auto shaker = adaptive_shaker_sort(v.begin(), v.end());
+    REQUIRE(counter.updates() - before == shaker.passCount);
+    REQUIRE(counter.load().comparisons == shaker.loopCount);
+
+    v = Workload::generate<int>(300);
+    const auto serial = odd_even_sort(v.begin(), v.end());
+    REQUIRE(counter.load().comparisons == serial);
+    v = Workload::generate<int>(300);
+    const auto parallel =
+        parallel_odd_even_sort(v.begin(), v.end(), {.thread_count = 3, .min_elements_per_thread = 16});
+    REQUIRE(parallel == serial);
+    REQUIRE(counter.load() == ProgressSnapshot{counter.load().pass, 300, 0, 0, parallel});
+}
+
+TEST_CASE("ProgressSampler - 更新があったときだけ一定間隔で呼ぶ") {
+    ProgressCounter counter;
+    std::atomic<size_t> calls = 0;
+    std::atomic<size_t> last_pass = 0;
+    {
+        ProgressSampler sampler(counter, 1ms, [&](const ProgressSnapshot& s) {
+            last_pass = s.pass;
+            ++calls;
+        });
+        std::this_thread::sleep_for(20ms);
+        REQUIRE(calls == 0);
+
+        counter.publish({7, 10, 0, 10, 100});
+        for (int i = 0; i < 2'000 && calls == 0; ++i) {
+            std::this_thread::sleep_for(1ms);
+        }
+        REQUIRE(calls == 1);
+        REQUIRE(last_pass == 7);
+    }
+    // 破棄した後は呼ばれない
+    counter.publish({8, 10, 0, 10, 100});
+    std::this_thread::sleep_for(10ms);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("ProgressSampler - 長い間隔でも破棄するとすぐに止まる") {
+    ProgressCounter counter;
+    const auto start = std::chrono::steady_clock::now();
+    {
+        ProgressSampler sampler(counter, 1h, [](const ProgressSnapshot&) {});
+    }
+    REQUIRE(std::chrono::steady_clock::now() - start < 10s);
+}
+
+TEST_CASE("active_progress - 設定されていなければ定数評価のソートにも影響しない") {
+    constexpr auto result = bubble_sort(std::array{3, 1, 2});
+    STATIC_REQUIRE(std::get<0>(result) == std::array{1, 2, 3});
+    ProgressCounter counter;
+    ScopedProgress scope(counter);
+    auto [sorted, count] = selection_sort(std::array{3, 1, 2});
+    REQUIRE(sorted == std::array{1, 2, 3});
+    REQUIRE(counter.load().comparisons == count);
+}
@@ -0,0 +1,132 @@
+﻿#include "sort/radix_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Sort;
+
+namespace {
+// Workload::generate は負の値や指定した範囲の浮動小数点数を作れないので、範囲つきの一様乱数はここで作る
+template <typename T>
+std::vector<T> random_values(size_t size, T min_value, T max_value, unsigned seed) {
+    std::mt19937_64 engine(seed);
+    std::vector<T> v(size);
+    if constexpr (std::floating_point<T>) {
+        std::uniform_real_distribution<T> dist(min_value, max_value);
+        std::ranges::generate(v, [&] { return dist(engine); });
+    } else {
+        std::uniform_int_distribution<T> dist(min_value, max_value);
+        std::ranges::generate(v, [&] { return dist(engine); });
+    }
+    return v;
+}
+
+template <typename T>
+void require_sorted_like_std_sort(std::vector<T> v) {
+    auto expected = v;
+    std::ranges::sort(expected);
+    auto msd = v;
+
+    std::vector<T> scratch(v.size());
+    radix_sort(v.begin(), v.end(), scratch.begin());
+    REQUIRE(v == expected);
+
+    msd_radix_sort(msd.begin(), msd.end());
+    REQUIRE(msd == expected);
+}
+}  // namespace
+
+TEST_CASE("radix_sort - 昇順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    std::vector<int> scratch(v.size());
+    auto loop_count = radix_sort(v.begin(), v.end(), scratch.begin());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("radix_sort - 要素数 0") {
+    std::vector<int> empty;
+    auto loop_count = radix_sort(empty.begin(), empty.end(), empty.begin());
+    REQUIRE(empty.empty());
+    REQUIRE(loop_count == 0);
+}
+
+TEST_CASE("radix_sort - 要素数 1") {
+    std::vector single = {42};
+    std::vector<int> scratch(1);
+    auto loop_count = radix_sort(single.begin(), single.end(), scratch.begin());
+    REQUIRE(single == std::vector{42});
+    REQUIRE(loop_count == 0);
+}
+
+TEST_CASE("radix_sort - 符号なし整数") {
+    require_sorted_like_std_sort(random_values<uint32_t>(100'000, 0, std::numeric_limits<uint32_t>::max(), 1));
+    require_sorted_like_std_sort(random_values<uint64_t>(100'000, 0, std::numeric_limits<uint64_t>::max(), 2));
+    auto bytes = random_values<uint16_t>(1'000, 0, 255, 3);
+    require_sorted_like_std_sort(std::vector<uint8_t>(bytes.begin(), bytes.end()));
+}
+
+TEST_CASE("radix_sort - 符号付き整数") {
+    require_sorted_like_std_sort(random_values<int32_t>(100'000, std::numeric_limits<int32_t>::min(),
+                                                        std::numeric_limits<int32_t>::max(), 4));
+    require_sorted_like_std_sort(random_values<int64_t>(100'000, -1'000, 1'000, 5));
+    require_sorted_like_std_sort(random_values<int16_t>(10'000, -300, 300, 6));
+}
+
+TEST_CASE("radix_sort - 浮動小数点数") {
+    require_sorted_like_std_sort(random_values<float>(100'000, -1e6F, 1e6F, 7));
+    require_sorted_like_std_sort(random_values<double>(100'000, -1e300, 1e300, 8));
+    require_sorted_like_std_sort(std::vector<double>{3.14, -0.5, 2.71, 1.41, -1e-300, 1.73,
+                                                     std::numeric_limits<double>::infinity(),
+                                                     -std::numeric_limits<double>::infinity()});
+}
+
+TEST_CASE("radix_sort - 全要素が同じ桁は振り分けを省略する") {
+    // 上位 3 バイトがすべて 0 なので、振り分けは最下位バイトの 1 回だけになる
+    auto v = random_values<uint32_t>(10'000, 0, 255, 9);
+    std::vector<uint32_t> scratch(v.size());
+    auto loop_count = radix_sort(v.begin(), v.end(), scratch.begin());
+    REQUIRE(std::ranges::is_sorted(v));
+    // ヒストグラム 1 回 + 振り分け 1 回 + 作業領域からの書き戻し 1 回
+    REQUIRE(loop_count == 3 * v.size());
+}
+
+TEST_CASE("radix_sort - 射影") {
+    struct Record {
+        std::string name;
+        int64_t timestamp;
+    };
+    std::vector<Record> records = {{"c", 30}, {"a", -10}, {"b", 20}, {"d", 20}};
+    std::vector<Record> scratch(records.size());
+    radix_sort(records.begin(), records.end(), scratch.begin(), &Record::timestamp);
+
+    std::vector<std::string> names;
+    for (const auto& r : records) {
+        names.push_back(r.name);
+    }
+    // LSD 基数ソートは安定なので、同じキーの b と d は元の順序のまま
+    REQUIRE(names == std::vector<std::string>{"a", "b", "d", "c"});
+}
+
+TEST_CASE("radix_sort - 降順は射影で表す") {
+    std::vector v = {5, 3, 1, 4, 2};
+    msd_radix_sort(v.begin(), v.end(), [](int n) { return -n; });
+    REQUIRE(v == std::vector{5, 4, 3, 2, 1});
+}
+
+TEST_CASE("radix_sort - コンパイル時ソート") {
+    constexpr auto result = radix_sort(std::array{5, 3, 1, 4, 2});
+    REQUIRE(std::get<0>(result) == std::array{1, 2, 3, 4, 5});
+    REQUIRE(std::get<1>(result) > 0);
+}
+
+TEST_CASE("radix_sort - 空配列") {
+    constexpr auto result = radix_sort(std::array<int, 0>{});
+    REQUIRE(std::get<0>(result) == std::array<int, 0>{});
+    REQUIRE(std::get<1>(result) == 0);
+}
@@ -0,0 +1,76 @@
+﻿#include "sort/schwartzian_sort.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Sort;
+
+namespace {
+
+struct Record {
+    int key;
+    std::string payload;
+};
+
+}  // namespace
+
+TEST_CASE("schwartzian_sort - 昇順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    auto loop_count = schwartzian_sort(v.begin(), v.end());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("schwartzian_sort - 降順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    schwartzian_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(v == std::vector{5, 4, 3, 2, 1});
+}
+
+TEST_CASE("schwartzian_sort - 要素数 0 と 1") {
+    std::vector<int> empty;
+    REQUIRE(schwartzian_sort(empty.begin(), empty.end()) == 0);
+    std::vector single = {42};
+    REQUIRE(schwartzian_sort(single.begin(), single.end()) == 0);
+    REQUIRE(single == std::vector{42});
+}
+
+TEST_CASE("schwartzian_sort - キーの計算は要素ごとに 1 回") {
+    std::mt19937 engine(12345);
+    std::vector<Record> v(5000);
+    for (auto& record : v) {
+        record.key = static_cast<int>(engine() % 1000);
+        record.payload = std::to_string(record.key);
+    }
+    size_t calls = 0;
+    schwartzian_sort(v.begin(), v.end(), std::less<>(), [&](const Record& record) {
+        ++calls;
+        return record.key;
+    });
+    REQUIRE(calls == v.size());
+    REQUIRE(std::ranges::is_sorted(v, {}, &Record::key));
+    // 並べ替えでキーと中身の対応が崩れていない
+    REQUIRE(std::ranges::all_of(v, [](const Record& r) { return r.payload == std::to_string(r.key); }));
+}
+
+TEST_CASE("schwartzian_sort - 文字列キー") {
+    std::vector<std::string> v = {"pear", "apple", "fig", "banana", "kiwi"};
+    schwartzian_sort(v.begin(), v.end(), std::less<>(), [](const std::string& s) { return s.size(); });
+    REQUIRE(std::ranges::is_sorted(v, {}, &std::string::size));
+    REQUIRE(v.front() == "fig");
+    REQUIRE(v.back() == "banana");
+}
+
+TEST_CASE("schwartzian_sort - std::sort と同じ結果") {
+    std::mt19937 engine(42);
+    for (auto size : {2, 3, 10, 100, 1000, 10000}) {
+        std::vector<int> v(static_cast<size_t>(size));
+        std::ranges::generate(v, [&] { return static_cast<int>(engine() % 100); });
+        auto expected = v;
+        std::ranges::sort(expected);
+        schwartzian_sort(v.begin(), v.end());
+        REQUIRE(v == expected);
+    }
+}
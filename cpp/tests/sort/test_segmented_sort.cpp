@@ -0,0 +1,146 @@
+﻿#include "sort/segmented_sort.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "concurrency/work_stealing_pool.hpp"
+
+using namespace AlgorithmSamples::Sort;
+using AlgorithmSamples::Concurrency::WorkStealingPool;
+
+namespace {
+// 長さ 0 から max_size までのセグメントをランダムに並べた offsets
+std::vector<uint32_t> random_offsets(size_t segment_count, uint32_t max_size, std::mt19937& engine) {
+    std::vector<uint32_t> offsets = {0};
+    for (size_t i = 0; i < segment_count; ++i) {
+        // 同じ長さが続く部分も作る
+        const auto size = engine() % 3 == 0 && offsets.size() > 1 ? offsets.back() - offsets[offsets.size() - 2]
+                                                                  : engine() % (max_size + 1);
+        offsets.push_back(offsets.back() + size);
+    }
+    return offsets;
+}
+
+template <typename T, typename Comparator = std::less<>>
+bool segments_sorted(const std::vector<T>& data, const std::vector<uint32_t>& offsets, Comparator comparator = {}) {
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        if (!std::is_sorted(data.begin() + offsets[i], data.begin() + offsets[i + 1], comparator)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// セグメントごとに要素の集合が変わっていないこと
+template <typename T>
+bool same_segments(std::vector<T> a, std::vector<T> b, const std::vector<uint32_t>& offsets) {
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        std::sort(a.begin() + offsets[i], a.begin() + offsets[i + 1]);
+        std::sort(b.begin() + offsets[i], b.begin() + offsets[i + 1]);
+    }
+    return a == b;
+}
+}  // namespace
+
+TEST_CASE("segmented_sort - 昇順") {
+    std::vector data = {3, 1, 2, 9, 5, 4, 8, 7, 6, 0};
+    std::vector<uint32_t> offsets = {0, 3, 3, 4, 10};
+    auto loop_count = segmented_sort(std::span(data), std::span(offsets));
+    REQUIRE(data == std::vector{1, 2, 3, 9, 0, 4, 5, 6, 7, 8});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("segmented_sort - 小さいセグメントと大きいセグメントの混在") {
+    std::mt19937 engine(42);
+    for (uint32_t max_size : {4U, 16U, 40U, 300U}) {
+        const auto offsets = random_offsets(2'000, max_size, engine);
+        std::vector<int32_t> data(offsets.back());
+        std::ranges::generate(data, [&] { return static_cast<int32_t>(engine() % 1'000); });
+        const auto input = data;
+
+        segmented_sort(std::span(data), std::span<const uint32_t>(offsets));
+        REQUIRE(segments_sorted(data, offsets));
+        REQUIRE(same_segments(data, input, offsets));
+
+        data = input;
+        segmented_sort(std::span(data), std::span<const uint32_t>(offsets), std::greater<>());
+        REQUIRE(segments_sorted(data, offsets, std::greater<>()));
+    }
+}
+
+TEST_CASE("segmented_sort - NaN と ±0 を含む float の短いセグメントも要素を失わない") {
+    // 同じ長さのセグメントが続くと、ソーティングネットワークの SIMD 版でまとめてソートする
+    constexpr float SPECIAL[] = {std::numeric_limits<float>::quiet_NaN(), -0.0f, 0.0f, 1.0f, -1.0f};
+    std::vector<uint32_t> offsets = {0};
+    for (uint32_t size : {8U, 8U, 8U, 8U, 8U, 8U, 8U, 8U, 16U, 16U, 16U, 16U, 64U, 64U, 64U, 64U}) {
+        offsets.push_back(offsets.back() + size);
+    }
+    std::vector<uint32_t> input(offsets.back());
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::bit_cast<uint32_t>(SPECIAL[(i * 7 + i / 8) % std::size(SPECIAL)]);
+    }
+    for (const bool descending : {false, true}) {
+        std::vector<float> data(input.size());
+        std::ranges::transform(input, data.begin(), [](uint32_t bits) { return std::bit_cast<float>(bits); });
+        if (descending) {
+            segmented_sort(std::span(data), std::span<const uint32_t>(offsets), std::greater<>());
+        } else {
+            segmented_sort(std::span(data), std::span<const uint32_t>(offsets));
+        }
+        std::vector<uint32_t> output(data.size());
+        std::ranges::transform(data, output.begin(), [](float value) { return std::bit_cast<uint32_t>(value); });
+        REQUIRE(same_segments(output, input, offsets));
+    }
+}
+
+TEST_CASE("segmented_sort - 射影・文字列") {
+    std::vector<std::string> data = {"ccc", "a", "bb", "dddd", "e", "ff"};
+    std::vector<uint32_t> offsets = {0, 3, 6};
+    segmented_sort(std::span(data), std::span(offsets), std::less<>(), &std::string::size);
+    REQUIRE(data == std::vector<std::string>{"a", "bb", "ccc", "e", "ff", "dddd"});
+}
+
+TEST_CASE("segmented_sort - offsets で覆われない要素は動かさない") {
+    std::vector data = {2, 1, 4, 3, 6, 5};
+    std::vector<int> offsets = {2, 4};
+    segmented_sort(std::span(data), std::span(offsets));
+    REQUIRE(data == std::vector{2, 1, 3, 4, 6, 5});
+}
+
+TEST_CASE("segmented_sort - 不正な offsets") {
+    std::vector data = {1, 2, 3};
+    std::vector<int> decreasing = {0, 2, 1};
+    std::vector<int> too_large = {0, 4};
+    std::vector<int> negative = {-1, 2};
+    REQUIRE_THROWS_AS(segmented_sort(std::span(data), std::span(decreasing)), std::invalid_argument);
+    REQUIRE_THROWS_AS(segmented_sort(std::span(data), std::span(too_large)), std::invalid_argument);
+    REQUIRE_THROWS_AS(segmented_sort(std::span(data), std::span(negative)), std::invalid_argument);
+}
+
+TEST_CASE("segmented_sort - スレッドプール") {
+    WorkStealingPool pool(4);
+    std::mt19937 engine(7);
+    auto offsets = random_offsets(5'000, 64, engine);
+    // 1 つだけ巨大なセグメント
+    const auto large = static_cast<uint32_t>(100'000);
+    offsets.push_back(offsets.back() + large);
+    for (uint32_t i = 0; i < 1'000; ++i) {
+        offsets.push_back(offsets.back() + engine() % 8);
+    }
+    std::vector<int32_t> data(offsets.back());
+    std::ranges::generate(data, [&] { return static_cast<int32_t>(engine()); });
+    const auto input = data;
+
+    auto expected = input;
+    const auto sequential_count = segmented_sort(std::span(expected), std::span(offsets));
+    segmented_sort(std::span(data), std::span(offsets), std::less<>(), std::identity(), pool);
+    REQUIRE(data == expected);
+    REQUIRE(sequential_count > 0);
+}
@@ -1,9 +1,52 @@
 #include "sort/selection_sort.hpp"
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
+#include "workload/workload.hpp"
 
 using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+namespace {
+
+// 分岐なし・SIMD の走査 (std::less<> / std::greater<>) と汎用の走査 (ラムダの比較関数) で、
+// レーン幅の倍数でない要素数や重複の多い入力も含めて同じ結果・同じ比較回数になることを確かめる
+template <typename T, typename Sort>
+void check_fast_scan(Sort sort, size_t expected_per_size(size_t)) {
+    for (size_t size : {0, 1, 2, 7, 8, 9, 31, 33, 100, 257}) {
+        for (auto distribution : {Workload::Distribution::Random, Workload::Distribution::FewUnique,
+                                  Workload::Distribution::Reversed, Workload::Distribution::AllEqual}) {
+            const auto input = Workload::generate<T>(size, {.distribution = distribution});
+            auto ascending = input;
+            REQUIRE(sort(ascending, std::less<>()) == expected_per_size(size));
+            auto generic = input;
+            REQUIRE(sort(generic, [](T a, T b) { return a < b; }) == expected_per_size(size));
+            REQUIRE(std::ranges::is_sorted(ascending));
+            REQUIRE(ascending == generic);
+
+            auto descending = input;
+            REQUIRE(sort(descending, std::greater<>()) == expected_per_size(size));
+            REQUIRE(std::ranges::is_sorted(descending, std::greater<>()));
+        }
+    }
+}
+
+size_t selection_comparisons(size_t size) { return size < 2 ? 0 : size * (size - 1) / 2; }
+
+// 未確定の要素数が 2 以上の間、両端を 1 つずつ確定させる
+size_t double_selection_comparisons(size_t size) {
+    size_t count = 0;
+    for (; size >= 2; size -= 2) {
+        count += 2 * (size - 1);
+    }
+    return count;
+}
+
+}  // namespace
 
 TEST_CASE("selection_sort - 昇順") {
     std::vector v = {5, 3, 1, 4, 2};
@@ -96,3 +139,84 @@ TEST_CASE("selection_sort - 浮動小数点数") {
     selection_sort(floats.begin(), floats.end());
     REQUIRE(floats == std::vector<double>{1.41, 1.73, 2.71, 3.14});
 }
+
+TEST_CASE("selection_sort - 射影でメンバをキーにする") {
+    struct Item {
+        int key;
+        char tag;
+    };
+    std::vector<Item> v = {{3, 'c'}, {1, 'a'}, {2, 'b'}};
+    selection_sort(v.begin(), v.end(), std::less<>(), &Item::key);
+    REQUIRE(v[0].tag == 'a');
+    REQUIRE(v[1].tag == 'b');
+    REQUIRE(v[2].tag == 'c');
+}
+
+TEST_CASE("selection_sort - 算術型の高速な走査") {
+    auto sort = [](auto& v, auto comparator) { return selection_sort(v.begin(), v.end(), comparator); };
+    check_fast_scan<int32_t>(sort, selection_comparisons);
+    check_fast_scan<float>(sort, selection_comparisons);
+    check_fast_scan<int64_t>(sort, selection_comparisons);
+    check_fast_scan<uint8_t>(sort, selection_comparisons);
+    check_fast_scan<double>(sort, selection_comparisons);
+}
+
+TEST_CASE("double_selection_sort - 昇順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    auto loop_count = double_selection_sort(v.begin(), v.end());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count == 12);
+}
+
+TEST_CASE("double_selection_sort - 降順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    double_selection_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(v == std::vector{5, 4, 3, 2, 1});
+}
+
+TEST_CASE("double_selection_sort - 最大の要素が先頭にある") {
+    // 最小の要素を先頭に移す交換で最大の要素が動くので、動いた先を末尾に置く
+    std::vector v = {9, 1, 5, 3, 7};
+    double_selection_sort(v.begin(), v.end());
+    REQUIRE(v == std::vector{1, 3, 5, 7, 9});
+
+    std::vector two = {2, 1};
+    REQUIRE(double_selection_sort(two.begin(), two.end()) == 2);
+    REQUIRE(two == std::vector{1, 2});
+}
+
+TEST_CASE("double_selection_sort - 要素数 0 / 1") {
+    std::vector<int> empty;
+    REQUIRE(double_selection_sort(empty.begin(), empty.end()) == 0);
+    std::vector single = {42};
+    REQUIRE(double_selection_sort(single.begin(), single.end()) == 0);
+    REQUIRE(single == std::vector{42});
+}
+
+TEST_CASE("double_selection_sort - 算術型の高速な走査") {
+    auto sort = [](auto& v, auto comparator) { return double_selection_sort(v.begin(), v.end(), comparator); };
+    check_fast_scan<int32_t>(sort, double_selection_comparisons);
+    check_fast_scan<float>(sort, double_selection_comparisons);
+    check_fast_scan<int64_t>(sort, double_selection_comparisons);
+    check_fast_scan<double>(sort, double_selection_comparisons);
+}
+
+TEST_CASE("double_selection_sort - 文字列と射影") {
+    std::vector<std::string> strings = {"banana", "apple", "cherry", "date", "apple"};
+    double_selection_sort(strings.begin(), strings.end());
+    REQUIRE(strings == std::vector<std::string>{"apple", "apple", "banana", "cherry", "date"});
+
+    struct Item {
+        int key;
+        char tag;
+    };
+    std::vector<Item> v = {{3, 'c'}, {1, 'a'}, {4, 'd'}, {2, 'b'}};
+    double_selection_sort(v.begin(), v.end(), std::greater<>(), &Item::key);
+    REQUIRE(std::string{v[0].tag, v[1].tag, v[2].tag, v[3].tag} == "dcba");
+}
+
+TEST_CASE("double_selection_sort - コンパイル時ソート") {
+    constexpr auto result = double_selection_sort(std::array{3, 1, 4, 1, 5, 9, 2, 6});
+    REQUIRE(std::get<0>(result) == std::array{1, 1, 2, 3, 4, 5, 6, 9});
+    REQUIRE(std::get<1>(result) == double_selection_comparisons(8));
+}
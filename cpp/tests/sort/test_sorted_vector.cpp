@@ -0,0 +1,91 @@
+﻿#include "sort/sorted_vector.hpp"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Sort;
+
+TEST_CASE("SortedVector - 挿入は次の読み出しでマージされる") {
+    SortedVector<int> set;
+    set.insert(5);
+    set.insert(1);
+    set.insert(3);
+    REQUIRE(set.size() == 3);
+    REQUIRE(set.pending_size() == 3);
+    REQUIRE(std::vector(set.begin(), set.end()) == std::vector{1, 3, 5});
+    REQUIRE(set.pending_size() == 0);
+
+    set.insert(4);
+    set.insert(0);
+    set.insert(6);
+    REQUIRE(set.front() == 0);
+    REQUIRE(std::vector(set.begin(), set.end()) == std::vector{0, 1, 3, 4, 5, 6});
+}
+
+TEST_CASE("SortedVector - 降順・射影") {
+    SortedVector<std::pair<int, std::string>, std::greater<>, decltype(&std::pair<int, std::string>::first)> set(
+        std::greater<>(), &std::pair<int, std::string>::first);
+    set.insert({1, "a"});
+    set.insert({3, "b"});
+    set.flush();
+    set.insert({2, "c"});
+    set.insert({4, "d"});
+    REQUIRE(set[0].second == "d");
+    REQUIRE(set[1].second == "b");
+    REQUIRE(set[2].second == "c");
+    REQUIRE(set.lower_bound(2)->second == "c");
+    REQUIRE(set.contains(3));
+    REQUIRE_FALSE(set.contains(5));
+}
+
+TEST_CASE("SortedVector - 等しい要素は挿入順に並ぶ") {
+    using Item = std::pair<int, int>;
+    SortedVector<Item, std::less<>, decltype(&Item::first)> set({}, &Item::first);
+    int order = 0;
+    std::mt19937 engine(1);
+    for (int batch = 0; batch < 50; ++batch) {
+        for (int i = 0; i < 20; ++i) {
+            set.insert({static_cast<int>(engine() % 10), order++});
+        }
+        set.flush();
+    }
+    auto items = set.extract();
+    REQUIRE(items.size() == 1'000);
+    REQUIRE(set.empty());
+    REQUIRE(std::ranges::is_sorted(items));
+}
+
+TEST_CASE("SortedVector - ランダムな挿入と読み出しが毎回全体をソートした結果と一致する") {
+    std::mt19937 engine(42);
+    SortedVector<int> set;
+    std::vector<int> reference;
+    for (int batch = 0; batch < 200; ++batch) {
+        const auto count = engine() % 64;
+        for (size_t i = 0; i < count; ++i) {
+            // 末尾寄りの値と全体に散らばる値を混ぜる
+            const int value = engine() % 4 == 0 ? static_cast<int>(engine() % 1'000) : 1'000 + batch * 10 +
+                                                                                             static_cast<int>(engine() % 20);
+            set.insert(value);
+            reference.push_back(value);
+        }
+        std::ranges::sort(reference);
+        REQUIRE(std::ranges::equal(set, reference));
+        REQUIRE(set.count(reference[reference.size() / 2]) ==
+                static_cast<size_t>(std::ranges::count(reference, reference[reference.size() / 2])));
+    }
+}
+
+TEST_CASE("SortedVector - 削除") {
+    std::vector input = {3, 1, 2, 3, 5, 3};
+    SortedVector<int> set(input.begin(), input.end());
+    REQUIRE(set.erase_key(3) == 3);
+    REQUIRE(std::vector(set.begin(), set.end()) == std::vector{1, 2, 5});
+    set.erase(set.begin());
+    REQUIRE(std::vector(set.begin(), set.end()) == std::vector{2, 5});
+    set.clear();
+    REQUIRE(set.empty());
+}
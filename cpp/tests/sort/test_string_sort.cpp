@@ -0,0 +1,103 @@
+﻿#include "sort/string_sort.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Sort;
+using namespace std::string_literals;
+
+namespace {
+
+// 共通の接頭辞を多く持つ URL 風の文字列。0 や 0x80 以上のバイトを混ぜるので Workload::generate は使わない
+std::vector<std::string> random_strings(size_t size, unsigned seed) {
+    static const std::vector<std::string> prefixes = {"", "a", "https://example.com/", "https://example.com/items/",
+                                                      "https://example.org/"};
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<size_t> prefix(0, prefixes.size() - 1);
+    std::uniform_int_distribution<size_t> length(0, 20);
+    std::uniform_int_distribution<int> letter(0, 255);
+    std::vector<std::string> v(size);
+    for (auto& s : v) {
+        s = prefixes[prefix(engine)];
+        const auto n = length(engine);
+        for (size_t i = 0; i < n; ++i) {
+            // 狭い文字種にして重複と長い共通接頭辞を作る。ときどき 0 や 0x80 以上のバイトを混ぜる
+            const auto c = letter(engine);
+            s.push_back(c < 8 ? static_cast<char>(c * 32) : static_cast<char>('a' + c % 3));
+        }
+    }
+    return v;
+}
+
+}  // namespace
+
+TEST_CASE("string_sort - 昇順") {
+    std::vector<std::string> v = {"banana", "apple", "cherry", "apple pie", "app"};
+    auto loop_count = string_sort(v.begin(), v.end());
+    REQUIRE(v == std::vector<std::string>{"app", "apple", "apple pie", "banana", "cherry"});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("string_sort - 降順") {
+    std::vector<std::string> v = {"banana", "apple", "cherry", "apple pie", "app"};
+    string_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(v == std::vector<std::string>{"cherry", "banana", "apple pie", "apple", "app"});
+}
+
+TEST_CASE("string_sort - 要素数 0 と 1") {
+    std::vector<std::string> empty;
+    REQUIRE(string_sort(empty.begin(), empty.end()) == 0);
+    std::vector<std::string> single = {"x"};
+    REQUIRE(string_sort(single.begin(), single.end()) == 0);
+}
+
+TEST_CASE("string_sort - 0 バイトと長さだけが異なる文字列") {
+    std::vector<std::string> v = {"a\0\0"s, "a"s, ""s, "a\0"s, "\0"s, "a\0\0\0\0\0\0\0\0"s,
+                                  "a\0\0\0\0\0\0\0"s, "\xff"s};
+    auto expected = v;
+    std::ranges::sort(expected);
+    string_sort(v.begin(), v.end());
+    REQUIRE(v == expected);
+}
+
+TEST_CASE("string_sort - 8 バイトを超える共通接頭辞") {
+    std::vector<std::string> v;
+    for (int i = 0; i < 200; ++i) {
+        v.push_back("common/prefix/longer/than/eight/" + std::to_string((i * 37) % 200));
+    }
+    auto expected = v;
+    std::ranges::sort(expected);
+    string_sort(v.begin(), v.end());
+    REQUIRE(v == expected);
+}
+
+TEST_CASE("string_sort - std::sort と同じ結果") {
+    for (auto size : {17, 1000, 40000, 100000}) {
+        auto v = random_strings(static_cast<size_t>(size), static_cast<unsigned>(size));
+        auto expected = v;
+        std::ranges::sort(expected);
+        string_sort(v.begin(), v.end());
+        REQUIRE(v == expected);
+    }
+}
+
+TEST_CASE("string_sort - string_view と射影") {
+    struct Line {
+        std::string text;
+        int number;
+    };
+    std::vector<Line> lines = {{"delta", 4}, {"alpha", 1}, {"charlie", 3}, {"bravo", 2}};
+    string_sort(lines.begin(), lines.end(), std::less<>(), &Line::text);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        REQUIRE(lines[i].number == static_cast<int>(i) + 1);
+    }
+
+    const std::string corpus = "pear\napple\nfig\n";
+    std::vector<std::string_view> views = {std::string_view(corpus).substr(0, 4), std::string_view(corpus).substr(5, 5),
+                                           std::string_view(corpus).substr(11, 3)};
+    string_sort(views.begin(), views.end());
+    REQUIRE(views == std::vector<std::string_view>{"apple", "fig", "pear"});
+}
@@ -0,0 +1,140 @@
+﻿#include "sort/tim_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+using Workload::Record;
+
+namespace {
+constexpr auto by_key = [](const Record& a, const Record& b) { return a.key < b.key; };
+
+// Record の == は key しか見ないので、元の位置 (id) まで一致することを確かめる
+bool same_order(const std::vector<Record>& a, const std::vector<Record>& b) {
+    return std::ranges::equal(a, b, [](const Record& x, const Record& y) { return x.key == y.key && x.id == y.id; });
+}
+
+// 入力の並びごとに、std::stable_sort と同じ結果になることを確かめる
+void require_stable(std::vector<Record> records) {
+    auto expected = records;
+    std::ranges::stable_sort(expected, by_key);
+    tim_sort(records.begin(), records.end(), by_key);
+    REQUIRE(same_order(records, expected));
+}
+
+// キーが unique_values 種類のレコード。id は生成した位置
+std::vector<Record> make_records(size_t size, size_t unique_values, uint64_t seed) {
+    return Workload::generate<Record>(
+        size, {.distribution = Workload::Distribution::FewUnique, .seed = seed, .unique_values = unique_values});
+}
+}  // namespace
+
+TEST_CASE("tim_sort - 昇順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    auto loop_count = tim_sort(v.begin(), v.end());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+    REQUIRE(loop_count > 0);
+}
+
+TEST_CASE("tim_sort - 降順") {
+    std::vector v = {5, 3, 1, 4, 2};
+    tim_sort(v.begin(), v.end(), std::greater<>());
+    REQUIRE(v == std::vector{5, 4, 3, 2, 1});
+}
+
+TEST_CASE("tim_sort - 要素数 0 と 1") {
+    std::vector<int> empty;
+    REQUIRE(tim_sort(empty.begin(), empty.end()) == 0);
+    std::vector single = {42};
+    REQUIRE(tim_sort(single.begin(), single.end()) == 0);
+    REQUIRE(single == std::vector{42});
+}
+
+TEST_CASE("tim_sort - 等しいキーの順序を保つ") {
+    require_stable(make_records(50, 5, 1));
+    require_stable(make_records(1'000, 10, 2));
+    require_stable(make_records(100'000, 100, 3));
+    require_stable(make_records(100'000, 100'000, 4));
+}
+
+TEST_CASE("tim_sort - ランを含む入力") {
+    // 昇順・降順のランが交互に並ぶ入力や、ほぼ整列済みの入力はギャロップで一度に移動する
+    std::vector<Record> records;
+    for (int block = 0; block < 50; ++block) {
+        for (int i = 0; i < 1'000; ++i) {
+            const int key = block % 2 == 0 ? i : 1'000 - i;
+            records.push_back({key / 3, records.size()});
+        }
+    }
+    require_stable(records);
+
+    const Workload::Options nearly_sorted{.distribution = Workload::Distribution::NearlySorted, .seed = 5};
+    require_stable(Workload::generate<Record>(100'000, nearly_sorted));
+}
+
+TEST_CASE("tim_sort - 整列済み・逆順は線形時間") {
+    std::vector<int> v(100'000);
+    std::iota(v.begin(), v.end(), 0);
+    REQUIRE(tim_sort(v.begin(), v.end()) == v.size() - 1);
+    std::ranges::reverse(v);
+    REQUIRE(tim_sort(v.begin(), v.end()) == v.size() - 1);
+    REQUIRE(std::ranges::is_sorted(v));
+}
+
+TEST_CASE("tim_sort - 作業領域のサイズ") {
+    REQUIRE(tim_sort_scratch_size<int>(0) == 0);
+    REQUIRE(tim_sort_scratch_size<int>(63) == 0);
+    REQUIRE(tim_sort_scratch_size<int>(1'000) >= 500 * sizeof(int));
+    REQUIRE(tim_sort_scratch_size<double>(1'000) >= 500 * sizeof(double));
+}
+
+TEST_CASE("tim_sort - 作業領域は渡したリソースからだけ確保する") {
+    // 上流を null_memory_resource にすると、足りなければ std::bad_alloc になる
+    auto records = make_records(10'000, 50, 7);
+    std::vector<std::byte> arena(tim_sort_scratch_size<Record>(records.size()));
+    auto expected = records;
+    std::ranges::stable_sort(expected, by_key);
+
+    for (int round = 0; round < 3; ++round) {
+        auto v = records;
+        std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+        tim_sort(v.begin(), v.end(), std::less<>(), &Record::key, &resource);
+        REQUIRE(same_order(v, expected));
+    }
+
+    // 小さい入力は作業領域を使わない
+    std::vector small = {3, 1, 2};
+    tim_sort(small.begin(), small.end(), std::less<>(), std::identity(), std::pmr::null_memory_resource());
+    REQUIRE(small == std::vector{1, 2, 3});
+
+    std::vector<int> large(1'000, 0);
+    std::ranges::generate(large, [n = 0]() mutable { return (n++ * 7919) % 1'000; });
+    REQUIRE_THROWS_AS(
+        tim_sort(large.begin(), large.end(), std::less<>(), std::identity(), std::pmr::null_memory_resource()),
+        std::bad_alloc);
+}
+
+TEST_CASE("tim_sort - ムーブのみ可能な型") {
+    std::vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < 200; ++i) {
+        v.push_back(std::make_unique<int>((i * 37) % 200));
+    }
+    tim_sort(v.begin(), v.end(), [](const auto& a, const auto& b) { return *a < *b; });
+    REQUIRE(std::ranges::is_sorted(v, {}, [](const auto& p) { return *p; }));
+}
+
+TEST_CASE("tim_sort - 文字列ソート") {
+    std::vector<std::string> strings = {"banana", "apple", "cherry", "date"};
+    tim_sort(strings.begin(), strings.end());
+    REQUIRE(strings == std::vector<std::string>{"apple", "banana", "cherry", "date"});
+}
@@ -0,0 +1,82 @@
+﻿#include "sort/top_k.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+TEST_CASE("top_k_sort - 小さい順に k 個") {
+    std::vector v = {5, 3, 1, 4, 2};
+    top_k_sort(v.begin(), v.begin() + 3, v.end());
+    REQUIRE(std::vector(v.begin(), v.begin() + 3) == std::vector{1, 2, 3});
+}
+
+TEST_CASE("top_k_sort - k = 0 と k = n") {
+    std::vector v = {5, 3, 1, 4, 2};
+    REQUIRE(top_k_sort(v.begin(), v.begin(), v.end()) == 0);
+    REQUIRE(v == std::vector{5, 3, 1, 4, 2});
+    top_k_sort(v.begin(), v.end(), v.end());
+    REQUIRE(v == std::vector{1, 2, 3, 4, 5});
+}
+
+TEST_CASE("top_k_sort - ヒープと intro_select の両方の経路") {
+    const auto input = Workload::generate<int>(100000, {.distribution = Workload::Distribution::FewUnique,
+                                                        .seed = 11,
+                                                        .unique_values = 50000});
+    auto sorted = input;
+    std::ranges::sort(sorted);
+    // k = 100 はヒープ、k = 50000 は intro_select + pdq_sort で処理される
+    for (auto k : {1, 100, 1024, 1025, 50000, 99999}) {
+        auto v = input;
+        top_k_sort(v.begin(), v.begin() + k, v.end());
+        REQUIRE(std::equal(v.begin(), v.begin() + k, sorted.begin()));
+        auto rest = std::vector(v.begin() + k, v.end());
+        std::ranges::sort(rest);
+        REQUIRE(std::equal(rest.begin(), rest.end(), sorted.begin() + k));
+    }
+}
+
+TEST_CASE("top_k_sort - 小さな k はほぼ n 回の比較で済む") {
+    auto v = Workload::generate<int>(1000000, {.seed = 5});
+    auto loop_count = top_k_sort(v.begin(), v.begin() + 100, v.end());
+    REQUIRE(loop_count < 2 * v.size());
+}
+
+TEST_CASE("top_k_sort - 降順と射影") {
+    std::vector<std::string> v = {"pear", "apple", "fig", "banana", "kiwi", "plum", "cherry", "lime", "date"};
+    top_k_sort(v.begin(), v.begin() + 2, v.end(), std::greater<>(), &std::string::size);
+    REQUIRE(v[0].size() == 6);
+    REQUIRE(v[1].size() == 6);
+}
+
+TEST_CASE("top_k - 入力イテレータから 1 度の走査で求める") {
+    std::istringstream stream("9 4 7 1 8 2 6 3 5");
+    auto result = top_k(std::istream_iterator<int>(stream), std::istream_iterator<int>(), 3);
+    REQUIRE(result == std::vector{1, 2, 3});
+}
+
+TEST_CASE("top_k - 入力が k 個未満・k = 0") {
+    std::vector v = {3, 1, 2};
+    REQUIRE(top_k(v.begin(), v.end(), 5) == std::vector{1, 2, 3});
+    REQUIRE(top_k(v.begin(), v.end(), 0).empty());
+}
+
+TEST_CASE("TopK - 大きい順に保持") {
+    TopK<int, std::greater<>> top(100);
+    const auto input = Workload::generate<int>(100000, {.seed = 13});
+    for (auto n : input) {
+        top.push(n);
+    }
+    REQUIRE(top.size() == 100);
+    auto expected = input;
+    std::ranges::sort(expected, std::greater<>());
+    expected.resize(100);
+    REQUIRE(top.take() == expected);
+    REQUIRE(top.size() == 0);
+}
@@ -0,0 +1,98 @@
+﻿#include "sort/trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "sort/selection_sort.hpp"
+#include "workload/workload.hpp"
+
+using namespace AlgorithmSamples::Sort;
+namespace Workload = AlgorithmSamples::Workload;
+
+TEST_CASE("TraceRecorder - 区間とカウンタを記録する") {
+    TraceRecorder recorder;
+    const auto start = TraceRecorder::Clock::now();
+    recorder.add_span("sort", "demo", start, start + std::chrono::microseconds(1'500), {{"size", 10}});
+    recorder.add_counter("progress", start + std::chrono::milliseconds(1), {{"comparisons", 45}});
+
+    const auto events = recorder.events();
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].name == "sort");
+    REQUIRE(events[0].phase == 'X');
+    REQUIRE(events[0].duration_us == 1'500.0);
+    REQUIRE(events[0].args == TraceArgs{{"size", 10}});
+    REQUIRE(events[1].phase == 'C');
+    REQUIRE(events[1].timestamp_us - events[0].timestamp_us == 1'000.0);
+    REQUIRE(events[0].thread_id == events[1].thread_id);
+}
+
+TEST_CASE("TraceRecorder - Chrome の trace event 形式で書き出す") {
+    TraceRecorder recorder;
+    const auto start = TraceRecorder::Clock::now();
+    recorder.add_span("say \"hi\"\\\n", "demo", start, start, {{"a", 1}, {"b", 2}});
+    recorder.add_counter("progress", start, {{"comparisons", 3}});
+
+    std::ostringstream os;
+    recorder.write_json(os);
+    const auto json = os.str();
+    REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    REQUIRE(json.ends_with("]}\n"));
+    REQUIRE(json.find(R"("name":"say \"hi\"\\\n","cat":"demo","ph":"X",)") != std::string::npos);
+    REQUIRE(json.find(R"("dur":0.000,"pid":1,)") != std::string::npos);
+    REQUIRE(json.find(R"("args":{"a":1,"b":2}})") != std::string::npos);
+    REQUIRE(json.find(R"("name":"progress","cat":"","ph":"C",)") != std::string::npos);
+    REQUIRE(json.find(R"("args":{"comparisons":3}})") != std::string::npos);
+
+    std::ostringstream empty;
+    TraceRecorder().write_json(empty);
+    REQUIRE(empty.str() == "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n");
+}
+
+TEST_CASE("TraceRecorder - スレッドごとに別の tid を振る") {
+    TraceRecorder recorder;
+    const auto now = TraceRecorder::Clock::now();
+    recorder.add_span("main", "test", now, now);
+    std::jthread([&] { recorder.add_span("worker", "test", now, now); }).join();
+    const auto events = recorder.events();
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].thread_id != events[1].thread_id);
+}
+
+TEST_CASE("active_trace - パスごとの区間を TraceSpan の中に記録する") {
+    REQUIRE(active_trace() == nullptr);
+    TraceSpan ignored("記録先がなければ何もしない");
+
+    TraceRecorder recorder;
+    auto v = Workload::generate<int>(100);
+    size_t count = 0;
+    {
+        ScopedTrace scope(recorder);
+        TraceSpan span("selection_sort");
+        count = selection_sort(v.begin(), v.end());
+    }
+    REQUIRE(active_trace() == nullptr);
+    REQUIRE(std::ranges::is_sorted(v));
+
+    const auto events = recorder.events();
+    REQUIRE(events.size() == 100);
+    const auto& outer = events.back();
+    REQUIRE(outer.name == "selection_sort");
+    REQUIRE(std::string(outer.category) == "demo");
+    for (size_t i = 0; i + 1 < events.size(); ++i) {
+        const auto& pass = events[i];
+        REQUIRE(pass.name == "pass");
+        REQUIRE(pass.args[0] == std::pair<const char*, uint64_t>{"pass", i + 1});
+        // パスは前のパスの終わりから始まり、外側の区間に収まる
+        REQUIRE(pass.timestamp_us >= outer.timestamp_us - 0.01);
+        REQUIRE(pass.timestamp_us + pass.duration_us <= outer.timestamp_us + outer.duration_us + 0.01);
+        if (i > 0) {
+            const auto previous_end = events[i - 1].timestamp_us + events[i - 1].duration_us;
+            REQUIRE(std::abs(pass.timestamp_us - previous_end) < 0.01);
+        }
+    }
+    REQUIRE(events[events.size() - 2].args.back().second == count);
+}
@@ -0,0 +1,116 @@
+﻿#include "allocation_tracker.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace AlgorithmSamples::Benchmark;
+
+// Catch2 の REQUIRE も確保することがあるので、集計は区間を抜けてから確かめる
+
+TEST_CASE("AllocationSection - 区間の中の確保だけを数える") {
+    std::vector<int> before(100);
+    AllocationStats stats;
+    {
+        AllocationSection section;
+        std::vector<int> v(1'000);
+        before = std::vector<int>();
+        stats = section.stats();
+    }
+    REQUIRE(stats.allocations == 1);
+    REQUIRE(stats.allocated_bytes == 4'000);
+    REQUIRE(stats.largest_allocation == 4'000);
+    REQUIRE(stats.peak_bytes == 4'000);
+    // 区間の前に確保した領域の解放は回数にだけ数える
+    REQUIRE(stats.deallocations == 1);
+    REQUIRE(stats.size_histogram[12] == 1);  // 2049 〜 4096 バイト
+    REQUIRE(AllocationStats::size_class_limit(12) == 4'096);
+
+    AllocationSection empty;
+    REQUIRE(empty.stats().allocations == 0);
+    REQUIRE(empty.stats().peak_bytes == 0);
+}
+
+TEST_CASE("AllocationSection - 最大使用量は同時に確保していた量の最大値") {
+    AllocationStats stats;
+    {
+        AllocationSection section;
+        auto a = std::make_unique<char[]>(1'000);
+        a.reset();
+        auto b = std::make_unique<char[]>(2'000);
+        auto c = std::make_unique<char[]>(500);
+        c.reset();
+        stats = section.stats();
+    }
+    REQUIRE(stats.allocations == 3);
+    REQUIRE(stats.deallocations == 2);
+    REQUIRE(stats.allocated_bytes == 3'500);
+    REQUIRE(stats.peak_bytes == 2'500);
+    REQUIRE(stats.largest_allocation == 2'000);
+}
+
+TEST_CASE("AllocationSection - 入れ子にすると外側は内側の確保も数える") {
+    AllocationStats outer_stats;
+    AllocationStats inner_stats;
+    {
+        AllocationSection outer;
+        auto a = std::make_unique<int>(1);
+        {
+            AllocationSection inner;
+            auto b = std::make_unique<int>(2);
+            a.reset();
+            inner_stats = inner.stats();
+        }
+        outer_stats = outer.stats();
+    }
+    REQUIRE(outer_stats.allocations == 2);
+    REQUIRE(outer_stats.deallocations == 2);
+    REQUIRE(inner_stats.allocations == 1);
+    REQUIRE(inner_stats.deallocations == 1);
+    REQUIRE(inner_stats.peak_bytes == sizeof(int));
+}
+
+TEST_CASE("AllocationSection - 別のスレッドの確保とアラインメント付きの確保も数える") {
+    struct alignas(64) Block {
+        char bytes[128];
+    };
+    AllocationStats stats;
+    uintptr_t address = 0;
+    {
+        AllocationSection section;
+        std::jthread([&] {
+            auto block = std::make_unique<Block>();
+            address = reinterpret_cast<uintptr_t>(block.get());
+        }).join();
+        stats = section.stats();
+    }
+    REQUIRE(address % 64 == 0);
+    REQUIRE(stats.size_histogram[7] >= 1);  // 65 〜 128 バイト
+    REQUIRE(stats.allocations >= 1);
+}
+
+TEST_CASE("AllocationSection - nothrow 版の operator new も数える") {
+    AllocationStats stats;
+    {
+        AllocationSection section;
+        std::unique_ptr<int[]> p(new (std::nothrow) int[10]);
+        stats = section.stats();
+    }
+    REQUIRE(stats.allocations == 1);
+    REQUIRE(stats.allocated_bytes == 40);
+}
+
+TEST_CASE("AllocationSection - 同時に作れる数を超えると例外を投げる") {
+    std::array<std::optional<AllocationSection>, AllocationSection::MAX_SECTIONS> sections;
+    for (auto& section : sections) {
+        section.emplace();
+    }
+    REQUIRE_THROWS_AS(AllocationSection(), std::runtime_error);
+    sections.back().reset();
+    REQUIRE_NOTHROW(AllocationSection());
+}
@@ -0,0 +1,118 @@
+﻿#include "workload/workload.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "concurrency/work_stealing_pool.hpp"
+
+using namespace AlgorithmSamples::Workload;
+using AlgorithmSamples::Concurrency::WorkStealingPool;
+
+namespace {
+// 並列に埋めるときのチャンクで割り切れない要素数
+constexpr size_t SIZE = 200'003;
+}  // namespace
+
+TEST_CASE("generate - 同じシードなら同じ入力") {
+    for (auto distribution : ALL_DISTRIBUTIONS) {
+        const Options options{.distribution = distribution, .seed = 7};
+        REQUIRE(generate<int>(1'000, options) == generate<int>(1'000, options));
+    }
+    REQUIRE(generate<int>(1'000, {.seed = 1}) != generate<int>(1'000, {.seed = 2}));
+}
+
+TEST_CASE("generate - 並列に埋めても同じ入力") {
+    WorkStealingPool pool(3);
+    for (auto distribution : ALL_DISTRIBUTIONS) {
+        const Options options{.distribution = distribution};
+        REQUIRE(generate<int>(SIZE, options, pool) == generate<int>(SIZE, options));
+    }
+    const Options options{.distribution = Distribution::Zipf};
+    REQUIRE(generate<std::string>(SIZE, options, pool) == generate<std::string>(SIZE, options));
+}
+
+TEST_CASE("generate - 決まった形の分布") {
+    REQUIRE(generate<int>(5, {.distribution = Distribution::Sorted}) == std::vector{0, 1, 2, 3, 4});
+    REQUIRE(generate<int>(5, {.distribution = Distribution::Reversed}) == std::vector{4, 3, 2, 1, 0});
+    REQUIRE(generate<int>(6, {.distribution = Distribution::OrganPipe}) == std::vector{0, 1, 2, 2, 1, 0});
+    REQUIRE(generate<int>(7, {.distribution = Distribution::Sawtooth, .sawtooth_period = 3}) ==
+            std::vector{0, 1, 2, 0, 1, 2, 0});
+    REQUIRE(generate<int>(4, {.distribution = Distribution::AllEqual}) == std::vector{0, 0, 0, 0});
+    REQUIRE(generate<int>(0, {.distribution = Distribution::Shuffled}).empty());
+}
+
+TEST_CASE("generate - Shuffled は 0 から n - 1 の並べ替え") {
+    for (size_t size : {1, 2, 3, 1'000, 4'097}) {
+        auto v = generate<int>(size, {.distribution = Distribution::Shuffled});
+        std::vector<int> expected(size);
+        std::iota(expected.begin(), expected.end(), 0);
+        REQUIRE((v != expected || size < 1'000));
+        std::ranges::sort(v);
+        REQUIRE(v == expected);
+    }
+}
+
+TEST_CASE("generate - NearlySorted はソート後の位置から displacement 以内") {
+    for (size_t displacement : {0, 1, 16}) {
+        const auto v = generate<int>(10'000, {.distribution = Distribution::NearlySorted, .displacement = displacement});
+        std::vector<size_t> order(v.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, {}, [&](size_t i) { return v[i]; });
+        for (size_t position = 0; position < order.size(); ++position) {
+            const auto distance = order[position] > position ? order[position] - position : position - order[position];
+            REQUIRE(distance <= displacement);
+        }
+    }
+}
+
+TEST_CASE("generate - FewUnique と Zipf の値の頻度") {
+    const auto few = generate<int>(SIZE, {.distribution = Distribution::FewUnique, .unique_values = 10});
+    std::vector<size_t> counts(10);
+    for (auto value : few) {
+        REQUIRE((0 <= value && value < 10));
+        ++counts[static_cast<size_t>(value)];
+    }
+    for (auto count : counts) {
+        REQUIRE(count > SIZE / 10 * 9 / 10);
+    }
+
+    // 値 k (0 始まり) の頻度は 1 / (k + 1) に比例する。100 種類なら値 0 は 1 / H(100) ≈ 19.3%
+    const auto zipf = generate<int>(SIZE, {.distribution = Distribution::Zipf, .zipf_values = 100});
+    std::vector<size_t> frequency(100);
+    for (auto value : zipf) {
+        REQUIRE((0 <= value && value < 100));
+        ++frequency[static_cast<size_t>(value)];
+    }
+    const auto share = [&](size_t value) { return static_cast<double>(frequency[value]) / SIZE; };
+    REQUIRE((0.18 < share(0) && share(0) < 0.21));
+    REQUIRE((0.09 < share(1) && share(1) < 0.105));
+    REQUIRE(share(9) < share(1));
+}
+
+TEST_CASE("generate - キーの型") {
+    const auto floats = generate<double>(1'000);
+    REQUIRE(std::ranges::all_of(floats, [](double x) { return 0.0 <= x && x < 1.0; }));
+
+    const auto strings = generate<std::string>(1'000, {.distribution = Distribution::Sorted});
+    REQUIRE(std::ranges::is_sorted(strings));
+    REQUIRE(strings[12] == "0000000000000012");
+    REQUIRE(generate<std::string>(1, {.distribution = Distribution::Random})[0].size() == 13);
+
+    const auto records = generate<Record>(1'000, {.distribution = Distribution::Reversed});
+    REQUIRE(std::ranges::is_sorted(records, std::greater<>()));
+    for (size_t i = 0; i < records.size(); ++i) {
+        REQUIRE(records[i].id == i);
+    }
+
+    const auto bytes = generate<uint8_t>(1'000);
+    REQUIRE(std::ranges::any_of(bytes, [](uint8_t x) { return x > 200; }));
+}
+
+TEST_CASE("parse_distribution / to_string") {
+    for (auto distribution : ALL_DISTRIBUTIONS) {
+        REQUIRE(parse_distribution(to_string(distribution)) == distribution);
+    }
+    REQUIRE_FALSE(parse_distribution("unknown").has_value());
+}
@@ -0,0 +1,368 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "concurrency/work_stealing_pool.hpp"
+
+namespace AlgorithmSamples::Workload {
+
+// デモ・テスト・ベンチマークで共有する、シードで再現できる入力の生成。
+// 各要素は (シード, 位置) だけから計算するので、並列に埋めても分割の仕方によらず同じ列になる
+
+inline constexpr uint64_t DEFAULT_SEED = 42;
+
+enum class Distribution {
+    Random,        // 型の全範囲の一様乱数 (浮動小数点数は [0, 1))
+    Sorted,        // 昇順 (0, 1, 2, ...)
+    Reversed,      // 降順
+    FewUnique,     // unique_values 種類の値の一様乱数
+    OrganPipe,     // 山型 (0, 1, ..., n/2, ..., 1, 0)
+    Zipf,          // 1, 2, ..., zipf_values の値が 1 / k^zipf_exponent に比例する頻度で現れる
+    Sawtooth,      // 長さ sawtooth_period の昇順の繰り返し
+    NearlySorted,  // どの要素もソート後の位置から displacement 以内にある
+    AllEqual,      // すべて同じ値
+    Shuffled,      // 0, 1, ..., n - 1 の一様な並べ替え
+};
+
+inline constexpr Distribution ALL_DISTRIBUTIONS[] = {
+    Distribution::Random,   Distribution::Sorted,       Distribution::Reversed, Distribution::FewUnique,
+    Distribution::OrganPipe, Distribution::Zipf,        Distribution::Sawtooth, Distribution::NearlySorted,
+    Distribution::AllEqual, Distribution::Shuffled,
+};
+
+inline constexpr std::string_view DISTRIBUTION_NAMES[] = {
+    "random", "sorted", "reversed", "few-unique", "organ-pipe", "zipf", "sawtooth", "nearly-sorted", "all-equal",
+    "shuffled",
+};
+
+constexpr std::string_view to_string(Distribution distribution) {
+    return DISTRIBUTION_NAMES[static_cast<size_t>(distribution)];
+}
+
+constexpr std::optional<Distribution> parse_distribution(std::string_view name) {
+    for (auto distribution : ALL_DISTRIBUTIONS) {
+        if (to_string(distribution) == name) {
+            return distribution;
+        }
+    }
+    return std::nullopt;
+}
+
+struct Options {
+    Distribution distribution = Distribution::Random;
+    uint64_t seed = DEFAULT_SEED;
+    size_t unique_values = 16;      // FewUnique
+    double zipf_exponent = 1.0;     // Zipf (正の値)
+    uint64_t zipf_values = 0;       // Zipf の値の種類。0 なら要素数
+    size_t sawtooth_period = 1024;  // Sawtooth
+    size_t displacement = 16;       // NearlySorted
+};
+
+// 構造体のキーの例。key で比べ、id には生成した位置が入る (安定性の確認に使える)
+struct Record {
+    int64_t key = 0;
+    uint64_t id = 0;
+    std::array<std::byte, 48> payload{};
+
+    friend constexpr bool operator==(const Record& a, const Record& b) { return a.key == b.key; }
+    friend constexpr auto operator<=>(const Record& a, const Record& b) { return a.key <=> b.key; }
+};
+
+// 分布が決めた値から要素を作る。from_ordinal は順序を保ったまま順位 (0, 1, 2, ...) を要素に、
+// from_bits は 64 ビットの一様乱数を要素にする。他の型は特殊化を足せば使える
+template <typename T>
+struct KeyTraits;
+
+template <std::integral T>
+struct KeyTraits<T> {
+    static constexpr T from_ordinal(uint64_t ordinal, size_t /*index*/) { return static_cast<T>(ordinal); }
+    static constexpr T from_bits(uint64_t bits, size_t /*index*/) { return static_cast<T>(bits); }
+};
+
+template <std::floating_point T>
+struct KeyTraits<T> {
+    static constexpr T from_ordinal(uint64_t ordinal, size_t /*index*/) { return static_cast<T>(ordinal); }
+    static constexpr T from_bits(uint64_t bits, size_t /*index*/) {
+        return static_cast<T>(static_cast<double>(bits >> 11) * 0x1p-53);
+    }
+};
+
+template <>
+struct KeyTraits<std::string> {
+    // 16 桁の 0 埋めの 10 進数 (辞書順が数の順と一致する)
+    static std::string from_ordinal(uint64_t ordinal, size_t /*index*/) {
+        std::string key(ORDINAL_DIGITS, '0');
+        for (auto it = key.rbegin(); it != key.rend() && ordinal != 0; ++it, ordinal /= 10) {
+            *it = static_cast<char>('0' + ordinal % 10);
+        }
+        return key;
+    }
+    // 英小文字 13 文字
+    static std::string from_bits(uint64_t bits, size_t /*index*/) {
+        std::string key(RANDOM_LETTERS, 'a');
+        for (auto& c : key) {
+            c = static_cast<char>('a' + bits % 26);
+            bits /= 26;
+        }
+        return key;
+    }
+
+    static constexpr size_t ORDINAL_DIGITS = 16;
+    static constexpr size_t RANDOM_LETTERS = 13;
+};
+
+template <>
+struct KeyTraits<Record> {
+    static constexpr Record from_ordinal(uint64_t ordinal, size_t index) {
+        return {static_cast<int64_t>(ordinal), index, {}};
+    }
+    static constexpr Record from_bits(uint64_t bits, size_t index) { return {static_cast<int64_t>(bits), index, {}}; }
+};
+
+template <typename T>
+concept Key = requires(uint64_t value, size_t index) {
+    { KeyTraits<T>::from_ordinal(value, index) } -> std::convertible_to<T>;
+    { KeyTraits<T>::from_bits(value, index) } -> std::convertible_to<T>;
+};
+
+namespace detail {
+
+// 並列に埋めるときの 1 タスクの要素数
+inline constexpr size_t CHUNK_SIZE = 1 << 16;
+
+// SplitMix64 の出力関数。連続した入力からも偏りのない 64 ビット値を作る
+constexpr uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// 64 ビットの一様乱数を [0, bound) に写す。bound が 32 ビットに収まれば除算の代わりに掛け算を使う (Lemire の方法)
+constexpr uint64_t bounded(uint64_t bits, uint64_t bound) {
+    if (bound <= (uint64_t{1} << 32)) {
+        return ((bits >> 32) * bound) >> 32;
+    }
+    return bits % bound;
+}
+
+// 位置ごとの乱数列。(シード, 位置) から決まる
+class IndexRandom {
+public:
+    constexpr IndexRandom(uint64_t seed, uint64_t index) : state_(mix(seed) ^ (index * GOLDEN_GAMMA)) {}
+
+    constexpr uint64_t next() { return mix(state_ += GOLDEN_GAMMA); }
+    // [0, 1)
+    constexpr double next_double() { return static_cast<double>(next() >> 11) * 0x1p-53; }
+
+private:
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ULL;
+    uint64_t state_;
+};
+
+// Zipf 分布の棄却逆変換法 (Hörmann, Derflinger 1996)。値の種類によらず 1 要素あたり O(1) で、表を持たない
+class ZipfSampler {
+public:
+    ZipfSampler(uint64_t values, double exponent)
+        : values_(static_cast<double>(std::max<uint64_t>(values, 1))), exponent_(exponent) {
+        h_integral_x1_ = h_integral(1.5) - 1.0;
+        h_integral_n_ = h_integral(values_ + 0.5);
+        s_ = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+    }
+
+    // 1 以上 values 以下の値を返す
+    uint64_t operator()(IndexRandom& random) const {
+        while (true) {
+            const auto u = h_integral_n_ + random.next_double() * (h_integral_x1_ - h_integral_n_);
+            const auto x = h_integral_inverse(u);
+            const auto k = std::clamp(std::floor(x + 0.5), 1.0, values_);
+            if (k - x <= s_ || u >= h_integral(k + 0.5) - h(k)) {
+                return static_cast<uint64_t>(k);
+            }
+        }
+    }
+
+private:
+    double h(double x) const { return std::exp(-exponent_ * std::log(x)); }
+
+    double h_integral(double x) const {
+        const auto log_x = std::log(x);
+        return helper2((1.0 - exponent_) * log_x) * log_x;
+    }
+
+    double h_integral_inverse(double x) const {
+        const auto t = std::max(x * (1.0 - exponent_), -1.0);
+        return std::exp(helper1(t) * x);
+    }
+
+    // log(1 + x) / x と (exp(x) - 1) / x。x が 0 に近いときは級数で桁落ちを避ける
+    static double helper1(double x) {
+        return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+    static double helper2(double x) {
+        return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+    }
+
+    double values_;
+    double exponent_;
+    double h_integral_x1_ = 0;
+    double h_integral_n_ = 0;
+    double s_ = 0;
+};
+
+// [0, size) の上の全単射。size 以上の 2 の冪の範囲での Feistel 置換を、値が size 未満になるまで繰り返す
+// (cycle walking)。範囲は size の 2 倍未満なので、平均 2 回以内で終わる
+class IndexPermutation {
+public:
+    constexpr IndexPermutation(uint64_t size, uint64_t seed) : size_(size) {
+        // 上位 left_bits_ と下位 right_bits_ に分ける。ビット数が奇数なら左右の幅が異なる (非平衡 Feistel)
+        const auto bits = std::max(static_cast<int>(std::bit_width(size <= 1 ? 0 : size - 1)), 2);
+        right_bits_ = bits / 2;
+        left_bits_ = bits - right_bits_;
+        IndexRandom random(seed, size);
+        for (auto& key : keys_) {
+            key = random.next();
+        }
+    }
+
+    constexpr uint64_t operator()(uint64_t index) const {
+        do {
+            index = encrypt(index);
+        } while (index >= size_);
+        return index;
+    }
+
+private:
+    static constexpr int ROUNDS = 4;  // 偶数なので、最後に左右の幅が元に戻る
+
+    static constexpr uint64_t mask(int bits) { return (uint64_t{1} << bits) - 1; }
+
+    constexpr uint64_t encrypt(uint64_t value) const {
+        auto left_bits = left_bits_;
+        auto right_bits = right_bits_;
+        auto left = value >> right_bits;
+        auto right = value & mask(right_bits);
+        for (auto key : keys_) {
+            // ラウンド関数は掛け算 1 回の上位ビット。ベンチマークの入力には十分に混ざる
+            const auto next = left ^ ((((right ^ key) * 0x9e3779b97f4a7c15ULL) >> 32) & mask(left_bits));
+            left = right;
+            right = next;
+            std::swap(left_bits, right_bits);
+        }
+        return (left << right_bits) | right;
+    }
+
+    uint64_t size_;
+    int left_bits_ = 1;
+    int right_bits_ = 1;
+    std::array<uint64_t, ROUNDS> keys_{};
+};
+
+// 要素数 size の列のうち、位置 [first, first + out.size()) を埋める
+template <Key T>
+void fill_range(std::span<T> out, size_t first, size_t size, const Options& options) {
+    using Traits = KeyTraits<T>;
+    auto ordinal = [&](auto f) {
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = Traits::from_ordinal(f(first + i), first + i);
+        }
+    };
+    switch (options.distribution) {
+        case Distribution::Random:
+            for (size_t i = 0; i < out.size(); ++i) {
+                out[i] = Traits::from_bits(IndexRandom(options.seed, first + i).next(), first + i);
+            }
+            break;
+        case Distribution::Sorted:
+            ordinal([](size_t index) { return index; });
+            break;
+        case Distribution::Reversed:
+            ordinal([size](size_t index) { return size - 1 - index; });
+            break;
+        case Distribution::FewUnique: {
+            const auto unique_values = std::max<size_t>(options.unique_values, 1);
+            ordinal([&](size_t index) { return bounded(IndexRandom(options.seed, index).next(), unique_values); });
+            break;
+        }
+        case Distribution::OrganPipe:
+            ordinal([size](size_t index) { return std::min(index, size - 1 - index); });
+            break;
+        case Distribution::Zipf: {
+            const ZipfSampler sampler(options.zipf_values == 0 ? size : options.zipf_values, options.zipf_exponent);
+            ordinal([&](size_t index) {
+                IndexRandom random(options.seed, index);
+                return sampler(random) - 1;
+            });
+            break;
+        }
+        case Distribution::Sawtooth: {
+            const auto period = std::max<size_t>(options.sawtooth_period, 1);
+            ordinal([period](size_t index) { return index % period; });
+            break;
+        }
+        case Distribution::NearlySorted:
+            // 値 i + r (0 <= r <= k) は、位置 i - k より前のどの値よりも大きく (以上で)、i + k より後のどの値よりも
+            // 小さい (以下) ので、ソート後の位置は i から k 以内になる
+            ordinal([&](size_t index) {
+                return index + bounded(IndexRandom(options.seed, index).next(), options.displacement + 1);
+            });
+            break;
+        case Distribution::AllEqual:
+            ordinal([](size_t) { return 0; });
+            break;
+        case Distribution::Shuffled: {
+            const IndexPermutation permutation(size, options.seed);
+            ordinal([&](size_t index) { return permutation(index); });
+            break;
+        }
+    }
+}
+
+}  // namespace detail
+
+// out を options.distribution の入力で埋める
+template <Key T>
+void fill(std::span<T> out, const Options& options = {}) {
+    detail::fill_range(out, 0, out.size(), options);
+}
+
+// fill を pool のスレッドで並列に行う。結果は fill と同じ
+template <Key T>
+void fill(std::span<T> out, const Options& options, Concurrency::WorkStealingPool& pool) {
+    Concurrency::TaskGroup group;
+    // submit が途中で例外を投げても、options を参照しているタスクが終わるまで待ってから抜ける
+    pool.run_and_wait(group, [&] {
+        for (size_t first = 0; first < out.size(); first += detail::CHUNK_SIZE) {
+            pool.submit(group, [out, first, &options] {
+                detail::fill_range(out.subspan(first, std::min(detail::CHUNK_SIZE, out.size() - first)), first,
+                                   out.size(), options);
+            });
+        }
+    });
+}
+
+template <Key T>
+std::vector<T> generate(size_t size, const Options& options = {}) {
+    std::vector<T> out(size);
+    fill(std::span(out), options);
+    return out;
+}
+
+template <Key T>
+std::vector<T> generate(size_t size, const Options& options, Concurrency::WorkStealingPool& pool) {
+    std::vector<T> out(size);
+    fill(std::span(out), options, pool);
+    return out;
+}
+
+}  // namespace AlgorithmSamples::Workload